@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/async_bench.dir/bench/async_bench.cpp.o"
+  "CMakeFiles/async_bench.dir/bench/async_bench.cpp.o.d"
+  "async_bench"
+  "async_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/async_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
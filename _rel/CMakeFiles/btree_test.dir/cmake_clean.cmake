@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/btree_test.dir/tests/btree_test.cpp.o"
+  "CMakeFiles/btree_test.dir/tests/btree_test.cpp.o.d"
+  "btree_test"
+  "btree_test.pdb"
+  "btree_test[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/btree_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
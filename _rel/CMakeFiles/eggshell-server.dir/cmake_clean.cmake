@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/eggshell-server.dir/src/server.cpp.o"
+  "CMakeFiles/eggshell-server.dir/src/server.cpp.o.d"
+  "eggshell-server"
+  "eggshell-server.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/eggshell-server.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,70 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/compiler/arena.cpp" "CMakeFiles/eggshell.dir/src/compiler/arena.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/compiler/arena.cpp.o.d"
+  "/root/repo/src/compiler/compiler.cpp" "CMakeFiles/eggshell.dir/src/compiler/compiler.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/compiler/compiler.cpp.o.d"
+  "/root/repo/src/compiler/lexer.cpp" "CMakeFiles/eggshell.dir/src/compiler/lexer.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/compiler/lexer.cpp.o.d"
+  "/root/repo/src/compiler/metacmd/metacmd.cpp" "CMakeFiles/eggshell.dir/src/compiler/metacmd/metacmd.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/compiler/metacmd/metacmd.cpp.o.d"
+  "/root/repo/src/compiler/parser.cpp" "CMakeFiles/eggshell.dir/src/compiler/parser.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/compiler/parser.cpp.o.d"
+  "/root/repo/src/compiler/plancache.cpp" "CMakeFiles/eggshell.dir/src/compiler/plancache.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/compiler/plancache.cpp.o.d"
+  "/root/repo/src/compiler/script.cpp" "CMakeFiles/eggshell.dir/src/compiler/script.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/compiler/script.cpp.o.d"
+  "/root/repo/src/compiler/session.cpp" "CMakeFiles/eggshell.dir/src/compiler/session.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/compiler/session.cpp.o.d"
+  "/root/repo/src/compiler/statement.cpp" "CMakeFiles/eggshell.dir/src/compiler/statement.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/compiler/statement.cpp.o.d"
+  "/root/repo/src/compiler/stats.cpp" "CMakeFiles/eggshell.dir/src/compiler/stats.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/compiler/stats.cpp.o.d"
+  "/root/repo/src/executor/aggregate.cpp" "CMakeFiles/eggshell.dir/src/executor/aggregate.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/executor/aggregate.cpp.o.d"
+  "/root/repo/src/executor/batch.cpp" "CMakeFiles/eggshell.dir/src/executor/batch.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/executor/batch.cpp.o.d"
+  "/root/repo/src/executor/filter.cpp" "CMakeFiles/eggshell.dir/src/executor/filter.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/executor/filter.cpp.o.d"
+  "/root/repo/src/executor/hashjoin.cpp" "CMakeFiles/eggshell.dir/src/executor/hashjoin.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/executor/hashjoin.cpp.o.d"
+  "/root/repo/src/executor/limit.cpp" "CMakeFiles/eggshell.dir/src/executor/limit.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/executor/limit.cpp.o.d"
+  "/root/repo/src/executor/merge.cpp" "CMakeFiles/eggshell.dir/src/executor/merge.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/executor/merge.cpp.o.d"
+  "/root/repo/src/executor/mergejoin.cpp" "CMakeFiles/eggshell.dir/src/executor/mergejoin.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/executor/mergejoin.cpp.o.d"
+  "/root/repo/src/executor/parallelscan.cpp" "CMakeFiles/eggshell.dir/src/executor/parallelscan.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/executor/parallelscan.cpp.o.d"
+  "/root/repo/src/executor/project.cpp" "CMakeFiles/eggshell.dir/src/executor/project.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/executor/project.cpp.o.d"
+  "/root/repo/src/executor/resultsink.cpp" "CMakeFiles/eggshell.dir/src/executor/resultsink.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/executor/resultsink.cpp.o.d"
+  "/root/repo/src/executor/rowfilter.cpp" "CMakeFiles/eggshell.dir/src/executor/rowfilter.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/executor/rowfilter.cpp.o.d"
+  "/root/repo/src/executor/scan.cpp" "CMakeFiles/eggshell.dir/src/executor/scan.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/executor/scan.cpp.o.d"
+  "/root/repo/src/executor/scheduler.cpp" "CMakeFiles/eggshell.dir/src/executor/scheduler.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/executor/scheduler.cpp.o.d"
+  "/root/repo/src/executor/sort.cpp" "CMakeFiles/eggshell.dir/src/executor/sort.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/executor/sort.cpp.o.d"
+  "/root/repo/src/executor/threadpool.cpp" "CMakeFiles/eggshell.dir/src/executor/threadpool.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/executor/threadpool.cpp.o.d"
+  "/root/repo/src/server/client.cpp" "CMakeFiles/eggshell.dir/src/server/client.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/server/client.cpp.o.d"
+  "/root/repo/src/server/protocol.cpp" "CMakeFiles/eggshell.dir/src/server/protocol.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/server/protocol.cpp.o.d"
+  "/root/repo/src/server/replica.cpp" "CMakeFiles/eggshell.dir/src/server/replica.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/server/replica.cpp.o.d"
+  "/root/repo/src/server/server.cpp" "CMakeFiles/eggshell.dir/src/server/server.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/server/server.cpp.o.d"
+  "/root/repo/src/storage/bplus/indexnode.cpp" "CMakeFiles/eggshell.dir/src/storage/bplus/indexnode.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/storage/bplus/indexnode.cpp.o.d"
+  "/root/repo/src/storage/bplus/internalnode.cpp" "CMakeFiles/eggshell.dir/src/storage/bplus/internalnode.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/storage/bplus/internalnode.cpp.o.d"
+  "/root/repo/src/storage/bplus/leafnode.cpp" "CMakeFiles/eggshell.dir/src/storage/bplus/leafnode.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/storage/bplus/leafnode.cpp.o.d"
+  "/root/repo/src/storage/bplus/node.cpp" "CMakeFiles/eggshell.dir/src/storage/bplus/node.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/storage/bplus/node.cpp.o.d"
+  "/root/repo/src/storage/catalog.cpp" "CMakeFiles/eggshell.dir/src/storage/catalog.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/storage/catalog.cpp.o.d"
+  "/root/repo/src/storage/compress.cpp" "CMakeFiles/eggshell.dir/src/storage/compress.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/storage/compress.cpp.o.d"
+  "/root/repo/src/storage/cursor.cpp" "CMakeFiles/eggshell.dir/src/storage/cursor.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/storage/cursor.cpp.o.d"
+  "/root/repo/src/storage/frameslab.cpp" "CMakeFiles/eggshell.dir/src/storage/frameslab.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/storage/frameslab.cpp.o.d"
+  "/root/repo/src/storage/hash/bucket.cpp" "CMakeFiles/eggshell.dir/src/storage/hash/bucket.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/storage/hash/bucket.cpp.o.d"
+  "/root/repo/src/storage/hash/hashindex.cpp" "CMakeFiles/eggshell.dir/src/storage/hash/hashindex.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/storage/hash/hashindex.cpp.o.d"
+  "/root/repo/src/storage/index.cpp" "CMakeFiles/eggshell.dir/src/storage/index.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/storage/index.cpp.o.d"
+  "/root/repo/src/storage/ioring.cpp" "CMakeFiles/eggshell.dir/src/storage/ioring.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/storage/ioring.cpp.o.d"
+  "/root/repo/src/storage/lsm/lsmtree.cpp" "CMakeFiles/eggshell.dir/src/storage/lsm/lsmtree.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/storage/lsm/lsmtree.cpp.o.d"
+  "/root/repo/src/storage/lsm/memtable.cpp" "CMakeFiles/eggshell.dir/src/storage/lsm/memtable.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/storage/lsm/memtable.cpp.o.d"
+  "/root/repo/src/storage/lsm/sstable.cpp" "CMakeFiles/eggshell.dir/src/storage/lsm/sstable.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/storage/lsm/sstable.cpp.o.d"
+  "/root/repo/src/storage/pagemap.cpp" "CMakeFiles/eggshell.dir/src/storage/pagemap.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/storage/pagemap.cpp.o.d"
+  "/root/repo/src/storage/pager.cpp" "CMakeFiles/eggshell.dir/src/storage/pager.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/storage/pager.cpp.o.d"
+  "/root/repo/src/storage/partition.cpp" "CMakeFiles/eggshell.dir/src/storage/partition.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/storage/partition.cpp.o.d"
+  "/root/repo/src/storage/row.cpp" "CMakeFiles/eggshell.dir/src/storage/row.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/storage/row.cpp.o.d"
+  "/root/repo/src/storage/table.cpp" "CMakeFiles/eggshell.dir/src/storage/table.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/storage/table.cpp.o.d"
+  "/root/repo/src/storage/transaction.cpp" "CMakeFiles/eggshell.dir/src/storage/transaction.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/storage/transaction.cpp.o.d"
+  "/root/repo/src/storage/wal.cpp" "CMakeFiles/eggshell.dir/src/storage/wal.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/storage/wal.cpp.o.d"
+  "/root/repo/src/storage/warmset.cpp" "CMakeFiles/eggshell.dir/src/storage/warmset.cpp.o" "gcc" "CMakeFiles/eggshell.dir/src/storage/warmset.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
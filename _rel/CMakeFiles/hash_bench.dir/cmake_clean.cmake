@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/hash_bench.dir/bench/hash_bench.cpp.o"
+  "CMakeFiles/hash_bench.dir/bench/hash_bench.cpp.o.d"
+  "hash_bench"
+  "hash_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/hash_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
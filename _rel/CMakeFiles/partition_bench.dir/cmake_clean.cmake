@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/partition_bench.dir/bench/partition_bench.cpp.o"
+  "CMakeFiles/partition_bench.dir/bench/partition_bench.cpp.o.d"
+  "partition_bench"
+  "partition_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/partition_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,22 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_rel
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+include("/root/repo/_rel/btree_test[1]_include.cmake")
+include("/root/repo/_rel/statement_test[1]_include.cmake")
+include("/root/repo/_rel/lsm_test[1]_include.cmake")
+include("/root/repo/_rel/parser_test[1]_include.cmake")
+include("/root/repo/_rel/session_test[1]_include.cmake")
+include("/root/repo/_rel/executor_test[1]_include.cmake")
+include("/root/repo/_rel/join_test[1]_include.cmake")
+include("/root/repo/_rel/resultsink_test[1]_include.cmake")
+include("/root/repo/_rel/script_test[1]_include.cmake")
+include("/root/repo/_rel/server_test[1]_include.cmake")
+include("/root/repo/_rel/async_test[1]_include.cmake")
+include("/root/repo/_rel/partition_test[1]_include.cmake")
+include("/root/repo/_rel/replication_test[1]_include.cmake")
+include("/root/repo/_rel/compression_test[1]_include.cmake")
+include("/root/repo/_rel/pager_test[1]_include.cmake")
+subdirs("_deps/googletest-build")
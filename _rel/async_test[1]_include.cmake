@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_rel/async_test[1]_tests.cmake")
+  include("/root/repo/_rel/async_test[1]_tests.cmake")
+else()
+  add_test(async_test_NOT_BUILT async_test_NOT_BUILT)
+endif()
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_rel/pager_test[1]_tests.cmake")
+  include("/root/repo/_rel/pager_test[1]_tests.cmake")
+else()
+  add_test(pager_test_NOT_BUILT pager_test_NOT_BUILT)
+endif()
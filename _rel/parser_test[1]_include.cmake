@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_rel/parser_test[1]_tests.cmake")
+  include("/root/repo/_rel/parser_test[1]_tests.cmake")
+else()
+  add_test(parser_test_NOT_BUILT parser_test_NOT_BUILT)
+endif()
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_rel/script_test[1]_tests.cmake")
+  include("/root/repo/_rel/script_test[1]_tests.cmake")
+else()
+  add_test(script_test_NOT_BUILT script_test_NOT_BUILT)
+endif()
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_rel/statement_test[1]_tests.cmake")
+  include("/root/repo/_rel/statement_test[1]_tests.cmake")
+else()
+  add_test(statement_test_NOT_BUILT statement_test_NOT_BUILT)
+endif()
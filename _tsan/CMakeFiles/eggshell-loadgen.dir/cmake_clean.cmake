@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/eggshell-loadgen.dir/bench/loadgen.cpp.o"
+  "CMakeFiles/eggshell-loadgen.dir/bench/loadgen.cpp.o.d"
+  "eggshell-loadgen"
+  "eggshell-loadgen.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/eggshell-loadgen.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
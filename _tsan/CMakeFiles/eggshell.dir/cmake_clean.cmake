@@ -0,0 +1,113 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/eggshell.dir/src/compiler/arena.cpp.o"
+  "CMakeFiles/eggshell.dir/src/compiler/arena.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/compiler/compiler.cpp.o"
+  "CMakeFiles/eggshell.dir/src/compiler/compiler.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/compiler/lexer.cpp.o"
+  "CMakeFiles/eggshell.dir/src/compiler/lexer.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/compiler/metacmd/metacmd.cpp.o"
+  "CMakeFiles/eggshell.dir/src/compiler/metacmd/metacmd.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/compiler/parser.cpp.o"
+  "CMakeFiles/eggshell.dir/src/compiler/parser.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/compiler/plancache.cpp.o"
+  "CMakeFiles/eggshell.dir/src/compiler/plancache.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/compiler/script.cpp.o"
+  "CMakeFiles/eggshell.dir/src/compiler/script.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/compiler/session.cpp.o"
+  "CMakeFiles/eggshell.dir/src/compiler/session.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/compiler/statement.cpp.o"
+  "CMakeFiles/eggshell.dir/src/compiler/statement.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/compiler/stats.cpp.o"
+  "CMakeFiles/eggshell.dir/src/compiler/stats.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/executor/aggregate.cpp.o"
+  "CMakeFiles/eggshell.dir/src/executor/aggregate.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/executor/batch.cpp.o"
+  "CMakeFiles/eggshell.dir/src/executor/batch.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/executor/filter.cpp.o"
+  "CMakeFiles/eggshell.dir/src/executor/filter.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/executor/hashjoin.cpp.o"
+  "CMakeFiles/eggshell.dir/src/executor/hashjoin.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/executor/limit.cpp.o"
+  "CMakeFiles/eggshell.dir/src/executor/limit.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/executor/merge.cpp.o"
+  "CMakeFiles/eggshell.dir/src/executor/merge.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/executor/mergejoin.cpp.o"
+  "CMakeFiles/eggshell.dir/src/executor/mergejoin.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/executor/parallelscan.cpp.o"
+  "CMakeFiles/eggshell.dir/src/executor/parallelscan.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/executor/project.cpp.o"
+  "CMakeFiles/eggshell.dir/src/executor/project.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/executor/resultsink.cpp.o"
+  "CMakeFiles/eggshell.dir/src/executor/resultsink.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/executor/rowfilter.cpp.o"
+  "CMakeFiles/eggshell.dir/src/executor/rowfilter.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/executor/scan.cpp.o"
+  "CMakeFiles/eggshell.dir/src/executor/scan.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/executor/scheduler.cpp.o"
+  "CMakeFiles/eggshell.dir/src/executor/scheduler.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/executor/sort.cpp.o"
+  "CMakeFiles/eggshell.dir/src/executor/sort.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/executor/threadpool.cpp.o"
+  "CMakeFiles/eggshell.dir/src/executor/threadpool.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/server/client.cpp.o"
+  "CMakeFiles/eggshell.dir/src/server/client.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/server/protocol.cpp.o"
+  "CMakeFiles/eggshell.dir/src/server/protocol.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/server/replica.cpp.o"
+  "CMakeFiles/eggshell.dir/src/server/replica.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/server/server.cpp.o"
+  "CMakeFiles/eggshell.dir/src/server/server.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/storage/bplus/indexnode.cpp.o"
+  "CMakeFiles/eggshell.dir/src/storage/bplus/indexnode.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/storage/bplus/internalnode.cpp.o"
+  "CMakeFiles/eggshell.dir/src/storage/bplus/internalnode.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/storage/bplus/leafnode.cpp.o"
+  "CMakeFiles/eggshell.dir/src/storage/bplus/leafnode.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/storage/bplus/node.cpp.o"
+  "CMakeFiles/eggshell.dir/src/storage/bplus/node.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/storage/catalog.cpp.o"
+  "CMakeFiles/eggshell.dir/src/storage/catalog.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/storage/compress.cpp.o"
+  "CMakeFiles/eggshell.dir/src/storage/compress.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/storage/cursor.cpp.o"
+  "CMakeFiles/eggshell.dir/src/storage/cursor.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/storage/frameslab.cpp.o"
+  "CMakeFiles/eggshell.dir/src/storage/frameslab.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/storage/hash/bucket.cpp.o"
+  "CMakeFiles/eggshell.dir/src/storage/hash/bucket.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/storage/hash/hashindex.cpp.o"
+  "CMakeFiles/eggshell.dir/src/storage/hash/hashindex.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/storage/index.cpp.o"
+  "CMakeFiles/eggshell.dir/src/storage/index.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/storage/ioring.cpp.o"
+  "CMakeFiles/eggshell.dir/src/storage/ioring.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/storage/lsm/lsmtree.cpp.o"
+  "CMakeFiles/eggshell.dir/src/storage/lsm/lsmtree.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/storage/lsm/memtable.cpp.o"
+  "CMakeFiles/eggshell.dir/src/storage/lsm/memtable.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/storage/lsm/sstable.cpp.o"
+  "CMakeFiles/eggshell.dir/src/storage/lsm/sstable.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/storage/pagemap.cpp.o"
+  "CMakeFiles/eggshell.dir/src/storage/pagemap.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/storage/pager.cpp.o"
+  "CMakeFiles/eggshell.dir/src/storage/pager.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/storage/partition.cpp.o"
+  "CMakeFiles/eggshell.dir/src/storage/partition.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/storage/row.cpp.o"
+  "CMakeFiles/eggshell.dir/src/storage/row.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/storage/table.cpp.o"
+  "CMakeFiles/eggshell.dir/src/storage/table.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/storage/transaction.cpp.o"
+  "CMakeFiles/eggshell.dir/src/storage/transaction.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/storage/wal.cpp.o"
+  "CMakeFiles/eggshell.dir/src/storage/wal.cpp.o.d"
+  "CMakeFiles/eggshell.dir/src/storage/warmset.cpp.o"
+  "CMakeFiles/eggshell.dir/src/storage/warmset.cpp.o.d"
+  "libeggshell.pdb"
+  "libeggshell.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/eggshell.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/pager_test.dir/tests/pager_test.cpp.o"
+  "CMakeFiles/pager_test.dir/tests/pager_test.cpp.o.d"
+  "pager_test"
+  "pager_test.pdb"
+  "pager_test[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/pager_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
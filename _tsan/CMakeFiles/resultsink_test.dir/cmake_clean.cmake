@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/resultsink_test.dir/tests/resultsink_test.cpp.o"
+  "CMakeFiles/resultsink_test.dir/tests/resultsink_test.cpp.o.d"
+  "resultsink_test"
+  "resultsink_test.pdb"
+  "resultsink_test[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/resultsink_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,22 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_tsan
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+include("/root/repo/_tsan/btree_test[1]_include.cmake")
+include("/root/repo/_tsan/statement_test[1]_include.cmake")
+include("/root/repo/_tsan/lsm_test[1]_include.cmake")
+include("/root/repo/_tsan/parser_test[1]_include.cmake")
+include("/root/repo/_tsan/session_test[1]_include.cmake")
+include("/root/repo/_tsan/executor_test[1]_include.cmake")
+include("/root/repo/_tsan/join_test[1]_include.cmake")
+include("/root/repo/_tsan/resultsink_test[1]_include.cmake")
+include("/root/repo/_tsan/script_test[1]_include.cmake")
+include("/root/repo/_tsan/server_test[1]_include.cmake")
+include("/root/repo/_tsan/async_test[1]_include.cmake")
+include("/root/repo/_tsan/partition_test[1]_include.cmake")
+include("/root/repo/_tsan/replication_test[1]_include.cmake")
+include("/root/repo/_tsan/compression_test[1]_include.cmake")
+include("/root/repo/_tsan/pager_test[1]_include.cmake")
+subdirs("_deps/googletest-build")
@@ -0,0 +1,5 @@
+add_test([=[AsyncTest.LookupsThroughIoRing]=]  /root/repo/_tsan/async_test [==[--gtest_filter=AsyncTest.LookupsThroughIoRing]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[AsyncTest.LookupsThroughIoRing]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[AsyncTest.LookupsThroughReaderThreads]=]  /root/repo/_tsan/async_test [==[--gtest_filter=AsyncTest.LookupsThroughReaderThreads]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[AsyncTest.LookupsThroughReaderThreads]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  async_test_TESTS AsyncTest.LookupsThroughIoRing AsyncTest.LookupsThroughReaderThreads)
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_tsan/btree_test[1]_tests.cmake")
+  include("/root/repo/_tsan/btree_test[1]_tests.cmake")
+else()
+  add_test(btree_test_NOT_BUILT btree_test_NOT_BUILT)
+endif()
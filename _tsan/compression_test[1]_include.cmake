@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_tsan/compression_test[1]_tests.cmake")
+  include("/root/repo/_tsan/compression_test[1]_tests.cmake")
+else()
+  add_test(compression_test_NOT_BUILT compression_test_NOT_BUILT)
+endif()
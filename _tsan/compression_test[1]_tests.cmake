@@ -0,0 +1,13 @@
+add_test([=[CompressionTest.RoundTrip]=]  /root/repo/_tsan/compression_test [==[--gtest_filter=CompressionTest.RoundTrip]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CompressionTest.RoundTrip]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CompressionTest.CompressedTableIsSmaller]=]  /root/repo/_tsan/compression_test [==[--gtest_filter=CompressionTest.CompressedTableIsSmaller]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CompressionTest.CompressedTableIsSmaller]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CompressionTest.PagesGrowAcrossReopens]=]  /root/repo/_tsan/compression_test [==[--gtest_filter=CompressionTest.PagesGrowAcrossReopens]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CompressionTest.PagesGrowAcrossReopens]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CompressionTest.VacuumKeepsPagesCompressed]=]  /root/repo/_tsan/compression_test [==[--gtest_filter=CompressionTest.VacuumKeepsPagesCompressed]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CompressionTest.VacuumKeepsPagesCompressed]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CompressionTest.CoroutineLookups]=]  /root/repo/_tsan/compression_test [==[--gtest_filter=CompressionTest.CoroutineLookups]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CompressionTest.CoroutineLookups]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CompressionTest.CatalogTablesInheritCompression]=]  /root/repo/_tsan/compression_test [==[--gtest_filter=CompressionTest.CatalogTablesInheritCompression]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CompressionTest.CatalogTablesInheritCompression]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  compression_test_TESTS CompressionTest.RoundTrip CompressionTest.CompressedTableIsSmaller CompressionTest.PagesGrowAcrossReopens CompressionTest.VacuumKeepsPagesCompressed CompressionTest.CoroutineLookups CompressionTest.CatalogTablesInheritCompression)
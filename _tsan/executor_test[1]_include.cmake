@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_tsan/executor_test[1]_tests.cmake")
+  include("/root/repo/_tsan/executor_test[1]_tests.cmake")
+else()
+  add_test(executor_test_NOT_BUILT executor_test_NOT_BUILT)
+endif()
@@ -0,0 +1,21 @@
+add_test([=[ExecutorTest.ScanStopsAtKeyMax]=]  /root/repo/_tsan/executor_test [==[--gtest_filter=ExecutorTest.ScanStopsAtKeyMax]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ExecutorTest.ScanStopsAtKeyMax]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ExecutorTest.FilterLimitAndCount]=]  /root/repo/_tsan/executor_test [==[--gtest_filter=ExecutorTest.FilterLimitAndCount]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ExecutorTest.FilterLimitAndCount]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ExecutorTest.RowFilterMatchesLikeStrncmp]=]  /root/repo/_tsan/executor_test [==[--gtest_filter=ExecutorTest.RowFilterMatchesLikeStrncmp]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ExecutorTest.RowFilterMatchesLikeStrncmp]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ExecutorTest.PushedDownFilterMatchesFilterOperator]=]  /root/repo/_tsan/executor_test [==[--gtest_filter=ExecutorTest.PushedDownFilterMatchesFilterOperator]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ExecutorTest.PushedDownFilterMatchesFilterOperator]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ExecutorTest.ParallelScanMatchesScan]=]  /root/repo/_tsan/executor_test [==[--gtest_filter=ExecutorTest.ParallelScanMatchesScan]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ExecutorTest.ParallelScanMatchesScan]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ExecutorTest.OrderedParallelScanOfManyBatches]=]  /root/repo/_tsan/executor_test [==[--gtest_filter=ExecutorTest.OrderedParallelScanOfManyBatches]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ExecutorTest.OrderedParallelScanOfManyBatches]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ExecutorTest.OrderedParallelScanOnABusyPool]=]  /root/repo/_tsan/executor_test [==[--gtest_filter=ExecutorTest.OrderedParallelScanOnABusyPool]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ExecutorTest.OrderedParallelScanOnABusyPool]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ExecutorTest.HashAggregateGroups]=]  /root/repo/_tsan/executor_test [==[--gtest_filter=ExecutorTest.HashAggregateGroups]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ExecutorTest.HashAggregateGroups]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ExecutorTest.SortTopKAndSpilledRunsAgree]=]  /root/repo/_tsan/executor_test [==[--gtest_filter=ExecutorTest.SortTopKAndSpilledRunsAgree]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ExecutorTest.SortTopKAndSpilledRunsAgree]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ExecutorTest.LimitStopsTheScan]=]  /root/repo/_tsan/executor_test [==[--gtest_filter=ExecutorTest.LimitStopsTheScan]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ExecutorTest.LimitStopsTheScan]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  executor_test_TESTS ExecutorTest.ScanStopsAtKeyMax ExecutorTest.FilterLimitAndCount ExecutorTest.RowFilterMatchesLikeStrncmp ExecutorTest.PushedDownFilterMatchesFilterOperator ExecutorTest.ParallelScanMatchesScan ExecutorTest.OrderedParallelScanOfManyBatches ExecutorTest.OrderedParallelScanOnABusyPool ExecutorTest.HashAggregateGroups ExecutorTest.SortTopKAndSpilledRunsAgree ExecutorTest.LimitStopsTheScan)
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_tsan/join_test[1]_tests.cmake")
+  include("/root/repo/_tsan/join_test[1]_tests.cmake")
+else()
+  add_test(join_test_NOT_BUILT join_test_NOT_BUILT)
+endif()
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_tsan/lsm_test[1]_tests.cmake")
+  include("/root/repo/_tsan/lsm_test[1]_tests.cmake")
+else()
+  add_test(lsm_test_NOT_BUILT lsm_test_NOT_BUILT)
+endif()
@@ -0,0 +1,11 @@
+add_test([=[PagerTest.FramesAreAlignedAndReused]=]  /root/repo/_tsan/pager_test [==[--gtest_filter=PagerTest.FramesAreAlignedAndReused]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[PagerTest.FramesAreAlignedAndReused]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[PagerTest.DirectIo]=]  /root/repo/_tsan/pager_test [==[--gtest_filter=PagerTest.DirectIo]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[PagerTest.DirectIo]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[PagerTest.DirectIoSkipsCompressedFiles]=]  /root/repo/_tsan/pager_test [==[--gtest_filter=PagerTest.DirectIoSkipsCompressedFiles]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[PagerTest.DirectIoSkipsCompressedFiles]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[PagerTest.WarmRestartReadsCachedPagesBack]=]  /root/repo/_tsan/pager_test [==[--gtest_filter=PagerTest.WarmRestartReadsCachedPagesBack]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[PagerTest.WarmRestartReadsCachedPagesBack]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[PagerTest.WarmRestartIsOptIn]=]  /root/repo/_tsan/pager_test [==[--gtest_filter=PagerTest.WarmRestartIsOptIn]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[PagerTest.WarmRestartIsOptIn]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  pager_test_TESTS PagerTest.FramesAreAlignedAndReused PagerTest.DirectIo PagerTest.DirectIoSkipsCompressedFiles PagerTest.WarmRestartReadsCachedPagesBack PagerTest.WarmRestartIsOptIn)
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_tsan/partition_test[1]_tests.cmake")
+  include("/root/repo/_tsan/partition_test[1]_tests.cmake")
+else()
+  add_test(partition_test_NOT_BUILT partition_test_NOT_BUILT)
+endif()
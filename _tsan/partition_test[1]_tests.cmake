@@ -0,0 +1,11 @@
+add_test([=[PartitionTest.HashRoutingSpreadsKeys]=]  /root/repo/_tsan/partition_test [==[--gtest_filter=PartitionTest.HashRoutingSpreadsKeys]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[PartitionTest.HashRoutingSpreadsKeys]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[PartitionTest.RangeRoutingSkipsShards]=]  /root/repo/_tsan/partition_test [==[--gtest_filter=PartitionTest.RangeRoutingSkipsShards]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[PartitionTest.RangeRoutingSkipsShards]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[PartitionTest.HashPartitionsMatchOneTable]=]  /root/repo/_tsan/partition_test [==[--gtest_filter=PartitionTest.HashPartitionsMatchOneTable]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[PartitionTest.HashPartitionsMatchOneTable]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[PartitionTest.RangePartitionsMatchOneTable]=]  /root/repo/_tsan/partition_test [==[--gtest_filter=PartitionTest.RangePartitionsMatchOneTable]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[PartitionTest.RangePartitionsMatchOneTable]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[PartitionTest.ConcurrentInserts]=]  /root/repo/_tsan/partition_test [==[--gtest_filter=PartitionTest.ConcurrentInserts]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[PartitionTest.ConcurrentInserts]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  partition_test_TESTS PartitionTest.HashRoutingSpreadsKeys PartitionTest.RangeRoutingSkipsShards PartitionTest.HashPartitionsMatchOneTable PartitionTest.RangePartitionsMatchOneTable PartitionTest.ConcurrentInserts)
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_tsan/replication_test[1]_tests.cmake")
+  include("/root/repo/_tsan/replication_test[1]_tests.cmake")
+else()
+  add_test(replication_test_NOT_BUILT replication_test_NOT_BUILT)
+endif()
@@ -0,0 +1,9 @@
+add_test([=[ReplicationTest.ReplicaAppliesTheLog]=]  /root/repo/_tsan/replication_test [==[--gtest_filter=ReplicationTest.ReplicaAppliesTheLog]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ReplicationTest.ReplicaAppliesTheLog]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ReplicationTest.PrimaryReopensItsLog]=]  /root/repo/_tsan/replication_test [==[--gtest_filter=ReplicationTest.PrimaryReopensItsLog]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ReplicationTest.PrimaryReopensItsLog]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ReplicationTest.ReplicaFollowsAnotherProcess]=]  /root/repo/_tsan/replication_test [==[--gtest_filter=ReplicationTest.ReplicaFollowsAnotherProcess]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ReplicationTest.ReplicaFollowsAnotherProcess]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ReplicationTest.ServersReportReplication]=]  /root/repo/_tsan/replication_test [==[--gtest_filter=ReplicationTest.ServersReportReplication]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ReplicationTest.ServersReportReplication]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  replication_test_TESTS ReplicationTest.ReplicaAppliesTheLog ReplicationTest.PrimaryReopensItsLog ReplicationTest.ReplicaFollowsAnotherProcess ReplicationTest.ServersReportReplication)
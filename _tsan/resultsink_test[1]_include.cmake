@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_tsan/resultsink_test[1]_tests.cmake")
+  include("/root/repo/_tsan/resultsink_test[1]_tests.cmake")
+else()
+  add_test(resultsink_test_NOT_BUILT resultsink_test_NOT_BUILT)
+endif()
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_tsan/server_test[1]_tests.cmake")
+  include("/root/repo/_tsan/server_test[1]_tests.cmake")
+else()
+  add_test(server_test_NOT_BUILT server_test_NOT_BUILT)
+endif()
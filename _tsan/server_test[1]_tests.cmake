@@ -0,0 +1,5 @@
+add_test([=[ServerTest.PipelinedResponsesKeepRequestOrder]=]  /root/repo/_tsan/server_test [==[--gtest_filter=ServerTest.PipelinedResponsesKeepRequestOrder]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ServerTest.PipelinedResponsesKeepRequestOrder]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ServerTest.ClientsShareTables]=]  /root/repo/_tsan/server_test [==[--gtest_filter=ServerTest.ClientsShareTables]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ServerTest.ClientsShareTables]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  server_test_TESTS ServerTest.PipelinedResponsesKeepRequestOrder ServerTest.ClientsShareTables)
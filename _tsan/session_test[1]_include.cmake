@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_tsan/session_test[1]_tests.cmake")
+  include("/root/repo/_tsan/session_test[1]_tests.cmake")
+else()
+  add_test(session_test_NOT_BUILT session_test_NOT_BUILT)
+endif()
@@ -0,0 +1,11 @@
+add_test([=[SessionTest.PreparedHandleIsBoundAndRunRepeatedly]=]  /root/repo/_tsan/session_test [==[--gtest_filter=SessionTest.PreparedHandleIsBoundAndRunRepeatedly]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[SessionTest.PreparedHandleIsBoundAndRunRepeatedly]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[SessionTest.PrepareExecuteAndDeallocate]=]  /root/repo/_tsan/session_test [==[--gtest_filter=SessionTest.PrepareExecuteAndDeallocate]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[SessionTest.PrepareExecuteAndDeallocate]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[SessionTest.PlanCacheIgnoresSpacingAndEvictsOldest]=]  /root/repo/_tsan/session_test [==[--gtest_filter=SessionTest.PlanCacheIgnoresSpacingAndEvictsOldest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[SessionTest.PlanCacheIgnoresSpacingAndEvictsOldest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[SessionTest.ArenaKeepsBlocksAcrossResets]=]  /root/repo/_tsan/session_test [==[--gtest_filter=SessionTest.ArenaKeepsBlocksAcrossResets]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[SessionTest.ArenaKeepsBlocksAcrossResets]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[SessionTest.RepeatedStatementsDoNotAllocate]=]  /root/repo/_tsan/session_test [==[--gtest_filter=SessionTest.RepeatedStatementsDoNotAllocate]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[SessionTest.RepeatedStatementsDoNotAllocate]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  session_test_TESTS SessionTest.PreparedHandleIsBoundAndRunRepeatedly SessionTest.PrepareExecuteAndDeallocate SessionTest.PlanCacheIgnoresSpacingAndEvictsOldest SessionTest.ArenaKeepsBlocksAcrossResets SessionTest.RepeatedStatementsDoNotAllocate)
@@ -0,0 +1,113 @@
+/*
+ * Random point lookups on a cold table: threads blocking in Pager::get on
+ * every miss, against the same threads running coroutine lookups that
+ * suspend on misses with many queries in flight. The file is dropped from
+ * the OS page cache before each run so that misses go to the device.
+ */
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <eggshell/executor/scheduler.hpp>
+#include <eggshell/storage/table.hpp>
+#include <fstream>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const uint32_t ROWS = 200000;
+const uint32_t LOOKUPS = 50000;
+const uint32_t THREADS = 2;
+const uint32_t IN_FLIGHT = 256;
+
+void drop_cache(const std::string& filename) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+}
+
+std::vector<uint32_t> random_keys() {
+    std::mt19937 random{42};
+    std::uniform_int_distribution<uint32_t> key{1, ROWS};
+    std::vector<uint32_t> keys(LOOKUPS);
+    for (uint32_t& k : keys) {
+        k = key(random);
+    }
+    return keys;
+}
+
+double blocking(const std::string& filename,
+                const std::vector<uint32_t>& keys) {
+    drop_cache(filename);
+    Table table{filename};
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < THREADS; t++) {
+        threads.emplace_back([&, t] {
+            Row row;
+            for (uint32_t i = t; i < keys.size(); i += THREADS) {
+                std::shared_lock lock(table.mutex);
+                row.deserialize(table.find(keys[i]).value());
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+double coroutines(const std::string& filename,
+                  const std::vector<uint32_t>& keys, bool use_io_uring) {
+    drop_cache(filename);
+    Table table{filename};
+    Scheduler scheduler{THREADS, use_io_uring};
+    std::vector<Row> rows(keys.size());
+    std::vector<Task<bool>> tasks;
+    for (uint32_t i = 0; i < keys.size(); i++) {
+        tasks.push_back(table.lookup(keys[i], rows[i], scheduler));
+    }
+    auto start = std::chrono::steady_clock::now();
+    scheduler.run(tasks, IN_FLIGHT);
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+}  // namespace
+
+int main() {
+    std::string filename = "async_bench.db";
+    std::remove(filename.c_str());
+    std::ofstream{filename};
+    {
+        Table table{filename};
+        Row row{};
+        for (uint32_t key = 1; key <= ROWS; key++) {
+            row.id = key;
+            snprintf(row.username, sizeof(row.username), "u%u", key % 7);
+            snprintf(row.email, sizeof(row.email), "e%u@x", key);
+            table.insert(table.find(key), row);
+        }
+    }
+
+    std::vector<uint32_t> keys = random_keys();
+    printf("%u lookups on %u threads, %u rows\n", LOOKUPS, THREADS, ROWS);
+    printf("%-24s %10.1f ms\n", "blocking", blocking(filename, keys));
+    printf("%-24s %10.1f ms\n", "coroutines, readers",
+           coroutines(filename, keys, false));
+    if (Scheduler{1}.io_uring()) {
+        printf("%-24s %10.1f ms\n", "coroutines, io_uring",
+               coroutines(filename, keys, true));
+    }
+    std::remove(filename.c_str());
+    return 0;
+}
@@ -0,0 +1,258 @@
+/*
+ * Google Benchmark suite for the storage engine and the statement path:
+ * inserts, point lookups, full and range scans, readers alongside a writer,
+ * and statements parsed and executed end to end, each at several table
+ * sizes. --benchmark_out=<file> --benchmark_out_format=json keeps the
+ * results for comparing runs.
+ */
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <eggshell/compiler/session.hpp>
+#include <eggshell/compiler/statement.hpp>
+#include <eggshell/executor/resultsink.hpp>
+#include <eggshell/storage/table.hpp>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+/* Rows in the tables of every benchmark */
+const int64_t TABLE_ROWS[] = {1 << 10, 1 << 13, 1 << 16};
+/* Rows read by a range scan */
+const uint32_t RANGE_ROWS = 100;
+
+Row make_row(uint32_t key) {
+    Row row{};
+    row.id = key;
+    snprintf(row.username, sizeof(row.username), "user%u", key);
+    snprintf(row.email, sizeof(row.email), "user%u@example.com", key);
+    return row;
+}
+
+void table_sizes(benchmark::internal::Benchmark* benchmark) {
+    for (int64_t rows : TABLE_ROWS) {
+        benchmark->Arg(rows);
+    }
+}
+
+/* A table in a file of its own, removed with it */
+struct TempTable {
+    std::string path;
+    std::unique_ptr<Table> table;
+
+    TempTable(std::string path) : path{path} {
+        std::remove(path.c_str());
+        std::ofstream{path};
+        table = std::make_unique<Table>(path);
+    }
+
+    ~TempTable() {
+        table.reset();
+        std::remove(path.c_str());
+    }
+};
+
+/*
+Table of keys 1..rows, filled on first use and shared by the benchmarks
+that only read it, or only rewrite columns other than the key
+*/
+Table& filled(uint32_t rows) {
+    static std::mutex mutex;
+    static std::map<uint32_t, std::unique_ptr<TempTable>> tables;
+    std::lock_guard lock(mutex);
+    std::unique_ptr<TempTable>& temp = tables[rows];
+    if (!temp) {
+        temp = std::make_unique<TempTable>("engine_bench_" +
+                                           std::to_string(rows) + ".db");
+        Table& table = *temp->table;
+        for (uint32_t key = 1; key <= rows; key++) {
+            Row row = make_row(key);
+            table.insert(table.find(key), row);
+        }
+    }
+    return *temp->table;
+}
+
+/* Inserts keys into a new table, timing only the inserts */
+void insert_keys(benchmark::State& state, const std::vector<uint32_t>& keys) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto temp = std::make_unique<TempTable>("engine_bench_insert.db");
+        Table& table = *temp->table;
+        state.ResumeTiming();
+        for (uint32_t key : keys) {
+            Row row = make_row(key);
+            table.insert(table.find(key), row);
+        }
+        state.PauseTiming();
+        /* Writing the pages back is not part of an insert */
+        temp.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+void BM_SequentialInsert(benchmark::State& state) {
+    std::vector<uint32_t> keys(state.range(0));
+    std::iota(keys.begin(), keys.end(), 1);
+    insert_keys(state, keys);
+}
+
+void BM_RandomInsert(benchmark::State& state) {
+    std::vector<uint32_t> keys(state.range(0));
+    std::iota(keys.begin(), keys.end(), 1);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937{42});
+    insert_keys(state, keys);
+}
+
+void BM_PointLookup(benchmark::State& state) {
+    uint32_t rows = state.range(0);
+    Table& table = filled(rows);
+    std::mt19937 random{42};
+    std::uniform_int_distribution<uint32_t> key{1, rows};
+    Row row;
+    for (auto _ : state) {
+        Cursor cursor = table.find(key(random));
+        row.deserialize(cursor.value());
+        benchmark::DoNotOptimize(row);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_FullScan(benchmark::State& state) {
+    Table& table = filled(state.range(0));
+    Row row;
+    for (auto _ : state) {
+        for (Cursor cursor = table.start(); !cursor.end_of_table;
+             cursor.advance()) {
+            row.deserialize(cursor.value());
+            benchmark::DoNotOptimize(row);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_RangeScan(benchmark::State& state) {
+    uint32_t rows = state.range(0);
+    Table& table = filled(rows);
+    std::mt19937 random{42};
+    std::uniform_int_distribution<uint32_t> start{1, rows - RANGE_ROWS + 1};
+    Row row;
+    for (auto _ : state) {
+        Cursor cursor = table.lower_bound(start(random));
+        for (uint32_t i = 0; i < RANGE_ROWS && !cursor.end_of_table; i++) {
+            row.deserialize(cursor.value());
+            benchmark::DoNotOptimize(row);
+            cursor.advance();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * RANGE_ROWS);
+}
+
+/*
+The first thread rewrites the username of random rows under the exclusive
+lock while the others look rows up under the shared one
+*/
+void BM_ReadWriteMix(benchmark::State& state) {
+    uint32_t rows = state.range(0);
+    Table& table = filled(rows);
+    bool writer = state.thread_index() == 0;
+    std::mt19937 random(42 + state.thread_index());
+    std::uniform_int_distribution<uint32_t> key{1, rows};
+    Row row;
+    for (auto _ : state) {
+        if (writer) {
+            std::unique_lock lock(table.mutex);
+            Cursor cursor = table.find(key(random));
+            char* value = cursor.value();
+            Row old_row;
+            old_row.deserialize(value);
+            row = old_row;
+            snprintf(row.username, sizeof(row.username), "w%u", row.id);
+            row.serialize(value);
+            table.update(cursor, old_row);
+        } else {
+            std::shared_lock lock(table.mutex);
+            Cursor cursor = table.find(key(random));
+            row.deserialize(cursor.value());
+            benchmark::DoNotOptimize(row);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/* Lexed, parsed, planned and run on every iteration */
+void BM_ParseExecute(benchmark::State& state) {
+    uint32_t rows = state.range(0);
+    Table& table = filled(rows);
+    FILE* null = fopen("/dev/null", "w");
+    ResultSink sink{null};
+    std::mt19937 random{42};
+    std::uniform_int_distribution<uint32_t> key{1, rows};
+    std::vector<std::string> inputs(1024);
+    for (std::string& input : inputs) {
+        input = "select where id = " + std::to_string(key(random));
+    }
+    size_t next = 0;
+    for (auto _ : state) {
+        Statement statement;
+        statement.prepare(inputs[next++ % inputs.size()]);
+        statement.execute(table, sink);
+    }
+    state.SetItemsProcessed(state.iterations());
+    sink.flush();
+    fclose(null);
+}
+
+/* The same lookups, planned once by the session's cache for every key */
+void BM_ParseExecuteCached(benchmark::State& state) {
+    uint32_t rows = state.range(0);
+    Table& table = filled(rows);
+    FILE* null = fopen("/dev/null", "w");
+    ResultSink sink{null};
+    std::mt19937 random{42};
+    std::uniform_int_distribution<uint32_t> key{1, rows};
+    std::vector<std::string> inputs(1024);
+    for (std::string& input : inputs) {
+        input = "select where id = " + std::to_string(key(random));
+    }
+    Session session;
+    size_t next = 0;
+    for (auto _ : state) {
+        Statement statement;
+        session.prepare(inputs[next++ % inputs.size()], statement);
+        statement.execute(table, sink);
+    }
+    state.SetItemsProcessed(state.iterations());
+    sink.flush();
+    fclose(null);
+}
+
+}  // namespace
+
+BENCHMARK(BM_SequentialInsert)
+    ->Apply(table_sizes)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RandomInsert)
+    ->Apply(table_sizes)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PointLookup)->Apply(table_sizes);
+BENCHMARK(BM_FullScan)
+    ->Apply(table_sizes)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_RangeScan)->Apply(table_sizes);
+BENCHMARK(BM_ReadWriteMix)
+    ->Apply(table_sizes)
+    ->ThreadRange(2, 8)
+    ->UseRealTime();
+BENCHMARK(BM_ParseExecute)->Apply(table_sizes);
+BENCHMARK(BM_ParseExecuteCached)->Apply(table_sizes);
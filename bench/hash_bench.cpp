@@ -0,0 +1,84 @@
+/*
+ * Point lookups through the B+ tree descent against the hash index on id,
+ * at several table sizes. Page fetches are counted through Pager::fetches,
+ * including repeated fetches of the same page within one lookup.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <eggshell/storage/table.hpp>
+#include <fstream>
+#include <random>
+#include <vector>
+
+namespace {
+
+const uint32_t LOOKUPS = 200000;
+
+struct Result {
+    double ns_per_lookup;
+    double pages_per_lookup;
+};
+
+Result measure(Table& table, const std::vector<uint32_t>& keys) {
+    HashIndex* hash = table.hash_index(Column::id);
+    uint64_t fetches = table.pager.fetches + (hash ? hash->pager.fetches : 0);
+    uint64_t checksum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < LOOKUPS; i++) {
+        checksum += table.find(keys[i % keys.size()]).cell_num;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    fetches = table.pager.fetches + (hash ? hash->pager.fetches : 0) - fetches;
+    if (checksum == 1) {
+        printf("\n");
+    }
+    return {std::chrono::duration<double, std::nano>(elapsed).count() /
+                LOOKUPS,
+            double(fetches) / LOOKUPS};
+}
+
+}  // namespace
+
+int main() {
+    printf("%10s %14s %14s %14s %14s\n", "rows", "btree ns", "btree pages",
+           "hash ns", "hash pages");
+
+    for (uint32_t rows : {1000, 10000, 100000}) {
+        std::string filename = "hash_bench.db";
+        std::remove(filename.c_str());
+        std::remove(HashIndex::filename(filename, Column::id).c_str());
+        std::ofstream{filename};
+
+        std::vector<uint32_t> keys(rows);
+        for (uint32_t i = 0; i < rows; i++) {
+            keys[i] = i + 1;
+        }
+        std::mt19937 rng{rows};
+        std::shuffle(keys.begin(), keys.end(), rng);
+
+        Result btree, hash;
+        {
+            Table table{filename};
+            Row row{};
+            for (uint32_t key : keys) {
+                row.id = key;
+                table.insert(table.find(key), row);
+            }
+            std::shuffle(keys.begin(), keys.end(), rng);
+
+            btree = measure(table, keys);
+            table.create_hash_index(Column::id);
+            hash = measure(table, keys);
+        }
+        printf("%10u %14.1f %14.2f %14.1f %14.2f\n", rows, btree.ns_per_lookup,
+               btree.pages_per_lookup, hash.ns_per_lookup,
+               hash.pages_per_lookup);
+
+        std::remove(filename.c_str());
+        std::remove(HashIndex::filename(filename, Column::id).c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,189 @@
+/*
+ * Load generator for eggshell-server. Loads keys 1..keys, then runs clients
+ * that each keep up to pipeline requests in flight: point selects by
+ * random id, and updates of the email of a random id for writes percent of
+ * them. Reports throughput and latency percentiles over all clients.
+ *
+ * eggshell-loadgen <address> [--clients n] [--requests n] [--pipeline n]
+ *                  [--keys n] [--writes percent] [--no-load]
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <eggshell/server/client.hpp>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    Address address;
+    uint32_t clients = 4;
+    uint32_t requests = 10000;
+    uint32_t pipeline = 1;
+    uint32_t keys = 10000;
+    uint32_t writes = 0;
+    bool load = true;
+};
+
+struct Result {
+    std::vector<double> latencies;
+    uint64_t errors = 0;
+};
+
+void connect(Client& client, const Options& options) {
+    if (!client.connect(options.address)) {
+        printf("Unable to connect: %s\n", strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+}
+
+void expect(Client& client, std::string& response) {
+    if (!client.receive(response)) {
+        printf("Connection closed by the server\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+void load(const Options& options) {
+    Client client;
+    connect(client, options);
+    std::string response;
+    const uint32_t depth = 64;
+    for (uint32_t key = 1; key <= options.keys; key++) {
+        client.send("insert " + std::to_string(key) + " u" +
+                    std::to_string(key % 7) + " e" + std::to_string(key) +
+                    "@x on conflict do update");
+        if (key > depth) {
+            expect(client, response);
+        }
+    }
+    for (uint32_t i = 0; i < std::min(depth, options.keys); i++) {
+        expect(client, response);
+    }
+}
+
+void run_client(const Options& options, uint32_t seed, Result& result) {
+    Client client;
+    connect(client, options);
+    std::mt19937 random{seed};
+    std::uniform_int_distribution<uint32_t> key{1, options.keys};
+    std::uniform_int_distribution<uint32_t> percent{0, 99};
+
+    std::deque<Clock::time_point> sent;
+    std::string response;
+    Response parsed;
+    result.latencies.reserve(options.requests);
+    for (uint32_t issued = 0; issued < options.requests || !sent.empty();) {
+        if (issued < options.requests && sent.size() < options.pipeline) {
+            std::string id = std::to_string(key(random));
+            if (percent(random) < options.writes) {
+                client.send("update set email = w" + id + "@x where id = " +
+                            id);
+            } else {
+                client.send("select * where id = " + id);
+            }
+            sent.push_back(Clock::now());
+            issued++;
+            continue;
+        }
+        expect(client, response);
+        auto elapsed = Clock::now() - sent.front();
+        sent.pop_front();
+        result.latencies.push_back(
+            std::chrono::duration<double, std::micro>(elapsed).count());
+        if (!parse_response(response, parsed) ||
+            parsed.status != ResponseStatus::ok) {
+            result.errors++;
+        }
+    }
+}
+
+bool number(int argc, char* argv[], int& i, uint32_t& value) {
+    if (i + 1 >= argc) {
+        return false;
+    }
+    value = atoi(argv[++i]);
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (argc < 2 || !parse_address(argv[1], options.address)) {
+        printf("Must supply a server address, unix:<path> or <host>:<port>\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 2; i < argc; i++) {
+        std::string flag = argv[i];
+        bool valid = flag == "--no-load";
+        if (valid) {
+            options.load = false;
+        } else if (flag == "--clients") {
+            valid = number(argc, argv, i, options.clients);
+        } else if (flag == "--requests") {
+            valid = number(argc, argv, i, options.requests);
+        } else if (flag == "--pipeline") {
+            valid = number(argc, argv, i, options.pipeline);
+        } else if (flag == "--keys") {
+            valid = number(argc, argv, i, options.keys);
+        } else if (flag == "--writes") {
+            valid = number(argc, argv, i, options.writes);
+        }
+        if (!valid || options.clients == 0 || options.pipeline == 0 ||
+            options.keys == 0) {
+            printf("Unrecognized option '%s'\n", flag.c_str());
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    if (options.load) {
+        load(options);
+    }
+
+    std::vector<Result> results(options.clients);
+    std::vector<std::thread> clients;
+    auto start = Clock::now();
+    for (uint32_t i = 0; i < options.clients; i++) {
+        clients.emplace_back(run_client, std::cref(options), i + 1,
+                             std::ref(results[i]));
+    }
+    for (std::thread& client : clients) {
+        client.join();
+    }
+    std::chrono::duration<double> seconds = Clock::now() - start;
+
+    std::vector<double> latencies;
+    uint64_t errors = 0;
+    for (const Result& result : results) {
+        latencies.insert(latencies.end(), result.latencies.begin(),
+                         result.latencies.end());
+        errors += result.errors;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) {
+        return latencies[std::min<size_t>(latencies.size() * p,
+                                          latencies.size() - 1)];
+    };
+
+    printf("%u clients, pipeline %u, %u%% writes\n", options.clients,
+           options.pipeline, options.writes);
+    printf("%zu requests in %.3f s, %.0f per second, %lu errors\n",
+           latencies.size(), seconds.count(),
+           latencies.size() / seconds.count(), errors);
+    if (!latencies.empty()) {
+        printf("latency us  p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f"
+               "  max %.1f\n",
+               percentile(0.5), percentile(0.9), percentile(0.99),
+               percentile(0.999), latencies.back());
+    }
+    return EXIT_SUCCESS;
+}
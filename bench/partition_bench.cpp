@@ -0,0 +1,90 @@
+/*
+ * Concurrent inserts of random keys, one statement each, into a table and
+ * into partitioned tables with one shard per thread and more. Writers of a
+ * single table wait on its one lock; writers of different shards do not.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <eggshell/compiler/statement.hpp>
+#include <eggshell/storage/catalog.hpp>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const uint32_t ROWS = 200000;
+
+std::vector<uint32_t> random_keys() {
+    std::vector<uint32_t> keys(ROWS);
+    for (uint32_t i = 0; i < ROWS; i++) {
+        keys[i] = i + 1;
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937{42});
+    return keys;
+}
+
+double inserts(Catalog& catalog, const std::string& table, uint32_t threads,
+               const std::vector<uint32_t>& keys) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> writers;
+    for (uint32_t t = 0; t < threads; t++) {
+        writers.emplace_back([&, t] {
+            Statement statement;
+            ResultSink sink{stdout};
+            statement.prepare("insert into " + table +
+                              " values (?, 'user', 'user@example.com')");
+            for (uint32_t i = t; i < keys.size(); i += threads) {
+                statement.bind(0, keys[i]);
+                statement.execute(catalog, sink);
+            }
+        });
+    }
+    for (std::thread& writer : writers) {
+        writer.join();
+    }
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+}  // namespace
+
+int main() {
+    std::string filename = "partition_bench.db";
+    std::vector<uint32_t> keys = random_keys();
+    uint32_t threads = std::max(2u, std::thread::hardware_concurrency());
+    printf("%u inserts on %u threads\n", ROWS, threads);
+
+    for (uint32_t partitions : {0u, threads, 4 * threads}) {
+        std::remove((filename + ".catalog").c_str());
+        std::ofstream{filename, std::ios::trunc};
+        std::vector<std::string> files{filename, filename + ".catalog"};
+        {
+            Catalog catalog{filename};
+            Statement create;
+            create.prepare(partitions == 0 ? "create table t"
+                                           : "create table t partitions " +
+                                                 std::to_string(partitions));
+            create.execute(catalog);
+            double ms = inserts(catalog, "t", threads, keys);
+            printf("%-24s %10.1f ms %10.0f rows/s\n",
+                   partitions == 0
+                       ? "one table"
+                       : (std::to_string(partitions) + " partitions").c_str(),
+                   ms, ROWS / ms * 1000);
+        }
+        files.push_back(Catalog::table_filename(filename, "t"));
+        for (uint32_t i = 0; i < partitions; i++) {
+            files.push_back(
+                PartitionedTable::shard_filename(filename + ".t", i));
+        }
+        for (const std::string& file : files) {
+            std::remove(file.c_str());
+        }
+    }
+    return 0;
+}
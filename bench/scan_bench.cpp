@@ -0,0 +1,71 @@
+/*
+ * Filtered full-table counts through ParallelScanOperator at increasing
+ * degrees of parallelism, up to the number of hardware threads. Each run
+ * reports the best of several scans and its speedup over one worker.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <eggshell/executor/aggregate.hpp>
+#include <eggshell/executor/parallelscan.hpp>
+#include <eggshell/storage/table.hpp>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const uint32_t ROWS = 500000;
+const uint32_t RUNS = 5;
+
+double measure(Table& table, uint32_t parallelism, uint64_t& matched) {
+    RowFilter filter = RowFilter::column(Column::username, "u3", false);
+    double best = 0;
+    for (uint32_t run = 0; run < RUNS; run++) {
+        auto start = std::chrono::steady_clock::now();
+        CountOperator count{std::make_unique<ParallelScanOperator>(
+            table, 0, filter, parallelism, false)};
+        auto batch = std::make_unique<Batch>();
+        count.next(*batch);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        matched = batch->aggregate[0][0].integer;
+        double ms = std::chrono::duration<double, std::milli>(elapsed).count();
+        best = run == 0 ? ms : std::min(best, ms);
+    }
+    return best;
+}
+
+}  // namespace
+
+int main() {
+    std::string filename = "scan_bench.db";
+    std::remove(filename.c_str());
+    std::ofstream{filename};
+
+    {
+        Table table{filename};
+        Row row{};
+        for (uint32_t key = 1; key <= ROWS; key++) {
+            row.id = key;
+            snprintf(row.username, sizeof(row.username), "u%u", key % 7);
+            snprintf(row.email, sizeof(row.email), "e%u@x", key);
+            table.insert(table.find(key), row);
+        }
+
+        uint32_t cores = std::max(std::thread::hardware_concurrency(), 1u);
+        printf("%6s %10s %10s %10s\n", "dop", "matched", "ms", "speedup");
+        double serial = 0;
+        for (uint32_t dop = 1; dop <= cores; dop *= 2) {
+            uint64_t matched;
+            double ms = measure(table, dop, matched);
+            serial = dop == 1 ? ms : serial;
+            printf("%6u %10lu %10.2f %10.2f\n", dop, matched, ms,
+                   serial / ms);
+        }
+    }
+    std::remove(filename.c_str());
+    return 0;
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+ * Bump allocator for the nodes of one parse. Small statements fit in the
+ * inline block, larger ones chain heap blocks; everything is released at
+ * once when the arena goes away, so nodes must be trivially destructible.
+ *
+ * A session's arena lives on across statements instead: a StatementScope
+ * makes it the current arena of its thread and resets it when the
+ * statement ends, keeping its blocks for the next one.
+ */
+class Arena {
+   public:
+    static constexpr size_t INLINE_SIZE = 1024;
+    static constexpr size_t BLOCK_SIZE = 4096;
+
+    Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(size_t size, size_t align);
+
+    /* Rewinds to empty, keeping the heap blocks */
+    void reset();
+
+    /* Bytes handed out since the last reset, padding included */
+    size_t used() const;
+
+    /* Heap blocks held, kept across resets */
+    size_t heap_blocks() const;
+
+    /* Arena of the statement running on this thread, nullptr if none */
+    static Arena* current();
+
+    /*
+    For class operator new and delete: memory from the current arena if
+    there is one, else from the heap. free_object is a no-op for arena
+    memory, which goes with the reset.
+    */
+    static void* allocate_object(size_t size);
+    static void free_object(void* object);
+
+    /*
+    Count of the objects allocate_object takes from the heap on this
+    thread, nullptr if none is kept. A StatementScope points it at its
+    statement's count, and the workers a statement starts on other
+    threads point theirs at the same one while they run.
+    */
+    static std::atomic<uint64_t>* heap_object_count();
+    static void count_heap_objects(std::atomic<uint64_t>* count);
+
+    template <typename T, typename... Args>
+    T* make(Args&&... args) {
+        static_assert(std::is_trivially_destructible_v<T>);
+        return new (allocate(sizeof(T), alignof(T)))
+            T{std::forward<Args>(args)...};
+    }
+
+   private:
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    alignas(std::max_align_t) char initial[INLINE_SIZE];
+    std::vector<Block> blocks;
+    /* Blocks before this one are in use since the last reset */
+    size_t next_block = 0;
+    char* top;
+    size_t remaining;
+    size_t used_bytes = 0;
+
+    static void make_current(Arena* arena);
+
+    friend class StatementScope;
+};
+
+/*
+ * Allocator for the buffers of one statement, such as sort records: memory
+ * comes from the arena current when the container is made, or from the
+ * heap if there is none. Arena memory only goes back with the reset, so a
+ * container should grow to its size once and then reuse it.
+ */
+template <typename T>
+class ArenaAllocator {
+   public:
+    using value_type = T;
+
+    ArenaAllocator() : arena{Arena::current()} {
+    }
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena{other.arena} {
+    }
+
+    T* allocate(size_t n) {
+        if (!arena) {
+            return std::allocator<T>{}.allocate(n);
+        }
+        if (n > SIZE_MAX / sizeof(T)) {
+            throw std::bad_array_new_length{};
+        }
+        return (T*)arena->allocate(n * sizeof(T), alignof(T));
+    }
+
+    void deallocate(T* p, size_t n) {
+        if (!arena) {
+            std::allocator<T>{}.deallocate(p, n);
+        }
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const {
+        return arena == other.arena;
+    }
+
+   private:
+    template <typename U>
+    friend class ArenaAllocator;
+
+    Arena* arena;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
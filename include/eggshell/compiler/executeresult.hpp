@@ -1,3 +1,11 @@
 #pragma once
 
-enum class ExecuteResult { success, table_full, duplicate_key };
+enum class ExecuteResult {
+    success,
+    table_full,
+    duplicate_key,
+    unbound_parameter,
+    table_exists,
+    partitioned_join,
+    read_only
+};
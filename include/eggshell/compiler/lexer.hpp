@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+/* Compares text with a lowercase keyword, ignoring the case of text */
+bool iequals(std::string_view text, std::string_view keyword);
+
+/* Keyword, column, function or index method, all matched ignoring case */
+bool is_keyword(std::string_view word);
+
+/*
+ * word         keyword, name or unquoted value: a run of anything but
+ *              whitespace, quotes and the symbols below
+ * string       'quoted value', text excludes the quotes
+ * symbol       one of ( ) , ; = *
+ * placeholder  ? standing for a value bound later
+ * end          end of input
+ * invalid      unterminated string
+ */
+enum class TokenType { word, string, symbol, placeholder, end, invalid };
+
+struct Token {
+    TokenType type;
+    /* Points into the lexed input, which must outlive the token */
+    std::string_view text;
+
+    /* Word matching a keyword, ignoring case */
+    bool is(std::string_view keyword) const;
+
+    bool is(char symbol) const;
+
+    /* Word, string or placeholder, anything usable as a value */
+    bool is_value() const;
+};
+
+class Lexer {
+   public:
+    Lexer(std::string_view input);
+
+    Token next();
+
+    /* Offset of the next unread character */
+    size_t offset() const;
+
+   private:
+    std::string_view input;
+    size_t pos;
+};
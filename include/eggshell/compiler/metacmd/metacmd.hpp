@@ -4,6 +4,9 @@
 #include <string>
 
 #include "eggshell/compiler/metacmd/metacmdresult.hpp"
+#include "eggshell/compiler/session.hpp"
+#include "eggshell/executor/resultsink.hpp"
+#include "eggshell/storage/catalog.hpp"
 #include "eggshell/storage/pager.hpp"
 #include "eggshell/storage/table.hpp"
 
@@ -13,4 +16,20 @@ void indent(uint32_t level);
 
 void print_tree(Pager& pager, uint32_t page_num, uint32_t indentation_level);
 
-MetaCmdResult do_meta_cmd(std::string input, Table& table);
\ No newline at end of file
+/* Memtable and runs per level of a table using the LSM engine */
+void print_lsm(LsmTree& lsm);
+
+/*
+One row of what the last statement allocated: batches and operators
+that missed the arena, heap blocks the arena grew by, and arena bytes
+*/
+void print_stats(const StatementStats& stats, ResultSink& sink);
+
+/*
+Settings apply to every table of the catalog, .btree to the main one and
+.format to the sink results are written to. .stats reports on the
+session's last statement. The sink is flushed first, so rows of earlier
+statements come out before anything a command prints.
+*/
+MetaCmdResult do_meta_cmd(std::string input, Catalog& catalog,
+                          ResultSink& sink, const Session& session);
\ No newline at end of file
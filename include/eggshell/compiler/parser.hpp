@@ -1,30 +1,183 @@
 #pragma once
 
-#include <string>
-#include <vector>
+#include <string_view>
 
-enum class ASTNodeType { select, insert };
+#include "eggshell/compiler/arena.hpp"
+#include "eggshell/compiler/lexer.hpp"
+#include "eggshell/compiler/prepareresult.hpp"
+
+/*
+ * Syntax tree of one statement. Nodes live in the parser's arena and their
+ * text points into the input, so both must outlive the tree. Names are
+ * left unchecked; binding them to columns is up to the statement.
+ */
+enum class ASTNodeType {
+    select,
+    insert,
+    update,
+    create_index,
+    create_table,
+    vacuum,
+    prepare,
+    execute,
+    deallocate
+};
 
 struct ASTNode {
     ASTNodeType type;
+    /* Empty when the statement names no table */
+    std::string_view table;
+};
 
-    ASTNode(ASTNodeType type);
+struct ASTList {
+    Token value;
+    ASTList* next;
 };
 
-// Define the AST node for SELECT statement
-struct SelectNode : ASTNode {
-    std::vector<std::string> columns;
-    std::string table;
+enum class PredicateOp { eq, between, like };
+
+/* <column> = <value> | <column> between <value> and <high> | <column> like */
+struct Predicate {
+    std::string_view column;
+    PredicateOp op;
+    Token value;
+    Token high;
+};
+
+struct Assignment {
+    std::string_view column;
+    Token value;
+    Assignment* next;
+};
 
-    SelectNode(ASTNodeType type);
+/* <column> or <function>(<column> | *) in a select list */
+struct SelectItem {
+    /* Empty for a plain column */
+    std::string_view function;
+    /* Empty for * */
+    std::string_view column;
+    SelectItem* next;
 };
 
-// Define the AST node for INSERT statement
+/*
+select [* | <item>, ...] [from <table> [[inner] join <table> on <column> =
+       <column>]] [where <predicate>]
+       [group by <column>] [order by <column> [asc | desc]]
+       [limit <n>] [offset <n>]
+*/
+struct SelectNode : ASTNode {
+    /* nullptr for * */
+    SelectItem* items;
+    /* Empty without a join; columns may be qualified as <table>.<column> */
+    std::string_view join_table;
+    std::string_view join_left;
+    std::string_view join_right;
+    Predicate* where;
+    /* Empty when absent */
+    std::string_view group_by;
+    std::string_view order_by;
+    bool descending;
+    /* TokenType::end when absent */
+    Token limit;
+    Token offset;
+};
+
+/*
+insert [into <table> values] (<value>, ...) [on conflict do update]
+insert <value> ... [on conflict do update]
+*/
 struct InsertNode : ASTNode {
-    std::string table;
-    std::vector<std::string> values;
+    ASTList* values;
+    bool on_conflict_update;
+};
+
+/* update [<table>] set <column> = <value> [,] ... where <predicate> */
+struct UpdateNode : ASTNode {
+    Assignment* assignments;
+    Predicate* where;
+};
+
+/* create index on (<column> | <table> (<column>)) [using <method>] */
+struct CreateIndexNode : ASTNode {
+    std::string_view column;
+    /* Empty when absent */
+    std::string_view method;
+};
+
+/* create table <table> [partitions <n> [by hash | by range <width>]] */
+struct CreateTableNode : ASTNode {
+    /* TokenType::end when absent */
+    Token partitions;
+    bool range;
+    Token range_width;
+};
+
+/* vacuum [<table>] [fill <percent>] */
+struct VacuumNode : ASTNode {
+    /* TokenType::end when absent */
+    Token fill;
+};
+
+/* prepare <name> as <statement> */
+struct PrepareNode : ASTNode {
+    std::string_view name;
+    /* Left unparsed, from the first token after as to the end */
+    std::string_view body;
+};
 
-    InsertNode(ASTNodeType type);
+/* execute <name> [(<value>, ...)] */
+struct ExecuteNode : ASTNode {
+    std::string_view name;
+    ASTList* arguments;
 };
 
-ASTNode parseSQL(const std::string& query);
\ No newline at end of file
+/* deallocate [prepare] <name> */
+struct DeallocateNode : ASTNode {
+    std::string_view name;
+};
+
+/*
+Recursive-descent parser over the lexer's tokens, one statement per input
+with an optional trailing ';'
+*/
+class Parser {
+   public:
+    Parser(std::string_view input, Arena& arena);
+
+    /* Unrecognized for an unknown leading keyword, syntax error otherwise */
+    CmdPrepareResult parse(ASTNode*& node);
+
+    /*
+    Whether a table name or unquoted value is spelled like a keyword. Its
+    case matters where a keyword's does not, so the plan cache, which
+    lowercases keywords in its keys, leaves such a statement out.
+    */
+    bool keyword_spelled = false;
+
+   private:
+    std::string_view input;
+    Lexer lexer;
+    Arena& arena;
+    Token token;
+
+    void advance();
+    bool accept(std::string_view keyword);
+    bool accept(char symbol);
+    bool name(std::string_view& name);
+    /* A name whose case matters, a table's */
+    bool exact_name(std::string_view& name);
+    bool value(Token& value);
+    bool list(ASTList*& list);
+    bool predicate(Predicate*& predicate);
+    bool items(SelectItem*& items);
+
+    bool select(ASTNode*& node);
+    bool insert(ASTNode*& node);
+    bool update(ASTNode*& node);
+    bool create_index(ASTNode*& node);
+    bool create_table(ASTNode*& node);
+    bool vacuum(ASTNode*& node);
+    bool prepare(ASTNode*& node);
+    bool execute(ASTNode*& node);
+    bool deallocate(ASTNode*& node);
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "eggshell/compiler/statement.hpp"
+
+/*
+ * Least recently used map from normalized SQL to its planned statement.
+ * Plans pick their access path when executed, so they never go stale as
+ * the table changes.
+ */
+class PlanCache {
+   public:
+    static constexpr size_t DEFAULT_CAPACITY = 128;
+
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+
+    PlanCache(size_t capacity = DEFAULT_CAPACITY);
+
+    /*
+    Key for input: its tokens separated by single spaces, keywords in
+    lowercase and a trailing ';' dropped, so spacing and keyword case never
+    miss. Quoted strings and unsigned numbers go to literals in order and
+    stand as ? in the key, so statements differing only in their values
+    share it; the key is the statement planned for all of them. Input with
+    placeholders of its own keeps its literals, strings quoted again.
+    */
+    static void normalize(std::string_view input, std::string& key,
+                          std::vector<std::string_view>& literals);
+
+    /* Planned statement for key, nullptr on a miss */
+    const Statement* find(const std::string& key);
+
+    void insert(const std::string& key, const Statement& statement);
+
+    size_t size() const;
+
+   private:
+    size_t capacity;
+    /* Most recently used first */
+    std::list<std::pair<std::string, Statement>> entries;
+    std::unordered_map<std::string_view, decltype(entries)::iterator> index;
+};
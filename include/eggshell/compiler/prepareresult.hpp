@@ -5,5 +5,6 @@ enum class CmdPrepareResult {
     unrecognized,
     syntax_error,
     string_too_long,
-    id_out_of_range
+    id_out_of_range,
+    unknown_prepared
 };
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/*
+ * Statements of a script read from a file in large chunks rather than a
+ * line at a time. Statements end at a ; outside a 'quoted value', or at
+ * the end of the file, and may span lines. A line starting with . is a
+ * meta command and ends at the line break instead. Surrounding whitespace
+ * and the ; are dropped, and empty statements skipped.
+ */
+class ScriptReader {
+   public:
+    static constexpr size_t CHUNK_SIZE = 1 << 20;
+
+    ScriptReader(FILE* file);
+
+    /* Next statement into statement, false at the end of the file */
+    bool next(std::string& statement);
+
+   private:
+    FILE* file;
+    std::vector<char> buffer;
+    /* Unread bytes are buffer[pos, end) */
+    size_t pos = 0;
+    size_t end = 0;
+    bool eof = false;
+
+    /* Appends another chunk after the unread bytes, false at the end */
+    bool fill();
+};
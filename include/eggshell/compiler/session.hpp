@@ -0,0 +1,49 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "eggshell/compiler/arena.hpp"
+#include "eggshell/compiler/plancache.hpp"
+#include "eggshell/compiler/prepareresult.hpp"
+#include "eggshell/compiler/statement.hpp"
+#include "eggshell/compiler/stats.hpp"
+
+/*
+ * State of one client: the plan cache and the statements it named with
+ * PREPARE. Each input goes through prepare and comes out as a statement
+ * ready to execute, both inside a StatementScope on arena.
+ */
+class Session {
+   public:
+    PlanCache cache;
+    /* Syntax trees, plans and batches of the running statement */
+    Arena arena;
+    /* Of the last statement run in a scope */
+    StatementStats stats;
+
+    /*
+    Plans input through the cache, or runs prepare <name> as <statement>,
+    execute <name> (<value>, ...) and deallocate <name>. The last two
+    leave a noop statement to execute.
+    */
+    CmdPrepareResult prepare(std::string_view input, Statement& statement);
+
+    /* Statement named by PREPARE, nullptr if there is none */
+    const Statement* prepared(std::string_view name) const;
+
+   private:
+    std::map<std::string, Statement, std::less<>> named;
+    /* Reused across calls to avoid an allocation per statement */
+    std::string key;
+    std::vector<std::string_view> literals;
+};
+
+/* What to tell the user about a failed prepare, empty on success */
+std::string prepare_error(CmdPrepareResult result, std::string_view input);
+
+/* What to tell the user after executing, "Executed." on success */
+const char* execute_message(ExecuteResult result);
@@ -1,23 +1,229 @@
 #pragma once
 
+#include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "eggshell/compiler/executeresult.hpp"
 #include "eggshell/compiler/prepareresult.hpp"
+#include "eggshell/executor/aggregate.hpp"
+#include "eggshell/executor/operator.hpp"
+#include "eggshell/executor/resultsink.hpp"
+#include "eggshell/storage/partition.hpp"
 #include "eggshell/storage/row.hpp"
 #include "eggshell/storage/table.hpp"
 
-enum class StatementType { insert, select };
+class Catalog;
+struct ASTNode;
+struct InsertNode;
+struct UpdateNode;
+struct SelectNode;
+struct CreateIndexNode;
+struct CreateTableNode;
+struct VacuumNode;
+struct Predicate;
+struct Token;
+
+/* noop is what PREPARE and DEALLOCATE leave to execute */
+enum class StatementType {
+    insert,
+    select,
+    update,
+    create_index,
+    create_table,
+    vacuum,
+    noop
+};
+
+/* Field a value or a ? placeholder of the statement is written to */
+enum class Parameter {
+    id,
+    username,
+    email,
+    key,
+    key_min,
+    key_max,
+    where_value,
+    where_pattern,
+    limit,
+    offset
+};
 
 struct Statement {
     StatementType type;
+    /* Table the statement names, empty for the main table */
+    std::string table_name;
     Row row_to_insert;
+    /* INSERT ... ON CONFLICT DO UPDATE overwrites the existing cell */
+    bool on_conflict_update = false;
+
+    /* UPDATE assigns the set columns of row_to_insert to keys in range */
+    bool set_username = false;
+    bool set_email = false;
+    uint32_t key_min = 0;
+    uint32_t key_max = 0;
+
+    /*
+    SELECT projection and an optional single-column WHERE. A WHERE on id is
+    the inclusive key range key_min..key_max.
+    */
+    bool select_id_only = false;
+    bool count_only = false;
+    bool has_where = false;
+    Column where_column = Column::id;
+    bool where_prefix = false;
+    std::string where_value;
+    uint32_t limit = UINT32_MAX;
+    uint32_t offset = 0;
+
+    /*
+    Aggregates of the select list in output order, COUNT(*) alone being
+    count_only. With GROUP BY the group column may be selected too, at
+    group_position among the aggregates.
+    */
+    std::vector<AggregateSpec> aggregates;
+    bool has_group = false;
+    Column group_column = Column::id;
+    uint32_t group_position = UINT32_MAX;
+
+    /*
+    SELECT * | COUNT(*) FROM table_name JOIN join_table ON <left> = <right>,
+    with join_left a column of table_name and join_right one of join_table
+    */
+    bool has_join = false;
+    std::string join_table;
+    Column join_left = Column::id;
+    Column join_right = Column::id;
+
+    /* ORDER BY, ascending id being the order rows are stored in */
+    bool has_order = false;
+    Column order_column = Column::id;
+    bool order_descending = false;
+
+    /* CREATE INDEX ON <column> [USING HASH] */
+    Column index_column = Column::username;
+    bool index_hash = false;
+
+    /* CREATE TABLE ... PARTITIONS, not partitioned by default */
+    PartitionSpec partitioning;
+
+    /* VACUUM ... FILL, the share of each rewritten leaf's cells used */
+    uint32_t fill_percent = 100;
+
+    /* Placeholders in the order they appear, and which are bound */
+    std::vector<Parameter> parameters;
+    std::vector<bool> bound;
+
+    /* Parses input and plans its tree into the fields above */
+    CmdPrepareResult prepare(std::string_view input);
+
+    CmdPrepareResult plan(const ASTNode& node);
+
+    CmdPrepareResult plan(const InsertNode& node);
+
+    CmdPrepareResult plan(const UpdateNode& node);
+
+    CmdPrepareResult plan(const SelectNode& node);
+
+    CmdPrepareResult plan(const CreateIndexNode& node);
+
+    CmdPrepareResult plan(const CreateTableNode& node);
+
+    CmdPrepareResult plan(const VacuumNode& node);
+
+    /* JOIN ... ON into the join fields */
+    CmdPrepareResult plan_join(const SelectNode& node);
+
+    /* WHERE on id into key_min..key_max */
+    CmdPrepareResult plan_key_range(const Predicate& where);
+
+    /* Writes a value, or records a placeholder for it */
+    CmdPrepareResult set(Parameter parameter, const Token& value);
 
-    CmdPrepareResult prepare(std::string input);
+    CmdPrepareResult set(Parameter parameter, std::string_view value);
+
+    /*
+    Binds the placeholder at index, with the same checks as a literal.
+    Values stay bound across executions until bound again.
+    */
+    CmdPrepareResult bind(uint32_t index, std::string_view value);
+
+    CmdPrepareResult bind(uint32_t index, uint32_t value);
+
+    uint32_t num_parameters() const;
 
     ExecuteResult execute_insert(Table& table);
 
-    ExecuteResult execute_select(Table& table) const;
+    ExecuteResult execute_update(Table& table);
+
+    ExecuteResult execute_select(Table& table, ResultSink& sink) const;
+
+    /* Aggregates other than a bare COUNT(*), and GROUP BY */
+    ExecuteResult execute_aggregate(Table& table, ResultSink& sink) const;
+
+    /*
+    Fans out over the shards a select can find rows in, merging their scans
+    in key order when the output needs it
+    */
+    ExecuteResult execute_select(PartitionedTable& table,
+                                 ResultSink& sink) const;
+
+    ExecuteResult execute_create_index(Table& table);
+
+    /* Merge join when both sides join on id, hash join otherwise */
+    ExecuteResult execute_join(Table& left, Table& right,
+                               ResultSink& sink) const;
+
+    /*
+    Runs against a single table, which every table name refers to, so a
+    join is a self-join and CREATE TABLE does nothing
+    */
+    ExecuteResult execute(Table& table, ResultSink& sink);
+
+    /*
+    Runs inserts and point selects on the shard of their key. Updates and
+    indexes are applied shard by shard, each shard on its own lock.
+    */
+    ExecuteResult execute(PartitionedTable& table, ResultSink& sink);
+
+    /* Runs against the tables of a catalog, resolved by name */
+    ExecuteResult execute(Catalog& catalog, ResultSink& sink);
 
+    /* As above, printing straight to stdout as text */
     ExecuteResult execute(Table& table);
-};
\ No newline at end of file
+
+    ExecuteResult execute(Catalog& catalog);
+
+    void apply_update(char* value) const;
+
+    /* Columns the select prints */
+    ColumnSet projection() const;
+
+    /* Whether rows in key order already satisfy the ORDER BY */
+    bool key_ordered() const;
+
+    /*
+    Whether OFFSET or LIMIT leave out the one row of a COUNT(*) or of
+    aggregates without GROUP BY
+    */
+    bool single_row_dropped() const;
+
+    /* Sorts, offsets, limits and projects the rows of a scan */
+    std::unique_ptr<Operator> sorted(std::unique_ptr<Operator> scan,
+                                     const Table& table) const;
+
+    /*
+    Counts the rows of a scan, or orders, offsets, limits and projects
+    them, as the select asks
+    */
+    std::unique_ptr<Operator> finish(std::unique_ptr<Operator> scan,
+                                     const Table& table) const;
+
+    void print_row(const Row& row, ResultSink& sink) const;
+
+    /* Drains a select's plan into the sink */
+    void print(Operator& plan, ResultSink& sink) const;
+
+    void print(const Batch& batch, ResultSink& sink) const;
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+class Arena;
+
+/*
+ * What the last statement of a session cost, shown by .stats. Only memory
+ * that goes through the arena is counted: batches, operators, sort and
+ * join buffers, and the blocks the arena is made of. Plan cache entries,
+ * the strings a statement copies out of them and the like come from the
+ * heap uncounted.
+ */
+struct StatementStats {
+    /*
+    Batches and operators that missed the arena, made on threads without
+    one such as the workers of a parallel scan
+    */
+    uint64_t heap_objects = 0;
+    /* Heap blocks the arena grew by */
+    uint64_t arena_blocks = 0;
+    /* Bytes taken from the session's statement arena */
+    uint64_t arena_bytes = 0;
+};
+
+/*
+ * Brackets the prepare and execution of one statement: arena becomes the
+ * thread's current arena and the scope's count its heap object count, and
+ * on the way out stats gets what the statement allocated and the arena is
+ * reset for the next one.
+ */
+class StatementScope {
+   public:
+    StatementScope(Arena& arena, StatementStats& stats);
+    ~StatementScope();
+
+    StatementScope(const StatementScope&) = delete;
+    StatementScope& operator=(const StatementScope&) = delete;
+
+   private:
+    Arena& arena;
+    StatementStats& stats;
+    Arena* previous;
+    std::atomic<uint64_t>* previous_count;
+    std::atomic<uint64_t> heap_objects = 0;
+    size_t heap_blocks;
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "eggshell/executor/operator.hpp"
+
+enum class AggregateFunction { count, sum, min, max, avg };
+
+/* COUNT counts rows whatever the column, the others take id */
+struct AggregateSpec {
+    AggregateFunction function;
+    Column column;
+};
+
+/* COUNT(*): drains its child and hands out a single aggregate row */
+class CountOperator : public Operator {
+   public:
+    CountOperator(std::unique_ptr<Operator> child);
+
+    bool next(Batch& batch) override;
+
+   private:
+    std::unique_ptr<Operator> child;
+    bool done;
+};
+
+/*
+Aggregates its child's rows, grouped on a column through a hash table.
+Groups come out in the order they were first seen, with the group value
+in its column and aggregate k in Batch::aggregate[k]. Without grouping
+there is exactly one group, even over no rows.
+*/
+class HashAggregateOperator : public Operator {
+   public:
+    HashAggregateOperator(std::unique_ptr<Operator> child, bool grouped,
+                          Column group_column,
+                          std::vector<AggregateSpec> aggregates);
+
+    /* Hands groups out sorted on the group value instead */
+    void order_groups(bool descending);
+
+    bool next(Batch& batch) override;
+
+   private:
+    struct Group {
+        uint64_t count = 0;
+        uint64_t sum = 0;
+        uint32_t min = UINT32_MAX;
+        uint32_t max = 0;
+    };
+
+    std::unique_ptr<Operator> child;
+    bool grouped;
+    Column group_column;
+    std::vector<AggregateSpec> aggregates;
+
+    /* Group values as bytes, the 4 of an id or a string up to its NUL */
+    std::unordered_map<std::string, uint32_t> positions;
+    std::vector<std::string> keys;
+    std::vector<Group> groups;
+    bool built;
+    bool ordered = false;
+    bool descending = false;
+    /* Group indexes in the order they are handed out */
+    std::vector<uint32_t> order;
+    /* Groups handed out so far */
+    uint32_t emitted;
+
+    void build(Batch& batch);
+    AggregateValue result(const AggregateSpec& spec, const Group& group);
+};
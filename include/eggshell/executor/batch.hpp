@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "eggshell/compiler/arena.hpp"
+#include "eggshell/storage/row.hpp"
+
+/* Bit per column a batch carries, indexed by Column */
+using ColumnSet = uint32_t;
+
+constexpr ColumnSet column_set(Column column) {
+    return 1u << int(column);
+}
+
+constexpr ColumnSet ALL_COLUMNS = 0b111;
+/* Output of aggregates, in Batch::aggregate */
+constexpr ColumnSet AGGREGATE_COLUMN = 1u << 3;
+
+/* Result of an aggregate, real for AVG and integer otherwise */
+struct AggregateValue {
+    /* MIN, MAX, SUM and AVG over no rows */
+    bool null;
+    union {
+        uint64_t integer;
+        double real;
+    };
+};
+
+/*
+ * Rows passed between operators, stored column by column so kernels run
+ * over contiguous arrays. A scan fills rows 0..count-1; operators then
+ * narrow selection, the positions of the rows still live, instead of
+ * moving column values around.
+ */
+struct Batch {
+    static constexpr uint32_t CAPACITY = 1024;
+    /* Aggregates one select list may hold */
+    static constexpr uint32_t MAX_AGGREGATES = 4;
+
+    /* Rows filled in by the scan */
+    uint32_t count = 0;
+    /* Live rows, the first size entries of selection */
+    uint32_t size = 0;
+    ColumnSet columns = 0;
+    uint32_t selection[CAPACITY];
+
+    uint32_t id[CAPACITY];
+    char username[CAPACITY][Row::COLUMN_USERNAME_SIZE + 1];
+    char email[CAPACITY][Row::COLUMN_EMAIL_SIZE + 1];
+    AggregateValue aggregate[MAX_AGGREGATES][CAPACITY];
+
+    /* From the statement's arena while one runs on the thread */
+    static void* operator new(size_t size) {
+        return Arena::allocate_object(size);
+    }
+    static void operator delete(void* batch) {
+        Arena::free_object(batch);
+    }
+
+    /* Copies the live rows of other, compacted to rows 0..size-1 */
+    void assign(const Batch& other);
+
+    /* Copies the columns of other's row other_row present in it into row */
+    void copy(uint32_t row, const Batch& other, uint32_t other_row);
+
+    /* Writes all three columns of value into row */
+    void set(uint32_t row, const Row& value);
+
+    /* Start of the values of a string column */
+    char* column(Column column, uint32_t row);
+    const char* column(Column column, uint32_t row) const;
+
+    static uint32_t stride(Column column);
+};
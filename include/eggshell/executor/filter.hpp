@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "eggshell/executor/operator.hpp"
+
+/* Drops rows failing a predicate on one column */
+class FilterOperator : public Operator {
+   public:
+    /* Keeps rows whose id is in key_min..key_max */
+    FilterOperator(std::unique_ptr<Operator> child, uint32_t key_min,
+                   uint32_t key_max);
+
+    /* Keeps rows whose column equals value, or starts with it if prefix */
+    FilterOperator(std::unique_ptr<Operator> child, Column column,
+                   std::string value, bool prefix);
+
+    bool next(Batch& batch) override;
+
+   private:
+    std::unique_ptr<Operator> child;
+    Column column;
+    uint32_t key_min;
+    uint32_t key_max;
+    std::string value;
+    /* Bytes of value compared, including the terminator for equality */
+    uint32_t length;
+    /* Outcome per physical row, filled before compacting the selection */
+    uint8_t keep[Batch::CAPACITY];
+
+    void evaluate(Batch& batch);
+};
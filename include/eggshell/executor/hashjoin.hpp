@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "eggshell/executor/join.hpp"
+#include "eggshell/executor/scan.hpp"
+#include "eggshell/storage/table.hpp"
+
+/*
+Equi-join on any columns. The smaller table is the build side, loaded into
+a hash table on its join value, and the other table probes it. When the
+build side would not fit in memory_budget both tables are first split by
+join value into partitions in temporary files, sized so a partition's
+build rows fit, and the partitions are joined one at a time. An id joined
+to a string column compares as its decimal text.
+*/
+class HashJoinOperator : public JoinOperator {
+   public:
+    /* Hash table memory per build row beyond the row itself, roughly */
+    static constexpr uint64_t ROW_OVERHEAD = 64;
+    /* At most this many partitions, two files each */
+    static constexpr uint32_t MAX_PARTITIONS = 256;
+
+    HashJoinOperator(Table& left, Column left_column, Table& right,
+                     Column right_column, uint64_t memory_budget);
+    ~HashJoinOperator() override;
+
+    bool next(Batch& left, Batch& right) override;
+
+    /* 1 when the build side fits in memory */
+    uint32_t partitions() const;
+
+   private:
+    using Map = std::unordered_multimap<std::string, uint32_t>;
+
+    Table& build_table;
+    Column build_column;
+    Table& probe_table;
+    Column probe_column;
+    bool build_left;
+    uint32_t num_partitions = 1;
+    std::vector<FILE*> build_files;
+    std::vector<FILE*> probe_files;
+
+    /* Partition being joined, with its build rows loaded */
+    uint32_t partition = 0;
+    bool loaded = false;
+    /* In the statement's arena, reused by each partition in turn */
+    ArenaVector<Row> rows;
+    Map map;
+
+    /* Probe rows, straight from the scan when there is one partition */
+    std::unique_ptr<ScanOperator> probe_scan;
+    std::unique_ptr<Batch> probe_rows;
+    uint32_t probe_position = 0;
+    Row probe_row;
+    /* Build rows matching probe_row not yet handed out */
+    std::pair<Map::iterator, Map::iterator> matches;
+    std::string key;
+
+    void partition_rows(Table& table, Column column,
+                        std::vector<FILE*>& files);
+    void load();
+    bool next_probe();
+    void emit(Batch& left, Batch& right, const Row& build_row);
+
+    static void make_key(const Row& row, Column column, std::string& key);
+    uint32_t partition_of(const std::string& key) const;
+};
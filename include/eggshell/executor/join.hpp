@@ -0,0 +1,15 @@
+#pragma once
+
+#include "eggshell/executor/batch.hpp"
+
+/*
+ * Pull-based join of two tables. Each call fills a pair of batches whose
+ * rows match up by position: live row i of left joins live row i of right.
+ */
+class JoinOperator {
+   public:
+    virtual ~JoinOperator() = default;
+
+    /* Fills both batches with the next pairs, false once there are none */
+    virtual bool next(Batch& left, Batch& right) = 0;
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "eggshell/executor/operator.hpp"
+
+/* Skips offset rows, then passes at most limit rows and stops pulling */
+class LimitOperator : public Operator {
+   public:
+    LimitOperator(std::unique_ptr<Operator> child, uint32_t offset,
+                  uint32_t limit);
+
+    bool next(Batch& batch) override;
+
+   private:
+    std::unique_ptr<Operator> child;
+    uint32_t offset;
+    uint32_t limit;
+};
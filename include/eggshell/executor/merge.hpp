@@ -0,0 +1,37 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "eggshell/executor/operator.hpp"
+
+/*
+ * Rows of several children over disjoint keys, such as the scans of the
+ * shards of a partitioned table. Ordered merges rows from all children in
+ * key order, copying them into the output batch; otherwise the batches of
+ * one child are passed through after those of the one before it.
+ */
+class MergeOperator : public Operator {
+   public:
+    MergeOperator(std::vector<std::unique_ptr<Operator>> children,
+                  bool ordered);
+
+    bool next(Batch& batch) override;
+
+   private:
+    struct Input {
+        std::unique_ptr<Operator> child;
+        std::unique_ptr<Batch> batch;
+        /* Index into batch->selection of the next row */
+        uint32_t position = 0;
+        bool done = false;
+    };
+
+    std::vector<Input> inputs;
+    bool ordered;
+    /* Child being passed through when not ordered */
+    size_t current = 0;
+
+    /* Pulls the next batch of an input whose rows are used up */
+    void refill(Input& input);
+};
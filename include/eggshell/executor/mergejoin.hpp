@@ -0,0 +1,30 @@
+#pragma once
+
+#include <memory>
+
+#include "eggshell/executor/join.hpp"
+#include "eggshell/executor/scan.hpp"
+#include "eggshell/storage/table.hpp"
+
+/*
+Equi-join on id. Both tables are scanned in key order along their leaf
+chains and the scan that is behind advances, so every row is read once and
+nothing is buffered beyond a batch per side.
+*/
+class MergeJoinOperator : public JoinOperator {
+   public:
+    MergeJoinOperator(Table& left, Table& right);
+
+    bool next(Batch& left, Batch& right) override;
+
+   private:
+    ScanOperator left_scan;
+    ScanOperator right_scan;
+    std::unique_ptr<Batch> left_rows;
+    std::unique_ptr<Batch> right_rows;
+    /* Next live row of each side's current batch */
+    uint32_t left_position = 0;
+    uint32_t right_position = 0;
+
+    static bool fill(ScanOperator& scan, Batch& rows, uint32_t& position);
+};
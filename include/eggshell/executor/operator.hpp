@@ -0,0 +1,24 @@
+#pragma once
+
+#include "eggshell/executor/batch.hpp"
+
+/*
+ * Stage of a pull-based pipeline. Each call hands out the next batch with
+ * at least one live row, so virtual calls and branches are paid once per
+ * batch rather than once per row.
+ */
+class Operator {
+   public:
+    virtual ~Operator() = default;
+
+    /* Plans are built per statement, in its arena like batches */
+    static void* operator new(size_t size) {
+        return Arena::allocate_object(size);
+    }
+    static void operator delete(void* plan) {
+        Arena::free_object(plan);
+    }
+
+    /* Fills batch with the next rows, false once there are none left */
+    virtual bool next(Batch& batch) = 0;
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "eggshell/executor/operator.hpp"
+#include "eggshell/executor/rowfilter.hpp"
+#include "eggshell/storage/table.hpp"
+
+/*
+Full scan split into key ranges at the separators of the upper internal
+nodes (Table::split), scanned by parallelism workers on the shared thread
+pool. Unordered output hands batches out as workers produce them, for
+aggregates: each worker starts with a contiguous run of ranges and, once
+it runs out, steals ranges from the back of the others. Ordered output
+hands them out range by range, so rows come in key order like
+ScanOperator, and workers take ranges strictly in key order, so a range
+is only taken once every range before it has been. Once max_rows rows are
+handed out the workers are stopped. The caller holds the table's shared
+lock for the lifetime of the scan.
+*/
+class ParallelScanOperator : public Operator {
+   public:
+    /* Ranges per worker, so stealing can even out skewed ranges */
+    static constexpr uint32_t RANGES_PER_WORKER = 4;
+    /*
+    Batches waiting for the consumer before workers block. In ordered
+    output the worker on the range being drained never does, so the scan
+    always moves on, even when workers wait for pool threads.
+    */
+    static constexpr uint32_t QUEUE_LIMIT = 16;
+
+    ParallelScanOperator(Table& table, ColumnSet columns,
+                         const RowFilter& filter, uint32_t parallelism,
+                         bool ordered, uint32_t max_rows = UINT32_MAX);
+    ~ParallelScanOperator() override;
+
+    bool next(Batch& batch) override;
+
+   private:
+    struct Range {
+        uint32_t key_min = 0;
+        uint32_t key_max = 0;
+        /* Batches of this range not yet handed out, ordered output only */
+        std::deque<std::unique_ptr<Batch>> output;
+        bool done = false;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        /* Indexes into ranges, popped from the front by the owner */
+        std::deque<uint32_t> ranges;
+    };
+
+    Table& table;
+    ColumnSet columns;
+    RowFilter filter;
+    bool ordered;
+    /* No range scans more rows than this */
+    const uint32_t max_rows;
+    /* Rows still to hand out, only touched by the consumer */
+    uint32_t remaining;
+
+    std::vector<Range> ranges;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<bool> cancelled = false;
+    /* Next range to take in ordered output, which does not steal */
+    std::atomic<uint32_t> next_range = 0;
+
+    /* Guards everything below, and the output deques of ranges */
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<std::unique_ptr<Batch>> output;
+    std::vector<std::unique_ptr<Batch>> spare;
+    uint32_t running = 0;
+    /* Range the ordered consumer is draining */
+    uint32_t current = 0;
+    /* Batches in the output deques of ranges */
+    uint32_t buffered = 0;
+
+    bool take(uint32_t worker, uint32_t& range);
+    void run(uint32_t worker);
+    void scan(uint32_t range);
+};
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <memory>
+
+#include "eggshell/executor/operator.hpp"
+
+/* Narrows the columns a batch carries to the ones selected */
+class ProjectOperator : public Operator {
+   public:
+    ProjectOperator(std::unique_ptr<Operator> child, ColumnSet columns);
+
+    bool next(Batch& batch) override;
+
+   private:
+    std::unique_ptr<Operator> child;
+    ColumnSet columns;
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class OutputFormat { text, csv, tsv, binary };
+
+/* Format called text, csv, tsv or binary, false for any other name */
+bool parse_output_format(std::string_view name, OutputFormat& format);
+
+/*
+ * Where results go. Values are formatted into one reusable buffer, integers
+ * and reals through std::to_chars, and the buffer reaches the file in one
+ * fwrite when it fills or is flushed rather than in a stream call per value.
+ *
+ * text    (1, alice, a@x)
+ * csv     1,alice,a@x, quoted when a value holds , " or a line break
+ * tsv     1<tab>alice<tab>a@x, with tabs, line breaks and \ escaped
+ * binary  frames of a kind byte, R for a row and M for a message, then the
+ *         payload length as a uint32. A row's payload is a uint16 count of
+ *         values, each a tag byte then 0 null, 1 an int64, 2 a double or
+ *         3 a uint32 length and the bytes. Integers are in host order.
+ */
+class ResultSink {
+   public:
+    static constexpr size_t BUFFER_SIZE = 1 << 16;
+
+    OutputFormat format;
+    /* Rows written since the sink was created */
+    uint64_t rows = 0;
+
+    ResultSink(FILE* file, OutputFormat format = OutputFormat::text);
+    /* Appends to target instead, as for a response being built */
+    ResultSink(std::string& target, OutputFormat format = OutputFormat::text);
+    ~ResultSink();
+
+    void begin_row();
+    void value(uint64_t value);
+    void value(double value);
+    void value(std::string_view value);
+    void null();
+    void end_row();
+
+    /* Status text such as "Executed.\n", a frame of its own in binary */
+    void message(std::string_view text);
+
+    /* Hands the buffered bytes to the file */
+    void flush();
+
+   private:
+    FILE* file;
+    std::string* target = nullptr;
+    std::vector<char> buffer;
+    size_t used = 0;
+    /* Values so far in the row being written */
+    uint32_t values = 0;
+    bool in_row = false;
+    /* Start of the binary row being written, kept until it is complete */
+    size_t row_start = 0;
+
+    char* reserve(size_t size);
+    void append(std::string_view bytes);
+    void separator();
+};
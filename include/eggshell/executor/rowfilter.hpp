@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "eggshell/storage/row.hpp"
+
+/*
+Compares the first length bytes of a and b, 16 at a time where SSE2 is
+available. Both may be read up to length rounded up to a multiple of 16.
+*/
+inline bool bytes_equal(const char* a, const char* b, uint32_t length) {
+#if defined(__SSE2__)
+    for (; length >= 16; a += 16, b += 16, length -= 16) {
+        __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)a),
+                                    _mm_loadu_si128((const __m128i*)b));
+        if (_mm_movemask_epi8(eq) != 0xffff) {
+            return false;
+        }
+    }
+    if (length == 0) {
+        return true;
+    }
+    uint32_t mask = (1u << length) - 1;
+    __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)a),
+                                _mm_loadu_si128((const __m128i*)b));
+    return (_mm_movemask_epi8(eq) & mask) == mask;
+#else
+    return memcmp(a, b, length) == 0;
+#endif
+}
+
+/*
+ * WHERE predicate compiled against the serialized row layout, evaluated on
+ * cell bytes before anything is copied out. String columns are zero padded,
+ * so equality compares the value and its terminator and a prefix compares
+ * the value alone. Over-reads stay inside the row: the column is followed
+ * by the rest of the row or ends on a multiple of 16.
+ */
+class RowFilter {
+   public:
+    /* Matches every row */
+    RowFilter();
+
+    static RowFilter key_range(uint32_t key_min, uint32_t key_max);
+
+    /* Requires value to fit the column */
+    static RowFilter column(Column column, std::string_view value,
+                            bool prefix);
+
+    bool matches(uint32_t key, const char* value) const {
+        switch (kind) {
+            case Kind::all:
+                return true;
+            case Kind::key_range:
+                return key - key_min <= key_max - key_min;
+            case Kind::bytes:
+                return bytes_equal(value + offset, pattern, length);
+        }
+        return false;
+    }
+
+   private:
+    enum class Kind { all, key_range, bytes };
+
+    Kind kind;
+    uint32_t key_min;
+    uint32_t key_max;
+    uint32_t offset;
+    uint32_t length;
+    /* The value, zero padded up to a whole number of 16 byte loads */
+    alignas(16) char pattern[Row::COLUMN_EMAIL_SIZE + 1 + 16];
+};
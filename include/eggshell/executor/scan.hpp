@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+
+#include "eggshell/executor/operator.hpp"
+#include "eggshell/executor/rowfilter.hpp"
+#include "eggshell/storage/cursor.hpp"
+#include "eggshell/storage/table.hpp"
+
+/*
+Rows in key order from cursor up to and including key_max, with only the
+given columns copied out. A full scan starts at table.start() and runs to
+UINT32_MAX; a key-range scan starts at lower_bound or at a position. A
+pushed down filter runs on the cell bytes, so rows it rejects are never
+copied. The scan stops once max_rows rows have matched, so a LIMIT does not
+read the leaves after its last row.
+*/
+class ScanOperator : public Operator {
+   public:
+    ScanOperator(Table& table, Cursor cursor, uint32_t key_max,
+                 ColumnSet columns, const RowFilter& filter = RowFilter(),
+                uint32_t max_rows = UINT32_MAX);
+
+    bool next(Batch& batch) override;
+
+   private:
+    Table& table;
+    Cursor cursor;
+    uint32_t key_max;
+    ColumnSet columns;
+    RowFilter filter;
+    uint32_t max_rows;
+
+    void copy(Batch& batch, const char* value);
+};
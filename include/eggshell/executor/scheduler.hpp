@@ -0,0 +1,102 @@
+#pragma once
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "eggshell/executor/task.hpp"
+#include "eggshell/executor/threadpool.hpp"
+
+class IoRing;
+
+/*
+ * Runs coroutines on a few threads and completes their reads without
+ * blocking any of them. A coroutine waiting for a read is parked; the
+ * threads resume other coroutines meanwhile, and a completion thread puts
+ * it back in the run queue once the read is done. That keeps many cold
+ * queries in flight on few threads.
+ *
+ * Reads go through io_uring, or through a small pool of threads calling
+ * pread where io_uring is unavailable (old kernels, seccomp filters).
+ */
+class Scheduler {
+   public:
+    /* Reads in flight at once, beyond which read() waits for a slot */
+    static constexpr uint32_t QUEUE_DEPTH = 256;
+
+    Scheduler(uint32_t threads, bool use_io_uring = true);
+    ~Scheduler();
+
+    /* Whether reads go through io_uring */
+    bool io_uring() const;
+
+    /* Resumes handle on one of the threads */
+    void schedule(std::coroutine_handle<> handle);
+
+    /*
+    Reads size bytes at offset of fd into buffer, then stores the byte count
+    or -errno in result and schedules handle
+    */
+    void read(int fd, char* buffer, size_t size, off_t offset, ssize_t* result,
+              std::coroutine_handle<> handle);
+
+    /*
+    Runs tasks to completion on the threads, at most in_flight at once. One
+    run at a time per scheduler.
+    */
+    template <typename T>
+    void run(std::vector<Task<T>>& tasks, uint32_t in_flight);
+
+    /* Called by a finished task that nothing awaits */
+    void finished();
+
+   private:
+    std::vector<std::thread> threads;
+    std::deque<std::coroutine_handle<>> queue;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    /* Tasks of run() still to start, and how many are running */
+    std::deque<std::coroutine_handle<>> pending;
+    uint32_t running = 0;
+    std::condition_variable idle;
+
+    std::unique_ptr<IoRing> ring;
+    /* Fallback when there is no ring */
+    std::unique_ptr<ThreadPool> readers;
+
+    void work();
+    void start(std::deque<std::coroutine_handle<>> tasks, uint32_t in_flight);
+};
+
+template <typename T>
+std::coroutine_handle<> Task<T>::promise_type::FinalAwaiter::await_suspend(
+    std::coroutine_handle<promise_type> handle) noexcept {
+    promise_type& promise = handle.promise();
+    if (promise.continuation) {
+        return promise.continuation;
+    }
+    if (promise.scheduler) {
+        promise.scheduler->finished();
+    }
+    return std::noop_coroutine();
+}
+
+template <typename T>
+void Scheduler::run(std::vector<Task<T>>& tasks, uint32_t in_flight) {
+    std::deque<std::coroutine_handle<>> handles;
+    for (Task<T>& task : tasks) {
+        task.handle.promise().scheduler = this;
+        handles.push_back(task.handle);
+    }
+    start(std::move(handles), in_flight);
+}
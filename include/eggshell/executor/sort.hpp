@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "eggshell/executor/operator.hpp"
+
+/*
+Rows of its child sorted on one column, ties broken by id. With a limit
+whose rows fit in memory_budget it keeps only the best limit rows in a
+bounded heap (top-k). Otherwise rows are buffered up to memory_budget,
+each full buffer is sorted and spilled as a run to a temporary file, and
+the runs are k-way merged on the way out.
+*/
+class SortOperator : public Operator {
+   public:
+    SortOperator(std::unique_ptr<Operator> child, Column column,
+                 bool descending, uint32_t limit, uint64_t memory_budget);
+    ~SortOperator() override;
+
+    bool next(Batch& batch) override;
+
+    /* Runs spilled to disk, 0 when the sort stayed in memory */
+    uint32_t runs() const;
+
+   private:
+    /* A spilled run, read back a block of records at a time */
+    struct Run {
+        FILE* file;
+        uint32_t rows_left;
+        /* Slice of records the run is read into, block_rows records long */
+        char* block = nullptr;
+        uint32_t block_rows = 0;
+        uint32_t position = 0;
+        uint32_t filled = 0;
+    };
+
+    std::unique_ptr<Operator> child;
+    Column column;
+    bool descending;
+    uint32_t limit;
+    uint64_t memory_budget;
+
+    /* Records hold id, then each present string column at full stride */
+    ColumnSet columns = 0;
+    uint32_t record_size = 0;
+    uint32_t username_offset = 0;
+    uint32_t email_offset = 0;
+
+    /* In the statement's arena, like the operator itself */
+    ArenaVector<char> records;
+    /* Row being weighed against the worst of the top-k */
+    ArenaVector<char> candidate;
+    /* Record indexes, a max-heap on the sort order while taking top-k */
+    ArenaVector<uint32_t> order;
+    uint32_t capacity = 0;
+    bool top_k = false;
+    std::vector<Run> spilled;
+    /* Indexes into spilled, a min-heap on each run's current record */
+    std::vector<uint32_t> merge;
+
+    bool built = false;
+    /* Rows handed out so far */
+    uint32_t emitted = 0;
+
+    void layout(ColumnSet child_columns);
+    char* record(uint32_t index);
+    void write(char* record, const Batch& batch, uint32_t row) const;
+    void add(const Batch& batch, uint32_t row);
+    void spill();
+    void build(Batch& batch);
+    bool less(const char* a, const char* b) const;
+    const char* current(const Run& run) const;
+    bool advance(Run& run);
+    void emit(Batch& batch, const char* record);
+};
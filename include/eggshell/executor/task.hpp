@@ -0,0 +1,102 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+class Scheduler;
+
+/*
+ * Coroutine producing a T. A task starts suspended and runs when awaited,
+ * resuming its awaiter when it finishes, or when handed to
+ * Scheduler::run. It may suspend on I/O any number of times in between,
+ * and resume on a different thread each time.
+ */
+template <typename T>
+class Task {
+   public:
+    struct promise_type {
+        std::optional<T> value;
+        /* Awaiting coroutine, resumed when this one finishes */
+        std::coroutine_handle<> continuation;
+        /* Set by Scheduler::run for a task nothing awaits */
+        Scheduler* scheduler = nullptr;
+
+        Task get_return_object() {
+            using Handle = std::coroutine_handle<promise_type>;
+            return Task{Handle::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        struct FinalAwaiter {
+            bool await_ready() noexcept {
+                return false;
+            }
+
+            std::coroutine_handle<> await_suspend(
+                std::coroutine_handle<promise_type> handle) noexcept;
+
+            void await_resume() noexcept {
+            }
+        };
+
+        FinalAwaiter final_suspend() noexcept {
+            return {};
+        }
+
+        void return_value(T result) {
+            value = std::move(result);
+        }
+
+        /* Storage errors exit, anything else is a bug */
+        void unhandled_exception() {
+            std::terminate();
+        }
+    };
+
+    Task(Task&& other) : handle{std::exchange(other.handle, nullptr)} {
+    }
+
+    Task& operator=(Task&& other) {
+        std::swap(handle, other.handle);
+        return *this;
+    }
+
+    ~Task() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    bool await_ready() const {
+        return false;
+    }
+
+    /* Starts the task by symmetric transfer, no stack grows per await */
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+
+    T await_resume() {
+        return std::move(*handle.promise().value);
+    }
+
+    /* Result of a task Scheduler::run finished */
+    T& result() {
+        return *handle.promise().value;
+    }
+
+   private:
+    friend class Scheduler;
+
+    std::coroutine_handle<promise_type> handle;
+
+    explicit Task(std::coroutine_handle<promise_type> handle)
+        : handle{handle} {
+    }
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Fixed set of threads running submitted tasks in submission order */
+class ThreadPool {
+   public:
+    explicit ThreadPool(uint32_t threads);
+    ~ThreadPool();
+
+    /* Pool shared by all queries, one thread per hardware thread */
+    static ThreadPool& shared();
+
+    void submit(std::function<void()> task);
+
+    uint32_t size() const;
+
+   private:
+    std::vector<std::thread> threads;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    void run();
+};
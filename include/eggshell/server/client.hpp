@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "eggshell/server/protocol.hpp"
+
+/*
+ * Blocking connection to an eggshell-server. Requests may be pipelined:
+ * send several, then receive their responses in the same order.
+ */
+class Client {
+   public:
+    Client() = default;
+    Client(const Client&) = delete;
+    Client& operator=(const Client&) = delete;
+    ~Client();
+
+    /* false with errno set if the server cannot be reached */
+    bool connect(const Address& address);
+
+    /* false if the connection broke */
+    bool send(std::string_view statement);
+
+    /* Payload of the next response, false once the server closed */
+    bool receive(std::string& response);
+
+   private:
+    int fd = -1;
+    /* Bytes received past the last response handed out */
+    std::string input;
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/*
+ * Wire format between eggshell-server and its clients. Every message is a
+ * frame: a uint32 payload length in host order, then the payload.
+ *
+ * request   the text of one statement
+ * response  a status byte, then the statement's output as binary result
+ *           frames (see resultsink.hpp): its rows, then an M frame with
+ *           "Executed." or the error
+ *
+ * A client may send any number of requests before reading; responses come
+ * back in request order on the connection.
+ */
+
+/* Larger requests close the connection */
+constexpr uint32_t MAX_REQUEST_SIZE = 1 << 20;
+
+enum class ResponseStatus : uint8_t { ok, error };
+
+/* Appends a frame holding payload */
+void append_frame(std::string& out, std::string_view payload);
+
+/* Size of the whole frame at the start of bytes, 0 until it is complete */
+size_t frame_size(std::string_view bytes);
+
+/* Rows and the closing message of a response payload */
+struct Response {
+    ResponseStatus status;
+    uint32_t rows;
+    std::string message;
+};
+
+/* false if the payload is not a well formed response */
+bool parse_response(std::string_view payload, Response& response);
+
+/*
+ * Where a server listens or a client connects: unix:<path> for a Unix
+ * socket, otherwise <host>:<port> or <port> for TCP, host defaulting to
+ * 127.0.0.1
+ */
+struct Address {
+    bool unix_socket;
+    std::string path;
+    std::string host;
+    uint16_t port;
+};
+
+bool parse_address(std::string_view text, Address& address);
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "eggshell/storage/catalog.hpp"
+#include "eggshell/storage/wal.hpp"
+
+/* How far a replica trails its primary */
+struct ReplicationStatus {
+    /* Last record applied */
+    uint64_t lsn;
+    /* Bytes the primary logged that are not applied yet */
+    uint64_t bytes_behind;
+    /*
+    Time since the primary logged the last record applied, while there are
+    records waiting, 0 once caught up
+    */
+    double lag_ms;
+};
+
+/*
+ * Follower of a primary: tails the primary's write-ahead log, read from a
+ * shared directory, and applies each record to its own catalog, which is
+ * made read-only.
+ *
+ * Every CHECKPOINT_RECORDS records, and when it stops, the replica writes
+ * its tables back and then records the log offset and number applied in
+ * <database>.applied, where it resumes when it opens again. Records are
+ * upserts of whole rows or CREATEs, so those applied after the last
+ * checkpoint are simply applied again. A log that does not continue with
+ * the next number at the offset was replaced, and is applied from its
+ * start over whatever copy the replica was left with.
+ */
+class Replica {
+   public:
+    /* Records applied between checkpoints */
+    static constexpr uint64_t CHECKPOINT_RECORDS = 10000;
+
+    Replica(Catalog& catalog, std::string wal_filename);
+    ~Replica();
+
+    /* Applies the records logged since the last call, returns how many */
+    uint64_t poll();
+
+    /* Polls on a thread of its own, every interval while caught up */
+    void start(std::chrono::milliseconds interval);
+
+    /* Stops polling and checkpoints */
+    void stop();
+
+    ReplicationStatus status();
+
+    /* Writes the tables back, then the offset and number applied */
+    void checkpoint();
+
+    static std::string filename(const std::string& database);
+
+   private:
+    Catalog& catalog;
+    std::string wal_filename;
+    std::string applied_filename;
+    WalReader reader;
+    /* Whether the next record must follow the checkpoint's number */
+    bool resumed = false;
+    uint64_t since_checkpoint = 0;
+
+    /* Guards the fields below, read by status() */
+    std::mutex mutex;
+    uint64_t lsn = 0;
+    int64_t last_time = 0;
+    uint64_t offset = 0;
+
+    std::thread follower;
+    std::atomic<bool> stopping = false;
+    std::condition_variable wake;
+
+    void apply(const WalRecord& record);
+};
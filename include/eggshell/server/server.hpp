@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "eggshell/compiler/session.hpp"
+#include "eggshell/executor/resultsink.hpp"
+#include "eggshell/executor/threadpool.hpp"
+#include "eggshell/server/protocol.hpp"
+#include "eggshell/server/replica.hpp"
+#include "eggshell/storage/catalog.hpp"
+
+/*
+ * Serves the statements of many clients against one catalog. A single
+ * thread runs an epoll loop that accepts connections, reads requests and
+ * writes responses without blocking; statements run on a pool of workers,
+ * so the tables' shared mutexes let readers of different clients proceed
+ * together.
+ *
+ * Each connection has its own session and at most one task on the pool,
+ * which drains the requests queued so far in order. Pipelined requests are
+ * therefore answered in order, and the loop is woken once per drain rather
+ * than once per response.
+ *
+ * The request .replication answers with one row: the role, the last log
+ * record logged or applied, and for a replica the bytes and milliseconds
+ * it trails its primary by.
+ */
+class Server {
+   public:
+    /* replica is the follower applying to catalog, if it is one */
+    Server(Catalog& catalog, uint32_t workers, Replica* replica = nullptr);
+    ~Server();
+
+    /* Binds and listens, false with errno set if that fails */
+    bool listen(const Address& address);
+
+    /* Serves until stop is called */
+    void run();
+
+    /* Makes run return; safe from other threads and signal handlers */
+    void stop();
+
+    /* Connections accepted and requests answered so far */
+    uint64_t connections_accepted() const;
+    uint64_t requests_served() const;
+
+   private:
+    struct Connection {
+        int fd;
+        /* Bytes read and not yet split into requests */
+        std::string input;
+        /* Responses not yet written, from output_pos on */
+        std::string output;
+        size_t output_pos = 0;
+        bool writing = false;
+        /* Set by the loop on end of input, the fd closes once idle */
+        bool closing = false;
+        /* Events registered with epoll, none once closing and written */
+        uint32_t events = 0;
+
+        /* Guards the fields below, shared with the connection's task */
+        std::mutex mutex;
+        std::deque<std::string> requests;
+        std::string responses;
+        bool busy = false;
+
+        /* Only used by the task */
+        Session session;
+        std::string response;
+        ResultSink sink{response, OutputFormat::binary};
+    };
+
+    Catalog& catalog;
+    Replica* replica;
+    /* Reset first on destruction, so no task outlives the fds */
+    std::unique_ptr<ThreadPool> pool;
+    int epoll_fd;
+    int listen_fd = -1;
+    /* eventfd the workers and stop() wake the loop through */
+    int wake_fd;
+    std::map<int, std::shared_ptr<Connection>> connections;
+
+    std::mutex mutex;
+    /* Connections whose task finished since the loop last looked */
+    std::vector<std::shared_ptr<Connection>> ready;
+    /* Atomic rather than under mutex, stop() may run in a signal handler */
+    std::atomic<bool> stopping = false;
+
+    uint64_t accepted = 0;
+    std::atomic<uint64_t> served = 0;
+
+    void accept_all();
+    void read_all(const std::shared_ptr<Connection>& connection);
+    void write_all(Connection& connection);
+    /* Watches for input unless closing and for room while writing */
+    void update_events(Connection& connection);
+    /* Closes the fd if input ended and nothing is left to do */
+    void close_if_done(Connection& connection);
+    /* Task running the queued requests of a connection */
+    void drain(std::shared_ptr<Connection> connection);
+    /* Runs one request, appending its response frame to out */
+    void execute(Connection& connection, std::string_view input,
+                 std::string& out);
+    /* Writes the .replication row, false if there is no log */
+    bool replication(ResultSink& sink);
+    void wake();
+};
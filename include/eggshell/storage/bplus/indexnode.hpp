@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+
+/*
+ * Secondary index nodes. These share the common node header and the
+ * leaf/internal split of the table tree, but cells hold fixed-width byte keys
+ * whose width depends on the indexed column, so every accessor takes the key
+ * size of the tree it belongs to.
+ */
+namespace IndexNode {
+
+extern const uint32_t INDEX_NODE_NUM_CELLS_SIZE;
+extern const uint32_t INDEX_NODE_NUM_CELLS_OFFSET;
+extern const uint32_t INDEX_NODE_LINK_SIZE;
+extern const uint32_t INDEX_NODE_LINK_OFFSET;
+extern const uint32_t INDEX_NODE_HEADER_SIZE;
+extern const uint32_t INDEX_NODE_CHILD_SIZE;
+
+/* Number of cells in a leaf, number of keys in an internal node */
+uint32_t* num_cells(char* node);
+
+/* Next leaf for leaves, right child for internal nodes */
+uint32_t* next_leaf(char* node);
+uint32_t* right_child(char* node);
+
+/*
+ * Both maxima leave room for one extra cell, so a node can overflow by one
+ * before it is split
+ */
+uint32_t leaf_max_cells(uint32_t key_size);
+uint32_t internal_max_cells(uint32_t key_size);
+
+char* leaf_key(char* node, uint32_t key_size, uint32_t cell_num);
+
+/* Raw cell address, child pointer followed by key */
+char* internal_cell(char* node, uint32_t key_size, uint32_t cell_num);
+
+/* Child pointer, child_num == number of keys is the right child */
+uint32_t* child(char* node, uint32_t key_size, uint32_t child_num);
+char* internal_key(char* node, uint32_t key_size, uint32_t key_num);
+
+void init_leaf(char* node);
+void init_internal(char* node);
+
+/* Index of the first cell whose key is >= key */
+uint32_t leaf_lower_bound(char* node, uint32_t key_size, const char* key);
+
+/* Index of the child which should contain the given key */
+uint32_t find_child(char* node, uint32_t key_size, const char* key);
+
+}  // namespace IndexNode
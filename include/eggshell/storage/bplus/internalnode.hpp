@@ -13,6 +13,8 @@ extern const uint32_t INTERNAL_NODE_NUM_KEYS_SIZE;
 extern const uint32_t INTERNAL_NODE_NUM_KEYS_OFFSET;
 extern const uint32_t INTERNAL_NODE_RIGHT_CHILD_SIZE;
 extern const uint32_t INTERNAL_NODE_RIGHT_CHILD_OFFSET;
+extern const uint32_t INTERNAL_NODE_RIGHT_COUNT_SIZE;
+extern const uint32_t INTERNAL_NODE_RIGHT_COUNT_OFFSET;
 extern const uint32_t INTERNAL_NODE_HEADER_SIZE;
 
 /*
@@ -20,6 +22,7 @@ extern const uint32_t INTERNAL_NODE_HEADER_SIZE;
  */
 extern const uint32_t INTERNAL_NODE_KEY_SIZE;
 extern const uint32_t INTERNAL_NODE_CHILD_SIZE;
+extern const uint32_t INTERNAL_NODE_COUNT_SIZE;
 extern const uint32_t INTERNAL_NODE_CELL_SIZE;
 extern const uint32_t INVALID_PAGE_NUM;
 
@@ -40,6 +43,9 @@ void init(char* node);
 
 uint32_t* child(char* node, uint32_t child_num);
 
+/* Number of cells in the subtree of child_num, including the right child */
+uint32_t* child_count(char* node, uint32_t child_num);
+
 uint32_t find_child(char* node, uint32_t key);
 
 void update_internal_node_key(char* node, uint32_t old_key, uint32_t new_key);
@@ -31,4 +31,13 @@ uint32_t get_node_max_key(char* node);
 uint32_t get_node_max_key(Pager& pager, char* node);
 
 void create_new_root(Table& table, uint32_t right_child_page_num);
+
+/* Number of cells under node, read from its own header or child counts */
+uint32_t subtree_count(char* node);
+
+/*
+Recompute the count stored for page_num in its parent, and so on up to the
+root, after the subtree at page_num changed size
+*/
+void update_counts(Table& table, uint32_t page_num);
 };  // namespace Node
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "eggshell/storage/partition.hpp"
+#include "eggshell/storage/table.hpp"
+#include "eggshell/storage/wal.hpp"
+
+/*
+ * Tables of one database. The file it is opened on holds the main table;
+ * CREATE TABLE adds tables stored next to it as <file>.<name>.tbl, listed
+ * one per line in <file>.catalog. A partitioned table is listed with its
+ * spec and keeps its shards in <file>.<name>.<i>.tbl. A name not in the
+ * catalog refers to the main table, as every name did before there was
+ * more than one.
+ *
+ * With a write-ahead log every change to the tables is also appended to
+ * <file>.wal, for replicas to follow. Every table is opened with the
+ * pager options of the main one, and tables created while it is
+ * compressed are compressed too.
+ */
+class Catalog {
+   public:
+    /* Set on a replica, whose tables only change through its log */
+    bool read_only = false;
+
+    /* Opens the log if wal is set, or if the database already has one */
+    Catalog(std::string filename, Engine engine = Engine::btree,
+            bool wal = false, const PagerOptions& options = {});
+
+    /* Table called name, the main table if there is none */
+    Table& table(std::string_view name);
+
+    /* Partitioned table called name, nullptr if there is none */
+    PartitionedTable* partitioned(std::string_view name);
+
+    bool contains(std::string_view name);
+
+    /* Creates an empty table, false if the name is taken */
+    bool create(std::string_view name, const PartitionSpec& spec = {});
+
+    /* Main table first, then the others by name, shards included */
+    std::vector<Table*> tables();
+
+    std::vector<std::string> names();
+
+    /* Records the cached pages of every table, see Table::save_warm_set */
+    void save_warm_sets();
+
+    /* The write-ahead log, nullptr if the database keeps none */
+    Wal* wal();
+
+    static std::string table_filename(const std::string& filename,
+                                      std::string_view name);
+
+   private:
+    std::string filename;
+    /* Before the tables, which log to it until they are closed */
+    std::unique_ptr<Wal> log;
+    std::unique_ptr<Table> main;
+    std::map<std::string, std::unique_ptr<Table>, std::less<>> named;
+    std::map<std::string, std::unique_ptr<PartitionedTable>, std::less<>>
+        partitioned_tables;
+    std::mutex mutex;
+
+    /* Options of the main table's pager, compress as it turned out */
+    PagerOptions options() const;
+
+    /* Points a table's changes at the log under name */
+    void attach(Table& table, std::string_view name);
+
+    /* Rewrites the table list, through a rename so it is never torn */
+    void save();
+};
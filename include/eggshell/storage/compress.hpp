@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+/*
+ * Byte oriented LZ77 in the style of LZ4 blocks, with no dependency and no
+ * state between calls. A block is a run of sequences, each a token byte
+ * holding a literal count and a match length, the literals, then a 16 bit
+ * offset back into the output and the match length beyond the minimum; the
+ * last sequence has literals only. Runs of the zero padding in rows become
+ * overlapping matches one byte back.
+ */
+namespace Compression {
+
+/* Compresses size bytes into out, 0 if the result would not fit capacity */
+uint32_t compress(const char* in, uint32_t size, char* out,
+                  uint32_t capacity);
+
+/* Decompresses a block that must expand to exactly out_size bytes */
+bool decompress(const char* in, uint32_t size, char* out, uint32_t out_size);
+
+}  // namespace Compression
@@ -2,18 +2,22 @@
 
 #include <cstdint>
 #include <fstream>
+#include <memory>
 #include <mutex>
 #include <string>
 
 #include "eggshell/storage/table.hpp"
 
 struct Table;
+class LsmIterator;
 
 struct Cursor {
     Table& table;
     uint32_t page_num;
     uint32_t cell_num;
     bool end_of_table;
+    /* Set on tables using the LSM engine, page_num and cell_num are unused */
+    std::shared_ptr<LsmIterator> lsm;
 
     Cursor(Table& table, uint32_t page_num, uint32_t cell_num,
            bool end_of_table);
@@ -22,5 +26,9 @@ struct Cursor {
            bool end_of_table) = delete;
 
     char* value();
+    uint32_t key();
     void advance();
+
+    /* Whether the cursor is on a row with the given key */
+    bool at_key(uint32_t key);
 };
\ No newline at end of file
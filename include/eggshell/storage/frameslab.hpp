@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/*
+ * Page frames carved out of large regions mapped aligned to a page, so
+ * they can be read and written with O_DIRECT, and freed to a list for the
+ * next page rather than back to the system. With huge pages a region is
+ * one 2 MiB huge page if the kernel has any reserved, else it is mapped
+ * normally and the kernel asked to back it with transparent huge pages.
+ */
+class FrameSlab {
+   public:
+    /* One huge page on x86-64 */
+    static const size_t REGION_SIZE = 2 << 20;
+
+    FrameSlab(size_t frame_size, bool huge_pages = false);
+    ~FrameSlab();
+
+    FrameSlab(const FrameSlab&) = delete;
+    FrameSlab& operator=(const FrameSlab&) = delete;
+
+    /* A frame of frame_size bytes; its contents are left as they were */
+    char* allocate();
+
+    void free(char* frame);
+
+    /* Bytes mapped so far */
+    size_t mapped();
+
+    /* Whether any region got reserved huge pages */
+    bool huge();
+
+   private:
+    size_t frame_size;
+    bool huge_pages;
+    std::mutex mutex;
+    std::vector<void*> regions;
+    /* Freed frames, each holding a pointer to the next */
+    char* free_list = nullptr;
+    /* Frames of the newest region not yet handed out */
+    char* next = nullptr;
+    char* end = nullptr;
+    bool got_huge = false;
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+
+/*
+ * Pages of an extendible hash index. Page 0 is the header, which lists the
+ * directory pages; directory pages hold bucket page numbers; buckets hold
+ * fixed-width (key, value) entries and chain to overflow pages once their
+ * entries can no longer be told apart by splitting.
+ */
+namespace Bucket {
+
+extern const uint32_t HEADER_GLOBAL_DEPTH_OFFSET;
+extern const uint32_t HEADER_NUM_DIRECTORY_PAGES_OFFSET;
+extern const uint32_t HEADER_DIRECTORY_PAGES_OFFSET;
+extern const uint32_t HEADER_MAX_DIRECTORY_PAGES;
+
+extern const uint32_t DIRECTORY_ENTRIES_PER_PAGE;
+
+extern const uint32_t BUCKET_LOCAL_DEPTH_OFFSET;
+extern const uint32_t BUCKET_NUM_ENTRIES_OFFSET;
+extern const uint32_t BUCKET_OVERFLOW_OFFSET;
+extern const uint32_t BUCKET_HEADER_SIZE;
+extern const uint32_t VALUE_SIZE;
+
+uint32_t* global_depth(char* header);
+uint32_t* num_directory_pages(char* header);
+uint32_t* directory_page(char* header, uint32_t num);
+
+uint32_t* local_depth(char* bucket);
+uint32_t* num_entries(char* bucket);
+/* 0 when the bucket has no overflow page */
+uint32_t* overflow(char* bucket);
+
+uint32_t max_entries(uint32_t key_size);
+char* entry_key(char* bucket, uint32_t key_size, uint32_t entry_num);
+uint32_t* entry_value(char* bucket, uint32_t key_size, uint32_t entry_num);
+
+void init(char* bucket, uint32_t depth);
+
+}  // namespace Bucket
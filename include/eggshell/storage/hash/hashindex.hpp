@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "eggshell/storage/pager.hpp"
+#include "eggshell/storage/row.hpp"
+
+/*
+ * Disk-resident extendible hash index, an alternative to the B+ tree for
+ * equality lookups. A lookup reads the directory page and the bucket page
+ * however many entries there are.
+ *
+ * On id the value is the leaf page holding the row, so a point lookup is two
+ * hash pages and the leaf. On other columns the value is the primary key.
+ */
+struct HashIndex {
+    /* Keeps the directory listable from the single header page */
+    static const uint32_t MAX_GLOBAL_DEPTH = 19;
+
+    Pager pager;
+    Column column;
+    uint32_t key_size;
+    /* Keys on id are unique, inserting an existing key replaces its value */
+    bool unique;
+
+    HashIndex(std::string filename, Column column);
+
+    ~HashIndex();
+
+    static std::string filename(const std::string& table_filename,
+                                Column column);
+
+    /* Key bytes of row for this index, key_size long */
+    void make_key(const Row& row, char* key) const;
+    void make_key(const std::string& value, char* key) const;
+
+    void insert(const char* key, uint32_t value);
+
+    void remove(const char* key, uint32_t value);
+
+    void find(const char* key, std::vector<uint32_t>& values);
+
+   private:
+    static uint32_t hash(const char* key, uint32_t key_size);
+
+    uint32_t* directory_entry(char* header, uint32_t index);
+
+    uint32_t bucket_for(uint32_t hash);
+
+    void append(uint32_t bucket_page_num, const char* key, uint32_t value);
+
+    void double_directory();
+
+    void split(uint32_t bucket_page_num, uint32_t hash);
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "eggshell/storage/pager.hpp"
+#include "eggshell/storage/row.hpp"
+
+/*
+ * Secondary B+ tree over a non-key column, stored in its own file next to
+ * the table. Keys are the zero padded column value followed by the big-endian
+ * primary key, so a single memcmp orders them and duplicate column values
+ * stay unique. The tree has no values; the primary key inside the key makes
+ * every index covering for id.
+ */
+struct Index {
+    Pager pager;
+    Column column;
+    uint32_t key_size;
+    uint32_t root_page_num;
+
+    Index(std::string filename, Column column);
+
+    ~Index();
+
+    static std::string filename(const std::string& table_filename,
+                                Column column);
+
+    void insert(const Row& row);
+
+    void remove(const Row& row);
+
+    /*
+    Appends the primary keys of rows whose column equals value, or starts
+    with it when prefix is set, in column order
+    */
+    void find(const std::string& value, bool prefix,
+              std::vector<uint32_t>& keys);
+
+   private:
+    void make_key(const char* value, uint32_t primary_key, char* key) const;
+
+    bool insert_into(uint32_t page_num, const char* key, char* split_key,
+                     uint32_t& split_page_num);
+
+    bool split_leaf(char* node, char* split_key, uint32_t& split_page_num);
+
+    bool split_internal(char* node, char* split_key,
+                        uint32_t& split_page_num);
+
+    void split_root(const char* split_key, uint32_t split_page_num);
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <sys/types.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/*
+ * Minimal io_uring for reads, on the raw system calls since liburing is not
+ * a dependency. Submissions come from any thread; one thread reaps
+ * completions and hands each result to the callback of its read.
+ */
+class IoRing {
+   public:
+    /* Called with the byte count or -errno of a read */
+    using Callback = std::function<void(ssize_t)>;
+
+    /* ok() is false if the kernel refuses a ring */
+    explicit IoRing(uint32_t entries);
+    ~IoRing();
+
+    bool ok() const;
+
+    /* Queues a read, waiting while entries reads are already in flight */
+    void read(int fd, char* buffer, size_t size, off_t offset,
+              Callback callback);
+
+   private:
+    int fd = -1;
+    uint32_t entries;
+
+    /* Submission ring, its index array and the entries */
+    void* sq_ring = nullptr;
+    size_t sq_ring_size = 0;
+    uint32_t* sq_head;
+    uint32_t* sq_tail;
+    uint32_t* sq_mask;
+    uint32_t* sq_array;
+    struct io_uring_sqe* sqes = nullptr;
+    size_t sqes_size = 0;
+
+    /* Completion ring, mapped separately unless the kernel shares one */
+    void* cq_ring = nullptr;
+    size_t cq_ring_size = 0;
+    uint32_t* cq_head;
+    uint32_t* cq_tail;
+    uint32_t* cq_mask;
+    struct io_uring_cqe* cqes;
+
+    std::mutex mutex;
+    std::condition_variable slot_free;
+    uint32_t in_flight = 0;
+    std::thread reaper;
+
+    /* Fills and submits an entry; caller holds mutex */
+    void submit(uint8_t opcode, int file, char* buffer, size_t size,
+                off_t offset, uint64_t user_data);
+    void reap();
+};
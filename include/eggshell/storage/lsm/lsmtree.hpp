@@ -0,0 +1,151 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "eggshell/storage/lsm/memtable.hpp"
+#include "eggshell/storage/lsm/sstable.hpp"
+
+/* One sorted input of a merge: the memtable or a run */
+struct LsmSource {
+    virtual ~LsmSource() = default;
+    virtual bool valid() = 0;
+    virtual uint32_t key() = 0;
+    virtual char* value() = 0;
+    virtual void next() = 0;
+};
+
+/* Merges sources given newest first; on equal keys the newest one wins */
+class MergeIterator {
+   public:
+    MergeIterator(std::vector<std::unique_ptr<LsmSource>> sources);
+
+    bool valid() const;
+    uint32_t key();
+    char* value();
+    void next();
+
+   private:
+    std::vector<std::unique_ptr<LsmSource>> sources;
+    /* Source holding the current key, -1 past the end */
+    int32_t current;
+
+    void settle();
+};
+
+class LsmTree;
+
+/*
+Cursor state over an LSM table. Built from find(), it holds the result of a
+point lookup through the bloom filters and only opens the merge of every
+run once the caller moves past it.
+*/
+class LsmIterator {
+   public:
+    LsmIterator(LsmTree& tree, uint32_t key, bool point_lookup);
+
+    bool valid();
+    uint32_t key();
+    char* value();
+    void next();
+
+    /* Whether the iterator is on key, without opening the merge */
+    bool at(uint32_t key);
+
+   private:
+    LsmTree& tree;
+    uint32_t seek_key;
+    std::unique_ptr<char[]> point;
+    bool found;
+    std::optional<MergeIterator> merge;
+
+    void open();
+};
+
+/*
+Log-structured storage for a table: writes go to a skiplist memtable backed
+by a log, full memtables are written out as runs and a background thread
+merges a level's runs into the next level once it holds LEVEL_MAX_RUNS.
+Everything lives in a directory next to the table file:
+
+  MANIFEST      one "<level> <file>" line per run, newest first
+  memtable.log  (key, row) records not yet in a run
+  <n>.sst       runs
+*/
+class LsmTree {
+   public:
+    static constexpr size_t DEFAULT_MEMTABLE_LIMIT = 4 << 20;
+    static constexpr uint32_t LEVEL_MAX_RUNS = 4;
+
+    const std::string directory;
+    /*
+    Whether each put pushes its log record to the file. Off, records wait
+    in the stream's buffer until sync, for a batch committed as one.
+    */
+    bool sync_puts = true;
+
+    static std::string dirname(const std::string& table_filename);
+
+    LsmTree(std::string directory,
+            size_t memtable_limit = DEFAULT_MEMTABLE_LIMIT);
+
+    ~LsmTree();
+
+    void put(uint32_t key, const char* value);
+
+    bool get(uint32_t key, char* value);
+
+    /* Iterator on the first key >= key */
+    std::shared_ptr<LsmIterator> seek(uint32_t key);
+
+    /* Iterator on key, reading the runs only through a point lookup */
+    std::shared_ptr<LsmIterator> find(uint32_t key);
+
+    /* Writes the memtable out as a level 0 run */
+    void flush();
+
+    /* Pushes buffered log records to the file */
+    void sync();
+
+    /* Blocks until no level is waiting for compaction */
+    void wait_for_compaction();
+
+    /* Number of runs per level */
+    std::vector<uint32_t> shape();
+
+    uint32_t memtable_entries();
+
+   private:
+    friend class LsmIterator;
+
+    size_t memtable_limit;
+    std::mutex mutex;
+    std::condition_variable compaction_needed;
+    std::condition_variable compaction_done;
+    /* Shared with open iterators, which keep a flushed memtable alive */
+    std::shared_ptr<MemTable> memtable;
+    /* Runs of each level, newest first */
+    std::vector<std::vector<std::shared_ptr<SSTable>>> levels;
+    std::ofstream log;
+    uint32_t next_file_num;
+    bool compacting;
+    bool stopping;
+    std::thread compactor;
+
+    std::vector<std::unique_ptr<LsmSource>> sources(uint32_t key);
+    std::string run_filename(uint32_t file_num) const;
+    void write_manifest();
+    /* Level with too many runs, -1 if none; caller holds mutex */
+    int32_t full_level() const;
+    void compact_level(uint32_t level,
+                       std::vector<std::shared_ptr<SSTable>> runs);
+    void run_compactor();
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "eggshell/storage/row.hpp"
+
+/*
+ * In-memory write buffer of the LSM engine: a skiplist from key to
+ * serialized row. Writing an existing key overwrites its value in place.
+ */
+class MemTable {
+   public:
+    static const uint32_t MAX_LEVEL = 12;
+
+    struct Node {
+        uint32_t key;
+        /* Row::SIZE, spelled out because it is not a constant expression */
+        char value[sizeof(uint32_t) + Row::COLUMN_USERNAME_SIZE + 1 +
+                   Row::COLUMN_EMAIL_SIZE + 1];
+        Node* next[MAX_LEVEL];
+    };
+
+    MemTable();
+
+    void put(uint32_t key, const char* value);
+
+    bool get(uint32_t key, char* value);
+
+    /* First node with a key >= key, nullptr past the end */
+    Node* seek(uint32_t key);
+
+    size_t size_bytes() const;
+
+    uint32_t num_entries() const;
+
+   private:
+    std::vector<std::unique_ptr<Node>> nodes;
+    Node head;
+    uint32_t level;
+    std::minstd_rand rng;
+};
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ * Immutable sorted run of the LSM engine. Layout:
+ *
+ *   data blocks   PAGE_SIZE each, a u32 entry count then (key, row) entries
+ *   block index   (first key, last key) per block
+ *   bloom filter  bit array over all keys
+ *   footer        num_blocks, num_entries, bloom bytes, bloom hashes, magic
+ */
+namespace SSTableFormat {
+
+extern const uint32_t BLOCK_NUM_ENTRIES_SIZE;
+extern const uint32_t ENTRY_KEY_SIZE;
+extern const uint32_t ENTRY_SIZE;
+extern const uint32_t BLOCK_MAX_ENTRIES;
+extern const uint32_t FOOTER_SIZE;
+extern const uint32_t MAGIC;
+
+uint32_t* num_entries(char* block);
+uint32_t* key(char* block, uint32_t entry_num);
+char* value(char* block, uint32_t entry_num);
+
+}  // namespace SSTableFormat
+
+struct BloomFilter {
+    std::vector<uint8_t> bits;
+    uint32_t num_hashes = 0;
+
+    BloomFilter() = default;
+
+    /* About 10 bits per key, roughly 1% false positives */
+    BloomFilter(uint32_t num_keys);
+
+    void add(uint32_t key);
+
+    bool may_contain(uint32_t key) const;
+};
+
+class SSTableWriter {
+   public:
+    SSTableWriter(std::string path, uint32_t expected_entries);
+
+    /* Keys must be added in increasing order */
+    void add(uint32_t key, const char* value);
+
+    void finish();
+
+   private:
+    std::ofstream file;
+    std::unique_ptr<char[]> block;
+    std::vector<std::pair<uint32_t, uint32_t>> index;
+    BloomFilter bloom;
+    uint32_t num_entries;
+
+    void write_block();
+};
+
+class SSTable {
+   public:
+    std::string path;
+    uint32_t level;
+    uint32_t num_entries;
+    /* Set once compacted away; the file goes when the last reader does */
+    bool obsolete = false;
+
+    SSTable(std::string path, uint32_t level);
+
+    ~SSTable();
+
+    bool get(uint32_t key, char* value);
+
+    uint32_t num_blocks() const;
+
+    /* First block whose last key is >= key, num_blocks() if none */
+    uint32_t find_block(uint32_t key) const;
+
+    void read_block(uint32_t block_num, char* block);
+
+    class Iterator {
+       public:
+        Iterator(std::shared_ptr<SSTable> table, uint32_t key);
+
+        bool valid() const;
+        uint32_t key();
+        char* value();
+        void next();
+
+       private:
+        std::shared_ptr<SSTable> table;
+        std::unique_ptr<char[]> block;
+        uint32_t block_num;
+        uint32_t entry_num;
+
+        void load(uint32_t block_num);
+    };
+
+   private:
+    std::ifstream file;
+    std::mutex file_mutex;
+    std::vector<std::pair<uint32_t, uint32_t>> index;
+    BloomFilter bloom;
+};
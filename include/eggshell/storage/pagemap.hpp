@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/* Where one page of a compressed file is stored */
+struct PageSlot {
+    uint64_t offset = 0;
+    /* Bytes stored, PAGE_SIZE for a page kept uncompressed, 0 if unwritten */
+    uint32_t size = 0;
+    /* Bytes reserved at offset, so the page can grow in place */
+    uint32_t capacity = 0;
+};
+
+/*
+ * Page map of a table file whose pages are compressed on write-back. Pages
+ * take variable sized slots, so their offsets are kept in <file>.pagemap:
+ * a u32 slot count, then offset, size and capacity per page. A page that
+ * outgrows its slot moves to the end of the file; the hole it leaves is
+ * reclaimed by VACUUM, which writes every page afresh.
+ */
+class PageMap {
+   public:
+    /* Capacities are rounded up to this, leaving room to grow */
+    static const uint32_t SLOT_ALIGNMENT = 128;
+
+    /* Indexed by page number */
+    std::vector<PageSlot> slots;
+    /* End of the last slot, where moved pages go */
+    uint64_t end = 0;
+
+    static std::string filename(const std::string& table_filename);
+
+    /* False if there is no map at filename */
+    bool load(const std::string& filename);
+
+    /* Rewrites the map, through a rename so it is never torn */
+    void save(const std::string& filename) const;
+
+    /* Whether page_num has been written to the file */
+    bool stored(uint32_t page_num) const;
+
+    /*
+    Slot to write a page of size bytes to: its current one if the page still
+    fits, else a new one at the end
+    */
+    const PageSlot& place(uint32_t page_num, uint32_t size);
+
+    /*
+    Compresses a page into stored, which holds PAGE_SIZE bytes, and returns
+    the bytes to write. Pages that do not shrink are copied as they are.
+    */
+    static uint32_t encode(const char* page, char* stored);
+
+    /* Expands size stored bytes into page, exiting on a corrupt page */
+    static void decode(const char* stored, uint32_t size, char* page);
+};
@@ -1,30 +1,163 @@
 #pragma once
 
+#include <sys/types.h>
+
+#include <atomic>
+#include <coroutine>
 #include <cstdint>
 #include <cstring>
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
+#include <vector>
+
+#include "eggshell/storage/frameslab.hpp"
+#include "eggshell/storage/pagemap.hpp"
+#include "eggshell/storage/warmset.hpp"
+
+class Scheduler;
+struct Pager;
+
+/*
+ * co_await pager.fetch(page_num, scheduler) resumes with the page cached,
+ * suspending for the read on a miss instead of blocking the thread
+ */
+struct PageFetch {
+    Pager& pager;
+    Scheduler& scheduler;
+    uint32_t page_num;
+    char* page = nullptr;
+    ssize_t result = 0;
+    /* Bytes read, fewer than a page if it is stored compressed */
+    uint32_t size = 0;
+    /* Pager::generation when the read went out */
+    uint64_t generation = 0;
+
+    bool await_ready();
+    void await_suspend(std::coroutine_handle<> handle);
+    char* await_resume();
+};
+
+/* How a pager opens its file, chosen when the database is opened */
+struct PagerOptions {
+    /* Compress the pages of a new file, see PageMap */
+    bool compress = false;
+    /*
+    Read and write whole pages with O_DIRECT, past the kernel page cache.
+    Falls back to buffered I/O for compressed files, whose slots are not
+    aligned, and where the filesystem refuses O_DIRECT.
+    */
+    bool direct_io = false;
+    /* Back page frames with huge pages */
+    bool huge_pages = false;
+    /*
+    Save the numbers of the cached pages when a table closes, and read them
+    back in the background when it opens again, see WarmSet
+    */
+    bool warm_restart = false;
+};
 
 struct Pager {
     const static size_t PAGE_SIZE = 4096;
-    const static size_t MAX_PAGES = 100;
+    const static size_t MAX_PAGES = 1 << 20;
 
     std::fstream file;
     uint32_t file_length;
     uint32_t num_pages;
-    char* pages[MAX_PAGES];
-    std::map<size_t, char*> previous_pages;
+    PagerOptions options;
+    /* Frames of the cached pages */
+    FrameSlab frames;
+    /* Grows with the highest page fetched so far */
+    std::vector<char*> pages;
+    /*
+    Image of each page as of its first fetch since the last flush, indexed
+    like pages, in frames of their own
+    */
+    std::vector<char*> previous_pages;
+    /* Number of get calls, for measuring page accesses per operation */
+    uint64_t fetches = 0;
+    /* Bytes read from the file, less than the pages read if compressed */
+    uint64_t bytes_read = 0;
+    /* Readers under a table's shared lock fetch pages concurrently */
+    std::mutex mutex;
 
-    Pager(std::string filename);
+    /* Read only descriptor of the file, for reads issued by fetch */
+    int read_fd;
+    /* Descriptor opened with O_DIRECT, -1 unless direct I/O is in use */
+    int direct_fd = -1;
+    /* Bumped by reopen, so reads of the old file are not cached */
+    uint64_t generation = 0;
+
+    /* Reads the pages passed to prefetch; they count towards bytes_read */
+    std::thread prefetcher;
+    std::atomic<bool> prefetch_stopped = false;
+    /* Pages the prefetcher put in the cache, not read by get first */
+    std::atomic<uint64_t> prefetched = 0;
+
+    /*
+    Slots of a file whose pages are compressed on write-back, nullptr for a
+    plain file of whole pages. Cached pages are never compressed.
+    */
+    std::unique_ptr<PageMap> map;
+    std::string map_filename;
+
+    /*
+    A file with a page map opens compressed; so does a new, empty file if
+    options.compress is set
+    */
+    Pager(std::string filename, const PagerOptions& options = {});
+
+    ~Pager();
 
     char* get(uint32_t page_num);
 
+    PageFetch fetch(uint32_t page_num, Scheduler& scheduler);
+
+    /* Whether get would return without reading the file */
+    bool cached(uint32_t page_num);
+
     uint32_t get_unused_page_num();
 
+    /*
+    Drops every cached page and opens filename again, after a new file was
+    renamed over it. read_fd keeps its number.
+    */
+    void reopen(const std::string& filename);
+
     void flush(uint32_t page_num);
 
+    /* Writes the page map after pages were flushed, if there is one */
+    void save_map();
+
     void log_transaction(uint32_t page_num, std::fstream& file);
+
+    /* Whether page_num is in the file; caller holds mutex */
+    bool stored(uint32_t page_num);
+
+    /* Reads a stored page into page; caller holds mutex */
+    void read(uint32_t page_num, char* page);
+
+    /* Loads the page map next to the file, or starts one if compress */
+    void open_map(bool compress);
+
+    /*
+    Reads the pages of set into the cache on a thread of its own, interior
+    nodes first. Each group goes in file order, pages close together in one
+    read. Pages that get or fetch read first are left as they are.
+    */
+    void prefetch(const WarmSet& set);
+
+    void wait_for_prefetch();
+
+    /* Stops prefetch between reads, before the cache is written back */
+    void stop_prefetch();
+
+    /* One group of prefetch; false once stopped or the file was reopened */
+    bool prefetch_group(const std::vector<uint32_t>& page_nums,
+                        uint64_t generation);
 };
\ No newline at end of file
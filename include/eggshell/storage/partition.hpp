@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "eggshell/storage/table.hpp"
+
+/* How CREATE TABLE ... PARTITIONS spreads ids over the shards */
+struct PartitionSpec {
+    /* 0 for a table that is not partitioned */
+    uint32_t partitions = 0;
+    /*
+    Hashed ids unless range, which gives shard i the ids from
+    i * range_width on, the last shard taking everything above
+    */
+    bool range = false;
+    uint32_t range_width = 0;
+};
+
+/*
+ * Table split by id into shards that are tables of their own, each with its
+ * own file, pager and lock. Writes to different shards never wait on each
+ * other; a point operation touches the one shard its key routes to, and a
+ * scan runs over every shard that can hold keys of its range.
+ */
+class PartitionedTable {
+   public:
+    static constexpr uint32_t MAX_PARTITIONS = 64;
+
+    PartitionSpec spec;
+    std::vector<std::unique_ptr<Table>> shards;
+
+    /* Opens shard i from <prefix>.<i>.tbl, creating it if create */
+    PartitionedTable(const std::string& prefix, const PartitionSpec& spec,
+                     bool create, const PagerOptions& options = {});
+
+    /* Shard holding key */
+    uint32_t partition(uint32_t key) const;
+
+    Table& shard(uint32_t key);
+
+    /* Shards that may hold keys in key_min..key_max, in shard order */
+    std::vector<Table*> shards_between(uint32_t key_min, uint32_t key_max);
+
+    static std::string shard_filename(const std::string& prefix,
+                                      uint32_t partition);
+};
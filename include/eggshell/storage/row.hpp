@@ -3,6 +3,8 @@
 #include <cstddef>
 #include <cstdint>
 
+enum class Column { id, username, email };
+
 struct Row {
     static const size_t COLUMN_USERNAME_SIZE = 32;
     static const size_t COLUMN_EMAIL_SIZE = 255;
@@ -22,4 +24,8 @@ struct Row {
     void serialize(char* destination) const;
 
     void deserialize(const char* source);
+
+    /* Column bytes inside a serialized row, and their width */
+    static uint32_t offset(Column column);
+    static uint32_t size(Column column);
 };
\ No newline at end of file
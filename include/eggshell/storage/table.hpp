@@ -2,27 +2,167 @@
 
 #include <cstdint>
 #include <fstream>
+#include <map>
+#include <memory>
 #include <shared_mutex>
 #include <string>
+#include <vector>
 
+#include "eggshell/executor/task.hpp"
 #include "eggshell/storage/cursor.hpp"
+#include "eggshell/storage/hash/hashindex.hpp"
+#include "eggshell/storage/index.hpp"
+#include "eggshell/storage/lsm/lsmtree.hpp"
 #include "eggshell/storage/pager.hpp"
 
 struct Cursor;
+class Wal;
+
+/* Storage engine of a table's rows */
+enum class Engine { btree, lsm };
 
 class Table {
    public:
+    std::string filename;
     Pager pager;
     uint32_t root_page_num;
     std::shared_mutex mutex;
+    /* Secondary indexes, opened from their files next to the table */
+    std::map<Column, std::unique_ptr<Index>> indexes;
+    /* Hash indexes; the one on id holds the leaf page of every key */
+    std::map<Column, std::unique_ptr<HashIndex>> hash_indexes;
+    /*
+    Rows of a table using the LSM engine, kept in a directory next to the
+    table file. Tables that have one open with it whatever engine is asked.
+    */
+    std::unique_ptr<LsmTree> lsm;
+    /* Workers a full scan may use, 1 scans on the calling thread */
+    uint32_t parallelism = 1;
+    /* Bytes a sort or a hash join holds before spilling to temporary files */
+    uint64_t work_memory = 16 << 20;
+    /*
+    Log of the catalog every change is appended to before it is applied,
+    if it keeps one, and the name the table is logged under
+    */
+    Wal* wal = nullptr;
+    std::string name;
+    /* Bumped by every insert and update, to tell whether rows changed */
+    uint64_t version = 0;
 
-    Table(std::string filename);
+    /*
+    With options.compress a new table file stores its pages compressed; an
+    existing one keeps the format it was created with. With
+    options.warm_restart the pages cached when it was last closed are read
+    back in the background. A VACUUM cut short by a crash is finished or
+    discarded first.
+    */
+    Table(std::string filename, Engine engine = Engine::btree,
+          const PagerOptions& options = {});
 
     ~Table();
 
     bool flush();
 
+    /*
+    Writes every cached page and the page map back, keeping the pages
+    cached, and hands the LSM log to the file, so that a crash from here
+    on keeps every change made so far. Caller holds the exclusive lock.
+    */
+    void write_back();
+
+    /*
+    Records the cached pages for the next open, if the table was opened
+    with options.warm_restart. Caller holds the lock, shared at least.
+    */
+    void save_warm_set();
+
     Cursor start();
 
     Cursor find(uint32_t key);
+
+    /*
+    Reads the row with key into row, false if there is none. Pages missing
+    from the cache are read through the scheduler while the coroutine is
+    suspended, with the table unlocked; the descent restarts from the root
+    after each read, on pages that are cached by then.
+    */
+    Task<bool> lookup(uint32_t key, Row& row, Scheduler& scheduler);
+
+    /* Inserts row at cursor, a position from find(row.id), and indexes it */
+    void insert(const Cursor& cursor, Row& row);
+
+    /*
+    Keeps a change made to cursor.value() and updates indexes; old_row is
+    the row before the change
+    */
+    void update(Cursor& cursor, const Row& old_row);
+
+    /* Moves index entries after columns of a row were changed in place */
+    void reindex(const Row& old_row, const Row& new_row);
+
+    /*
+    Position of the first cell whose key is >= key, stepping into the next
+    leaf when find lands one past the end of a leaf
+    */
+    Cursor lower_bound(uint32_t key);
+
+    /* Number of rows, read from the root's subtree counts or counted */
+    uint32_t count();
+
+    /* Number of rows with a key < key */
+    uint32_t rank(uint32_t key);
+
+    /* Cursor on the row at the given position in key order */
+    Cursor at(uint32_t position);
+
+    /*
+    Smallest and largest key, from the leftmost and the rightmost leaf.
+    False for an empty table.
+    */
+    bool min_key(uint32_t& key);
+    bool max_key(uint32_t& key);
+
+    /*
+    Up to parts - 1 increasing keys splitting the rows into ranges of
+    similar size, taken from the separators of the upper internal nodes.
+    Empty for LSM tables and for tables that fit in one leaf.
+    */
+    std::vector<uint32_t> split(uint32_t parts);
+
+    /* Builds an index file for column from the current rows */
+    void create_index(Column column);
+
+    Index* index(Column column);
+
+    void create_hash_index(Column column);
+
+    HashIndex* hash_index(Column column);
+
+    /*
+    Rewrites the tree into a new file, leaves first in key order filled to
+    fill_percent of their cells and the internal nodes after them, then
+    renames it over the table file. The rewrite runs under the shared lock
+    so reads go on; it is retried if a write slipped in before the swap,
+    the last attempt holding the exclusive lock throughout. Takes the locks
+    itself. Does nothing for LSM tables, whose runs are already in key
+    order.
+
+    A compressed table swaps two files, the data file and then its page
+    map, so a crash can stop between the renames. The new map left under
+    the vacuum file's name marks that case, and the next open renames it
+    into place; a vacuum file still present means the swap never began,
+    and it is removed with the old table kept.
+    */
+    void vacuum(uint32_t fill_percent);
+
+    /* New file a VACUUM writes before it is renamed over filename */
+    static std::string vacuum_filename(const std::string& filename);
+
+   private:
+    /* Builds the hash index on column from the current rows */
+    void build_hash_index(Column column);
+
+    /* Writes the compacted tree to filename, returns its page count */
+    uint32_t write_compacted(const std::string& filename,
+                             uint32_t leaf_cells);
 };
\ No newline at end of file
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "eggshell/storage/partition.hpp"
+#include "eggshell/storage/row.hpp"
+
+enum class WalRecordType : uint8_t { put, create_table, create_index };
+
+/*
+ * One change to a catalog. Writes are logged as the whole row after the
+ * write, so applying a record twice is the same as applying it once.
+ */
+struct WalRecord {
+    WalRecordType type = WalRecordType::put;
+    /* Numbers records from 1 in log order */
+    uint64_t lsn = 0;
+    /* Microseconds since the epoch when the record was logged */
+    int64_t time = 0;
+    /* Catalog name of the table, empty for the main table */
+    std::string table;
+
+    /* put */
+    Row row{};
+    /* create_table */
+    PartitionSpec spec;
+    /* create_index */
+    Column column = Column::id;
+    bool hash = false;
+
+    /* Appends the record framed by its length */
+    void serialize(std::string& out) const;
+
+    /* Reads the record from a frame's payload, false if it is malformed */
+    bool deserialize(std::string_view payload);
+};
+
+/*
+ * Log of every change made to the tables of a catalog, in <file>.wal. Each
+ * record goes out in a single write before the change is applied, while
+ * the table it changes is locked, so records of one key are in the order
+ * they were applied, and the table files never hold a change the log has
+ * not been handed. Replicas tail the file; the tables do not replay it.
+ */
+class Wal {
+   public:
+    /* Appends to filename, numbering after the records already in it */
+    explicit Wal(std::string filename);
+    ~Wal();
+
+    void put(std::string_view table, const Row& row);
+
+    void create_table(std::string_view table, const PartitionSpec& spec);
+
+    void create_index(std::string_view table, Column column, bool hash);
+
+    /* Number of the last record logged */
+    uint64_t lsn();
+
+    static std::string filename(const std::string& database);
+
+   private:
+    int fd;
+    std::mutex mutex;
+    uint64_t last_lsn = 0;
+    /* Reused across appends, under mutex */
+    std::string frame;
+
+    /* Stamps the record with the next number and the time and writes it */
+    void append(WalRecord& record);
+};
+
+/* Reads the records of a log, including ones appended after it opened */
+class WalReader {
+   public:
+    explicit WalReader(std::string filename);
+    ~WalReader();
+
+    /*
+    Next whole record, false at the end of the log or before a record
+    still being written, which a later call returns
+    */
+    bool next(WalRecord& record);
+
+    /* Bytes of the log read so far */
+    uint64_t offset() const;
+
+    /* Reads on from offset, which starts a record */
+    void seek(uint64_t offset);
+
+   private:
+    std::string filename;
+    /* Opened on first use, the log may not exist yet */
+    int fd = -1;
+    uint64_t position = 0;
+    std::string payload;
+
+    bool open();
+};
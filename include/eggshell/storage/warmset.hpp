@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ * Pages a table had cached, saved to <file>.warm so that a restart can read
+ * them back before queries ask for them: a u32 count of interior nodes and
+ * one of leaves, then their page numbers. Interior nodes are on the path of
+ * every lookup, so they are read first.
+ */
+struct WarmSet {
+    std::vector<uint32_t> interior;
+    std::vector<uint32_t> leaves;
+
+    static std::string filename(const std::string& table_filename);
+
+    /*
+    False if there is no set at filename, or its counts do not match its
+    size, checked before anything is sized from them
+    */
+    bool load(const std::string& filename);
+
+    /* Rewrites the set, through a rename so it is never torn */
+    void save(const std::string& filename) const;
+};
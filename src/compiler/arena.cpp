@@ -0,0 +1,108 @@
+#include "eggshell/compiler/arena.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+namespace {
+
+thread_local Arena* current_arena = nullptr;
+thread_local std::atomic<uint64_t>* heap_count = nullptr;
+
+/* Ahead of each object, whether it came from an arena */
+struct ObjectHeader {
+    alignas(std::max_align_t) bool in_arena;
+};
+
+}  // namespace
+
+Arena::Arena() : top{initial}, remaining{INLINE_SIZE} {
+}
+
+void* Arena::allocate(size_t size, size_t align) {
+    size_t padding = -(uintptr_t)top & (align - 1);
+    if (padding + size > remaining) {
+        /* The first kept block that is large enough, else a new one */
+        size_t needed = size + align;
+        auto it = std::find_if(blocks.begin() + next_block, blocks.end(),
+                               [needed](const Block& block) {
+                                   return block.size >= needed;
+                               });
+        if (it == blocks.end()) {
+            size_t block_size = std::max(BLOCK_SIZE, needed);
+            it = blocks.insert(blocks.begin() + next_block,
+                               Block{std::make_unique_for_overwrite<char[]>(
+                                         block_size),
+                                     block_size});
+        } else {
+            std::rotate(blocks.begin() + next_block, it, it + 1);
+            it = blocks.begin() + next_block;
+        }
+        next_block++;
+        top = it->data.get();
+        remaining = it->size;
+        padding = -(uintptr_t)top & (align - 1);
+    }
+    char* result = top + padding;
+    top += padding + size;
+    remaining -= padding + size;
+    used_bytes += padding + size;
+    return result;
+}
+
+void Arena::reset() {
+    top = initial;
+    remaining = INLINE_SIZE;
+    next_block = 0;
+    used_bytes = 0;
+}
+
+size_t Arena::used() const {
+    return used_bytes;
+}
+
+size_t Arena::heap_blocks() const {
+    return blocks.size();
+}
+
+Arena* Arena::current() {
+    return current_arena;
+}
+
+void Arena::make_current(Arena* arena) {
+    current_arena = arena;
+}
+
+void* Arena::allocate_object(size_t size) {
+    size += sizeof(ObjectHeader);
+    ObjectHeader* header;
+    if (current_arena) {
+        header = (ObjectHeader*)current_arena->allocate(
+            size, alignof(ObjectHeader));
+    } else {
+        header = (ObjectHeader*)::operator new(size);
+        if (heap_count) {
+            heap_count->fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    header->in_arena = current_arena != nullptr;
+    return header + 1;
+}
+
+void Arena::free_object(void* object) {
+    if (!object) {
+        return;
+    }
+    ObjectHeader* header = (ObjectHeader*)object - 1;
+    if (!header->in_arena) {
+        ::operator delete(header);
+    }
+}
+
+std::atomic<uint64_t>* Arena::heap_object_count() {
+    return heap_count;
+}
+
+void Arena::count_heap_objects(std::atomic<uint64_t>* count) {
+    heap_count = count;
+}
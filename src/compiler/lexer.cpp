@@ -0,0 +1,111 @@
+#include "eggshell/compiler/lexer.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+static bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static bool is_symbol(char c) {
+    switch (c) {
+        case '(':
+        case ')':
+        case ',':
+        case ';':
+        case '=':
+        case '*':
+        case '?':
+            return true;
+        default:
+            return false;
+    }
+}
+
+static char lower(char c) {
+    return c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c;
+}
+
+bool iequals(std::string_view text, std::string_view keyword) {
+    if (text.size() != keyword.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < text.size(); i++) {
+        if (lower(text[i]) != keyword[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool is_keyword(std::string_view word) {
+    static constexpr std::string_view KEYWORDS[] = {
+        "and", "as", "asc", "avg", "between", "btree", "by", "conflict",
+        "count", "create", "deallocate", "desc", "do", "email", "execute",
+        "fill", "from", "group", "hash", "id", "index", "inner", "insert",
+        "into", "join", "like", "limit", "max", "min", "offset", "on", "order",
+        "partitions", "prepare", "range", "select", "set", "sum", "table",
+        "update", "username", "using", "vacuum", "values", "where"};
+    /* Sorted, searched for the word in lowercase */
+    char text[16];
+    if (word.size() > sizeof(text)) {
+        return false;
+    }
+    for (size_t i = 0; i < word.size(); i++) {
+        text[i] = lower(word[i]);
+    }
+    return std::binary_search(std::begin(KEYWORDS), std::end(KEYWORDS),
+                              std::string_view(text, word.size()));
+}
+
+bool Token::is(std::string_view keyword) const {
+    return type == TokenType::word && iequals(text, keyword);
+}
+
+bool Token::is(char symbol) const {
+    return type == TokenType::symbol && text[0] == symbol;
+}
+
+bool Token::is_value() const {
+    return type == TokenType::word || type == TokenType::string ||
+           type == TokenType::placeholder;
+}
+
+Lexer::Lexer(std::string_view input) : input{input}, pos{0} {
+}
+
+size_t Lexer::offset() const {
+    return pos;
+}
+
+Token Lexer::next() {
+    while (pos < input.size() && is_space(input[pos])) {
+        pos++;
+    }
+    if (pos == input.size()) {
+        return Token{TokenType::end, input.substr(pos)};
+    }
+
+    size_t start = pos;
+    char c = input[pos];
+    if (is_symbol(c)) {
+        pos++;
+        return Token{c == '?' ? TokenType::placeholder : TokenType::symbol,
+                     input.substr(start, 1)};
+    }
+    if (c == '\'') {
+        size_t close = input.find('\'', start + 1);
+        if (close == std::string_view::npos) {
+            pos = input.size();
+            return Token{TokenType::invalid, input.substr(start)};
+        }
+        pos = close + 1;
+        return Token{TokenType::string,
+                     input.substr(start + 1, close - start - 1)};
+    }
+    while (pos < input.size() && !is_space(input[pos]) &&
+           !is_symbol(input[pos]) && input[pos] != '\'') {
+        pos++;
+    }
+    return Token{TokenType::word, input.substr(start, pos - start)};
+}
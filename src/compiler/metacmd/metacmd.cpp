@@ -1,5 +1,7 @@
 #include "eggshell/compiler/metacmd/metacmd.hpp"
 
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 #include "eggshell/compiler/metacmd/metacmdresult.hpp"
@@ -41,7 +43,8 @@ void print_tree(Pager& pager, uint32_t page_num, uint32_t indentation_level) {
         case (NodeType::internal):
             num_keys = *InternalNode::num_keys(node);
             indent(indentation_level);
-            printf("- internal (size %d)\n", num_keys);
+            printf("- internal (size %d, count %d)\n", num_keys,
+                   Node::subtree_count(node));
             if (num_keys > 0) {
                 for (uint32_t i = 0; i < num_keys; i++) {
                     child = *InternalNode::child(node, i);
@@ -57,16 +60,76 @@ void print_tree(Pager& pager, uint32_t page_num, uint32_t indentation_level) {
     }
 }
 
-MetaCmdResult do_meta_cmd(std::string input, Table& table) {
+void print_lsm(LsmTree& lsm) {
+    printf("- memtable (size %d)\n", lsm.memtable_entries());
+    std::vector<uint32_t> shape = lsm.shape();
+    for (uint32_t level = 0; level < shape.size(); level++) {
+        printf("- level %d (runs %d)\n", level, shape[level]);
+    }
+}
+
+void print_stats(const StatementStats& stats, ResultSink& sink) {
+    sink.begin_row();
+    sink.value(stats.heap_objects);
+    sink.value(stats.arena_blocks);
+    sink.value(stats.arena_bytes);
+    sink.end_row();
+}
+
+MetaCmdResult do_meta_cmd(std::string input, Catalog& catalog,
+                          ResultSink& sink, const Session& session) {
+    /* Rows still buffered come before what the command prints itself */
+    sink.flush();
+    Table& table = catalog.table("");
     if (input == ".exit") {
         return MetaCmdResult::exit;
     } else if (input == ".constants") {
         print_constants();
         return MetaCmdResult::success;
+    } else if (input == ".btree" && table.lsm) {
+        std::cout << "LSM:\n";
+        print_lsm(*table.lsm);
+        return MetaCmdResult::success;
     } else if (input == ".btree") {
         std::cout << "Tree:\n";
         print_tree(table.pager, 0, 0);
         return MetaCmdResult::success;
+    } else if (input == ".stats") {
+        print_stats(session.stats, sink);
+        return MetaCmdResult::success;
+    } else if (input == ".tables") {
+        for (const std::string& name : catalog.names()) {
+            std::cout << name << "\n";
+        }
+        return MetaCmdResult::success;
+    } else if (input.starts_with(".parallelism ")) {
+        /* Workers used by full scans, 1 to scan on this thread */
+        int parallelism = atoi(input.c_str() + strlen(".parallelism "));
+        if (parallelism < 1) {
+            return MetaCmdResult::unrecognized;
+        }
+        for (Table* table : catalog.tables()) {
+            table->parallelism = parallelism;
+        }
+        return MetaCmdResult::success;
+    } else if (input.starts_with(".work_memory ")) {
+        /* Bytes sorts and hash joins hold in memory before spilling */
+        long long bytes = atoll(input.c_str() + strlen(".work_memory "));
+        if (bytes < 1) {
+            return MetaCmdResult::unrecognized;
+        }
+        for (Table* table : catalog.tables()) {
+            table->work_memory = bytes;
+        }
+        return MetaCmdResult::success;
+    } else if (input.starts_with(".format ")) {
+        /* text, csv, tsv or binary */
+        OutputFormat format;
+        if (!parse_output_format(input.substr(strlen(".format ")), format)) {
+            return MetaCmdResult::unrecognized;
+        }
+        sink.format = format;
+        return MetaCmdResult::success;
     } else {
         return MetaCmdResult::unrecognized;
     }
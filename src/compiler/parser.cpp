@@ -1,99 +1,348 @@
 #include "eggshell/compiler/parser.hpp"
 
-#include <iostream>
-#include <string>
-#include <vector>
+Parser::Parser(std::string_view input, Arena& arena)
+    : input{input}, lexer{input}, arena{arena} {
+    advance();
+}
 
-std::string to_upper_case(const std::string& str) {
-    std::string new_str = str;
-    std::transform(str.begin(), str.end(), new_str.begin(), ::toupper);
-    std::cout << new_str << "\n";
-    return new_str;
+void Parser::advance() {
+    token = lexer.next();
 }
 
-ASTNode::ASTNode(ASTNodeType type) : type{type} {
+bool Parser::accept(std::string_view keyword) {
+    if (!token.is(keyword)) {
+        return false;
+    }
+    advance();
+    return true;
 }
 
-SelectNode::SelectNode(ASTNodeType type) : ASTNode{type} {
+bool Parser::accept(char symbol) {
+    if (!token.is(symbol)) {
+        return false;
+    }
+    advance();
+    return true;
 }
 
-InsertNode::InsertNode(ASTNodeType type) : ASTNode{type} {
+bool Parser::name(std::string_view& name) {
+    if (token.type != TokenType::word) {
+        return false;
+    }
+    name = token.text;
+    advance();
+    return true;
 }
 
-// Parse the SQL query and return the AST
-ASTNode parseSQL(const std::string& query) {
-    // The query is in the format:
-    // SELECT column1, column2 FROM table_name;
-    // INSERT INTO table_name VALUES (value1, value2, ...);
+bool Parser::exact_name(std::string_view& name) {
+    if (!this->name(name)) {
+        return false;
+    }
+    keyword_spelled |= is_keyword(name);
+    return true;
+}
 
-    // Parsing logic for SELECT statement
-    if (to_upper_case(query.substr(0, 12)) == "SELECT INTO") {
-        SelectNode selectNode{ASTNodeType::select};
+bool Parser::value(Token& value) {
+    if (!token.is_value()) {
+        return false;
+    }
+    keyword_spelled |= token.type == TokenType::word && is_keyword(token.text);
+    value = token;
+    advance();
+    return true;
+}
 
-        // Extract columns
-        size_t fromPos = query.find("FROM");
-        std::string columnsStr = query.substr(7, fromPos - 7);
-        size_t commaPos = 0;
-        while ((commaPos = columnsStr.find(",")) != std::string::npos) {
-            std::string column = columnsStr.substr(0, commaPos);
-            selectNode.columns.push_back(column);
-            columnsStr.erase(0, commaPos + 1);
+bool Parser::list(ASTList*& list) {
+    /* <value> [, <value>] ... */
+    ASTList** tail = &list;
+    do {
+        *tail = arena.make<ASTList>();
+        if (!value((*tail)->value)) {
+            return false;
         }
-        selectNode.columns.push_back(columnsStr);
+        tail = &(*tail)->next;
+    } while (accept(','));
+    return true;
+}
 
-        // Extract table
-        size_t tablePos = query.find("FROM") + 5;
-        size_t semicolonPos = query.find(";");
-        selectNode.table = query.substr(tablePos, semicolonPos - tablePos);
+bool Parser::predicate(Predicate*& predicate) {
+    predicate = arena.make<Predicate>();
+    if (!name(predicate->column)) {
+        return false;
+    }
+    if (accept('=')) {
+        predicate->op = PredicateOp::eq;
+    } else if (accept("like")) {
+        predicate->op = PredicateOp::like;
+    } else if (accept("between")) {
+        predicate->op = PredicateOp::between;
+        return value(predicate->value) && accept("and") &&
+               value(predicate->high);
+    } else {
+        return false;
+    }
+    return value(predicate->value);
+}
 
-        return selectNode;
+bool Parser::items(SelectItem*& items) {
+    /* <item> [, <item>] ... */
+    SelectItem** tail = &items;
+    do {
+        *tail = arena.make<SelectItem>();
+        SelectItem& item = **tail;
+        if (!name(item.column)) {
+            return false;
+        }
+        if (accept('(')) {
+            item.function = item.column;
+            item.column = {};
+            if (!accept('*') && !name(item.column)) {
+                return false;
+            }
+            if (!accept(')')) {
+                return false;
+            }
+        }
+        tail = &item.next;
+    } while (accept(','));
+    return true;
+}
 
-        // std::cout << "Parsed SELECT statement AST:" << std::endl;
-        // std::cout << "Columns: ";
-        // for (const auto& column : selectNode.columns) {
-        //     std::cout << column << " ";
-        // }
-        // std::cout << std::endl;
-        // std::cout << "Table: " << selectNode.table << std::endl;
+bool Parser::select(ASTNode*& node) {
+    SelectNode* select = arena.make<SelectNode>();
+    select->type = ASTNodeType::select;
+    select->limit.type = TokenType::end;
+    select->offset.type = TokenType::end;
+    node = select;
+
+    if (accept('*')) {
+    } else if (token.type == TokenType::word && !token.is("from") &&
+               !token.is("where") && !token.is("group") &&
+               !token.is("order") && !token.is("limit") &&
+               !token.is("offset")) {
+        if (!items(select->items)) {
+            return false;
+        }
     }
 
-    // Parsing logic for INSERT statement
-    else if (to_upper_case(query.substr(0, 6)) == "INSERT") {
-        InsertNode insertNode{ASTNodeType::insert};
+    if (accept("from") && !exact_name(select->table)) {
+        return false;
+    }
+    if (!select->table.empty() && (accept("inner") || token.is("join"))) {
+        if (!accept("join") || !exact_name(select->join_table) ||
+            !accept("on") || !name(select->join_left) || !accept('=') ||
+            !name(select->join_right)) {
+            return false;
+        }
+    }
+    if (accept("where") && !predicate(select->where)) {
+        return false;
+    }
+    if (accept("group") && (!accept("by") || !name(select->group_by))) {
+        return false;
+    }
+    if (accept("order")) {
+        if (!accept("by") || !name(select->order_by)) {
+            return false;
+        }
+        select->descending = accept("desc");
+        if (!select->descending) {
+            accept("asc");
+        }
+    }
+    if (accept("limit") && !value(select->limit)) {
+        return false;
+    }
+    if (accept("offset") && !value(select->offset)) {
+        return false;
+    }
+    return true;
+}
 
-        // Extract table
-        size_t intoPos = query.find("INTO") + 5;
-        size_t valuesPos = query.find("VALUES");
-        insertNode.table = query.substr(intoPos, valuesPos - intoPos);
+bool Parser::insert(ASTNode*& node) {
+    InsertNode* insert = arena.make<InsertNode>();
+    insert->type = ASTNodeType::insert;
+    node = insert;
 
-        // Extract values
-        size_t openParenPos = query.find("(");
-        size_t closeParenPos = query.find(")");
-        std::string valuesStr =
-            query.substr(openParenPos + 1, closeParenPos - openParenPos - 1);
-        size_t commaPos = 0;
-        while ((commaPos = valuesStr.find(",")) != std::string::npos) {
-            std::string value = valuesStr.substr(0, commaPos);
-            insertNode.values.push_back(value);
-            valuesStr.erase(0, commaPos + 1);
+    if (accept("into")) {
+        if (!exact_name(insert->table) || !accept("values") ||
+            !accept('(') || !list(insert->values) || !accept(')')) {
+            return false;
         }
-        insertNode.values.push_back(valuesStr);
+    } else if (accept('(')) {
+        if (!list(insert->values) || !accept(')')) {
+            return false;
+        }
+    } else {
+        /* Bare values separated by whitespace */
+        ASTList** tail = &insert->values;
+        while (token.is_value() && !token.is("on")) {
+            *tail = arena.make<ASTList>();
+            value((*tail)->value);
+            tail = &(*tail)->next;
+        }
+    }
 
-        return insertNode;
+    if (accept("on")) {
+        if (!accept("conflict") || !accept("do") || !accept("update")) {
+            return false;
+        }
+        insert->on_conflict_update = true;
+    }
+    return true;
+}
+
+bool Parser::update(ASTNode*& node) {
+    UpdateNode* update = arena.make<UpdateNode>();
+    update->type = ASTNodeType::update;
+    node = update;
 
-        // std::cout << "Parsed INSERT statement AST:" << std::endl;
-        // std::cout << "Table: " << insertNode.table << std::endl;
-        // std::cout << "Values: ";
-        // for (const auto& value : insertNode.values) {
-        //     std::cout << value << " ";
-        // }
-        // std::cout << std::endl;
+    if (!token.is("set") && !exact_name(update->table)) {
+        return false;
     }
+    if (!accept("set")) {
+        return false;
+    }
+    Assignment** tail = &update->assignments;
+    do {
+        *tail = arena.make<Assignment>();
+        if (!name((*tail)->column) || !accept('=') ||
+            !value((*tail)->value)) {
+            return false;
+        }
+        tail = &(*tail)->next;
+        accept(',');
+    } while (!token.is("where") && token.type != TokenType::end &&
+             !token.is(';'));
 
-    // TODO: Handle other SQL statements if needed
+    return accept("where") && predicate(update->where);
+}
+
+bool Parser::create_index(ASTNode*& node) {
+    CreateIndexNode* create = arena.make<CreateIndexNode>();
+    create->type = ASTNodeType::create_index;
+    node = create;
+
+    if (!accept("index") || !accept("on") || !name(create->column)) {
+        return false;
+    }
+    if (accept('(')) {
+        /* on <table> (<column>) */
+        create->table = create->column;
+        keyword_spelled |= is_keyword(create->table);
+        if (!name(create->column) || !accept(')')) {
+            return false;
+        }
+    }
+    if (accept("using") && !name(create->method)) {
+        return false;
+    }
+    return true;
+}
+
+bool Parser::create_table(ASTNode*& node) {
+    CreateTableNode* create = arena.make<CreateTableNode>();
+    create->type = ASTNodeType::create_table;
+    node = create;
+    create->partitions.type = TokenType::end;
+    create->range = false;
+
+    if (!accept("table") || !exact_name(create->table)) {
+        return false;
+    }
+    if (accept("partitions")) {
+        if (!value(create->partitions)) {
+            return false;
+        }
+        if (accept("by")) {
+            create->range = accept("range");
+            if (create->range ? !value(create->range_width)
+                              : !accept("hash")) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool Parser::vacuum(ASTNode*& node) {
+    VacuumNode* vacuum = arena.make<VacuumNode>();
+    vacuum->type = ASTNodeType::vacuum;
+    node = vacuum;
+    vacuum->fill.type = TokenType::end;
+
+    if (!token.is("fill")) {
+        exact_name(vacuum->table);
+    }
+    return !accept("fill") || value(vacuum->fill);
+}
+
+bool Parser::prepare(ASTNode*& node) {
+    PrepareNode* prepare = arena.make<PrepareNode>();
+    prepare->type = ASTNodeType::prepare;
+    node = prepare;
+
+    if (!name(prepare->name) || !accept("as") ||
+        token.type == TokenType::end) {
+        return false;
+    }
+    prepare->body = input.substr(token.text.data() - input.data());
+    while (token.type != TokenType::end) {
+        advance();
+    }
+    return true;
+}
+
+bool Parser::execute(ASTNode*& node) {
+    ExecuteNode* execute = arena.make<ExecuteNode>();
+    execute->type = ASTNodeType::execute;
+    node = execute;
+
+    if (!name(execute->name)) {
+        return false;
+    }
+    if (accept('(')) {
+        if (!list(execute->arguments) || !accept(')')) {
+            return false;
+        }
+    }
+    return true;
+}
 
-    else {
-        std::cout << "Unsupported SQL statement" << std::endl;
-        exit(EXIT_FAILURE);
+bool Parser::deallocate(ASTNode*& node) {
+    DeallocateNode* deallocate = arena.make<DeallocateNode>();
+    deallocate->type = ASTNodeType::deallocate;
+    node = deallocate;
+
+    accept("prepare");
+    return name(deallocate->name);
+}
+
+CmdPrepareResult Parser::parse(ASTNode*& node) {
+    bool parsed;
+    if (accept("select")) {
+        parsed = select(node);
+    } else if (accept("insert")) {
+        parsed = insert(node);
+    } else if (accept("update")) {
+        parsed = update(node);
+    } else if (accept("create")) {
+        parsed = token.is("table") ? create_table(node) : create_index(node);
+    } else if (accept("vacuum")) {
+        parsed = vacuum(node);
+    } else if (accept("prepare")) {
+        parsed = prepare(node);
+    } else if (accept("execute")) {
+        parsed = execute(node);
+    } else if (accept("deallocate")) {
+        parsed = deallocate(node);
+    } else {
+        return CmdPrepareResult::unrecognized;
+    }
+
+    accept(';');
+    if (!parsed || token.type != TokenType::end) {
+        return CmdPrepareResult::syntax_error;
     }
-}
\ No newline at end of file
+    return CmdPrepareResult::success;
+}
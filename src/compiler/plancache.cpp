@@ -0,0 +1,95 @@
+#include "eggshell/compiler/plancache.hpp"
+
+#include <algorithm>
+
+#include "eggshell/compiler/lexer.hpp"
+
+PlanCache::PlanCache(size_t capacity) : capacity{capacity} {
+}
+
+/* A value the key leaves a ? for */
+static bool is_literal(const Token& token) {
+    if (token.type == TokenType::string) {
+        return true;
+    }
+    return token.type == TokenType::word &&
+           std::all_of(token.text.begin(), token.text.end(),
+                       [](char c) { return c >= '0' && c <= '9'; });
+}
+
+static bool has_upper(std::string_view text) {
+    return std::any_of(text.begin(), text.end(),
+                       [](char c) { return c >= 'A' && c <= 'Z'; });
+}
+
+void PlanCache::normalize(std::string_view input, std::string& key,
+                          std::vector<std::string_view>& literals) {
+    key.clear();
+    literals.clear();
+    /* Set on meeting a placeholder, which starts the key over */
+    bool placeholders = false;
+    Lexer lexer{input};
+    Token token = lexer.next();
+    while (token.type != TokenType::end) {
+        Token next = lexer.next();
+        if (token.is(';') && next.type == TokenType::end) {
+            break;
+        }
+        if (token.type == TokenType::placeholder && !placeholders &&
+            !literals.empty()) {
+            placeholders = true;
+            key.clear();
+            literals.clear();
+            lexer = Lexer{input};
+            token = lexer.next();
+            continue;
+        }
+        placeholders |= token.type == TokenType::placeholder;
+        if (!key.empty()) {
+            key += ' ';
+        }
+        if (!placeholders && is_literal(token)) {
+            literals.push_back(token.text);
+            key += '?';
+        } else if (token.type == TokenType::string) {
+            key += '\'';
+            key += token.text;
+            key += '\'';
+        } else if (token.type == TokenType::word && has_upper(token.text) &&
+                   is_keyword(token.text)) {
+            for (char c : token.text) {
+                key += c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c;
+            }
+        } else {
+            key += token.text;
+        }
+        token = next;
+    }
+}
+
+const Statement* PlanCache::find(const std::string& key) {
+    auto it = index.find(key);
+    if (it == index.end()) {
+        misses++;
+        return nullptr;
+    }
+    hits++;
+    entries.splice(entries.begin(), entries, it->second);
+    return &it->second->second;
+}
+
+void PlanCache::insert(const std::string& key, const Statement& statement) {
+    if (index.contains(key)) {
+        return;
+    }
+    if (entries.size() == capacity) {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+    entries.emplace_front(key, statement);
+    index[entries.front().first] = entries.begin();
+}
+
+size_t PlanCache::size() const {
+    return entries.size();
+}
@@ -0,0 +1,78 @@
+#include "eggshell/compiler/script.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+ScriptReader::ScriptReader(FILE* file) : file{file}, buffer(CHUNK_SIZE) {
+}
+
+bool ScriptReader::fill() {
+    if (eof) {
+        return false;
+    }
+    /* Keep the statement read so far, it continues into the new chunk */
+    memmove(buffer.data(), buffer.data() + pos, end - pos);
+    end -= pos;
+    pos = 0;
+    if (buffer.size() - end < CHUNK_SIZE / 2) {
+        buffer.resize(buffer.size() + CHUNK_SIZE);
+    }
+    size_t read = fread(buffer.data() + end, 1, buffer.size() - end, file);
+    if (read == 0) {
+        if (ferror(file)) {
+            std::cout << "Error reading script.\n";
+            exit(EXIT_FAILURE);
+        }
+        eof = true;
+        return false;
+    }
+    end += read;
+    return true;
+}
+
+bool ScriptReader::next(std::string& statement) {
+    while (true) {
+        while (pos < end && isspace((unsigned char)buffer[pos])) {
+            pos++;
+        }
+        if (pos == end) {
+            if (!fill()) {
+                return false;
+            }
+            continue;
+        }
+
+        bool meta = buffer[pos] == '.';
+        bool quoted = false;
+        size_t scanned = pos;
+        while (true) {
+            /* Offsets survive fill(), which moves the statement to the front */
+            for (; scanned < end; scanned++) {
+                char c = buffer[scanned];
+                if (meta ? c == '\n' : c == ';' && !quoted) {
+                    break;
+                }
+                quoted ^= c == '\'';
+            }
+            size_t start = pos;
+            bool more = scanned == end && fill();
+            scanned -= start - pos;
+            if (!more) {
+                break;
+            }
+        }
+
+        size_t stop = scanned;
+        while (stop > pos && isspace((unsigned char)buffer[stop - 1])) {
+            stop--;
+        }
+        statement.assign(buffer.data() + pos, stop - pos);
+        pos = std::min(scanned + 1, end);
+        if (!statement.empty()) {
+            return true;
+        }
+    }
+}
@@ -0,0 +1,158 @@
+#include "eggshell/compiler/session.hpp"
+
+#include "eggshell/compiler/parser.hpp"
+
+/*
+Binds the literals normalize took out of the key into the plan made for
+it, leaving the statement as if planned with them written in
+*/
+static CmdPrepareResult fill(Statement& statement,
+                             const std::vector<std::string_view>& literals) {
+    if (literals.empty()) {
+        return CmdPrepareResult::success;
+    }
+    for (uint32_t i = 0; i < literals.size(); i++) {
+        CmdPrepareResult result = statement.bind(i, literals[i]);
+        if (result != CmdPrepareResult::success) {
+            return result;
+        }
+    }
+    statement.parameters.clear();
+    statement.bound.clear();
+    return CmdPrepareResult::success;
+}
+
+CmdPrepareResult Session::prepare(std::string_view input,
+                                  Statement& statement) {
+    PlanCache::normalize(input, key, literals);
+    if (const Statement* plan = cache.find(key)) {
+        statement = *plan;
+        return fill(statement, literals);
+    }
+
+    /* Nodes go to the statement's arena while one runs */
+    Arena local;
+    Arena& arena = Arena::current() ? *Arena::current() : local;
+    ASTNode* node;
+    Parser parser{input, arena};
+    CmdPrepareResult result = parser.parse(node);
+    if (result != CmdPrepareResult::success) {
+        return result;
+    }
+
+    statement = Statement{};
+    if (node->type == ASTNodeType::prepare) {
+        auto& prepare = static_cast<const PrepareNode&>(*node);
+        std::string name{prepare.name};
+        Statement body;
+        result = this->prepare(prepare.body, body);
+        if (result == CmdPrepareResult::success) {
+            named[name] = std::move(body);
+            statement.type = StatementType::noop;
+        }
+        return result;
+    }
+    if (node->type == ASTNodeType::execute) {
+        auto& execute = static_cast<const ExecuteNode&>(*node);
+        const Statement* prepared = this->prepared(execute.name);
+        if (!prepared) {
+            return CmdPrepareResult::unknown_prepared;
+        }
+        statement = *prepared;
+        uint32_t index = 0;
+        for (const ASTList* argument = execute.arguments; argument;
+             argument = argument->next, index++) {
+            if (argument->value.type == TokenType::placeholder ||
+                index == statement.num_parameters()) {
+                return CmdPrepareResult::syntax_error;
+            }
+            result = statement.bind(index, argument->value.text);
+            if (result != CmdPrepareResult::success) {
+                return result;
+            }
+        }
+        return index == statement.num_parameters()
+                   ? CmdPrepareResult::success
+                   : CmdPrepareResult::syntax_error;
+    }
+    if (node->type == ASTNodeType::deallocate) {
+        auto& deallocate = static_cast<const DeallocateNode&>(*node);
+        auto it = named.find(deallocate.name);
+        if (it == named.end()) {
+            return CmdPrepareResult::unknown_prepared;
+        }
+        named.erase(it);
+        statement.type = StatementType::noop;
+        return CmdPrepareResult::success;
+    }
+
+    result = statement.plan(*node);
+    if (result != CmdPrepareResult::success) {
+        return result;
+    }
+    if (literals.empty()) {
+        if (!parser.keyword_spelled) {
+            cache.insert(key, statement);
+        }
+        return result;
+    }
+
+    /*
+    Cached is the plan of the key, ? for each literal. Literals the key
+    cannot take a placeholder for, such as a partition count, leave the
+    statement uncached.
+    */
+    Parser slots{key, arena};
+    Statement plan;
+    if (slots.parse(node) == CmdPrepareResult::success &&
+        !slots.keyword_spelled &&
+        plan.plan(*node) == CmdPrepareResult::success &&
+        plan.num_parameters() == literals.size()) {
+        cache.insert(key, plan);
+    }
+    return result;
+}
+
+const Statement* Session::prepared(std::string_view name) const {
+    auto it = named.find(name);
+    return it == named.end() ? nullptr : &it->second;
+}
+
+std::string prepare_error(CmdPrepareResult result, std::string_view input) {
+    switch (result) {
+        case (CmdPrepareResult::success):
+            return "";
+        case (CmdPrepareResult::id_out_of_range):
+            return "Id out of range\n";
+        case (CmdPrepareResult::string_too_long):
+            return "String is too long.\n";
+        case (CmdPrepareResult::syntax_error):
+            return "Syntax error. Could not parse statement.\n";
+        case (CmdPrepareResult::unknown_prepared):
+            return "Unknown prepared statement.\n";
+        case (CmdPrepareResult::unrecognized):
+            return "Unrecognized keyword at start of '" + std::string(input) +
+                   "'.\n";
+    }
+    return "";
+}
+
+const char* execute_message(ExecuteResult result) {
+    switch (result) {
+        case (ExecuteResult::success):
+            return "Executed.\n";
+        case (ExecuteResult::duplicate_key):
+            return "Error: Duplicate key.\n";
+        case (ExecuteResult::table_full):
+            return "Error: Table full.\n";
+        case (ExecuteResult::unbound_parameter):
+            return "Error: Unbound parameter.\n";
+        case (ExecuteResult::table_exists):
+            return "Error: Table already exists.\n";
+        case (ExecuteResult::partitioned_join):
+            return "Error: Joins on partitioned tables are not supported.\n";
+        case (ExecuteResult::read_only):
+            return "Error: Read-only replica.\n";
+    }
+    return "";
+}
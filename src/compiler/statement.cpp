@@ -1,80 +1,1114 @@
 #include "eggshell/compiler/statement.hpp"
 
+#include <algorithm>
+#include <cctype>
+#include <charconv>
 #include <cstring>
+#include <limits>
 #include <shared_mutex>
-#include <sstream>
 
-#include "eggshell/storage/bplus/leafnode.hpp"
+#include "eggshell/compiler/parser.hpp"
+#include "eggshell/executor/aggregate.hpp"
+#include "eggshell/executor/hashjoin.hpp"
+#include "eggshell/executor/limit.hpp"
+#include "eggshell/executor/merge.hpp"
+#include "eggshell/executor/mergejoin.hpp"
+#include "eggshell/executor/parallelscan.hpp"
+#include "eggshell/executor/project.hpp"
+#include "eggshell/executor/scan.hpp"
+#include "eggshell/executor/sort.hpp"
+#include "eggshell/storage/catalog.hpp"
 
-CmdPrepareResult Statement::prepare(std::string input) {
-    if (input.starts_with("insert")) {
-        type = StatementType::insert;
-        std::stringstream stream(input);
-        int64_t id;
-        std::string w, username, email;
-        stream >> w >> id >> username >> email;
-        if (username.size() > Row::COLUMN_USERNAME_SIZE ||
-            email.size() > Row::COLUMN_EMAIL_SIZE) {
-            return CmdPrepareResult::string_too_long;
+static bool parse_column(std::string_view name, Column& column) {
+    if (iequals(name, "id")) {
+        column = Column::id;
+    } else if (iequals(name, "username")) {
+        column = Column::username;
+    } else if (iequals(name, "email")) {
+        column = Column::email;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool parse_aggregate(std::string_view name,
+                            AggregateFunction& function) {
+    if (iequals(name, "count")) {
+        function = AggregateFunction::count;
+    } else if (iequals(name, "sum")) {
+        function = AggregateFunction::sum;
+    } else if (iequals(name, "min")) {
+        function = AggregateFunction::min;
+    } else if (iequals(name, "max")) {
+        function = AggregateFunction::max;
+    } else if (iequals(name, "avg")) {
+        function = AggregateFunction::avg;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static CmdPrepareResult parse_key(std::string_view text, uint32_t& key) {
+    int64_t value;
+    auto [end, error] =
+        std::from_chars(text.data(), text.data() + text.size(), value);
+    if (text.empty() || end != text.data() + text.size()) {
+        return error == std::errc::result_out_of_range
+                   ? CmdPrepareResult::id_out_of_range
+                   : CmdPrepareResult::syntax_error;
+    }
+    if (value < 0 || value > std::numeric_limits<uint32_t>::max()) {
+        return CmdPrepareResult::id_out_of_range;
+    }
+    key = value;
+    return CmdPrepareResult::success;
+}
+
+/* Copies a value into a zero padded column of max_size characters */
+static CmdPrepareResult copy_value(std::string_view value, char* destination,
+                                   size_t max_size) {
+    if (value.size() > max_size) {
+        return CmdPrepareResult::string_too_long;
+    }
+    memset(destination, 0, max_size + 1);
+    memcpy(destination, value.data(), value.size());
+    return CmdPrepareResult::success;
+}
+
+CmdPrepareResult Statement::prepare(std::string_view input) {
+    Arena arena;
+    ASTNode* node;
+    CmdPrepareResult result = Parser{input, arena}.parse(node);
+    if (result != CmdPrepareResult::success) {
+        return result;
+    }
+    return plan(*node);
+}
+
+CmdPrepareResult Statement::plan(const ASTNode& node) {
+    table_name = node.table;
+    switch (node.type) {
+        case ASTNodeType::insert:
+            return plan(static_cast<const InsertNode&>(node));
+        case ASTNodeType::update:
+            return plan(static_cast<const UpdateNode&>(node));
+        case ASTNodeType::select:
+            return plan(static_cast<const SelectNode&>(node));
+        case ASTNodeType::create_index:
+            return plan(static_cast<const CreateIndexNode&>(node));
+        case ASTNodeType::create_table:
+            return plan(static_cast<const CreateTableNode&>(node));
+        case ASTNodeType::vacuum:
+            return plan(static_cast<const VacuumNode&>(node));
+        default:
+            /* Prepared statements need a Session */
+            return CmdPrepareResult::unrecognized;
+    }
+}
+
+CmdPrepareResult Statement::set(Parameter parameter, std::string_view value) {
+    CmdPrepareResult result;
+    switch (parameter) {
+        case Parameter::id:
+            return parse_key(value, row_to_insert.id);
+        case Parameter::username:
+            return copy_value(value, row_to_insert.username,
+                              Row::COLUMN_USERNAME_SIZE);
+        case Parameter::email:
+            return copy_value(value, row_to_insert.email,
+                              Row::COLUMN_EMAIL_SIZE);
+        case Parameter::key:
+            result = parse_key(value, key_min);
+            key_max = key_min;
+            return result;
+        case Parameter::key_min:
+            return parse_key(value, key_min);
+        case Parameter::key_max:
+            return parse_key(value, key_max);
+        case Parameter::where_value:
+        case Parameter::where_pattern:
+            /* A pattern without a trailing % is an equality */
+            where_prefix =
+                parameter == Parameter::where_pattern && value.ends_with('%');
+            where_value = value.substr(0, value.size() - where_prefix);
+            return where_value.size() > Row::size(where_column) - 1
+                       ? CmdPrepareResult::string_too_long
+                       : CmdPrepareResult::success;
+        case Parameter::limit:
+        case Parameter::offset:
+            result = parse_key(value, parameter == Parameter::limit ? limit
+                                                                     : offset);
+            return result == CmdPrepareResult::success
+                       ? result
+                       : CmdPrepareResult::syntax_error;
+    }
+    return CmdPrepareResult::syntax_error;
+}
+
+CmdPrepareResult Statement::set(Parameter parameter, const Token& value) {
+    if (value.type != TokenType::placeholder) {
+        return set(parameter, value.text);
+    }
+    parameters.push_back(parameter);
+    bound.push_back(false);
+    return CmdPrepareResult::success;
+}
+
+CmdPrepareResult Statement::bind(uint32_t index, std::string_view value) {
+    if (index >= parameters.size()) {
+        return CmdPrepareResult::syntax_error;
+    }
+    CmdPrepareResult result = set(parameters[index], value);
+    bound[index] = result == CmdPrepareResult::success;
+    return result;
+}
+
+CmdPrepareResult Statement::bind(uint32_t index, uint32_t value) {
+    if (index >= parameters.size()) {
+        return CmdPrepareResult::syntax_error;
+    }
+    bound[index] = true;
+    switch (parameters[index]) {
+        case Parameter::id:
+            row_to_insert.id = value;
+            return CmdPrepareResult::success;
+        case Parameter::key:
+            key_min = key_max = value;
+            return CmdPrepareResult::success;
+        case Parameter::key_min:
+            key_min = value;
+            return CmdPrepareResult::success;
+        case Parameter::key_max:
+            key_max = value;
+            return CmdPrepareResult::success;
+        case Parameter::limit:
+            limit = value;
+            return CmdPrepareResult::success;
+        case Parameter::offset:
+            offset = value;
+            return CmdPrepareResult::success;
+        default:
+            break;
+    }
+    char text[std::numeric_limits<uint32_t>::digits10 + 1];
+    auto [end, error] = std::to_chars(text, text + sizeof(text), value);
+    return bind(index, std::string_view(text, end - text));
+}
+
+uint32_t Statement::num_parameters() const {
+    return parameters.size();
+}
+
+CmdPrepareResult Statement::plan_key_range(const Predicate& where) {
+    /* id = <key> | id between <min> and <max> */
+    if (!iequals(where.column, "id") || where.op == PredicateOp::like) {
+        return CmdPrepareResult::syntax_error;
+    }
+    if (where.op == PredicateOp::eq) {
+        return set(Parameter::key, where.value);
+    }
+    CmdPrepareResult result = set(Parameter::key_min, where.value);
+    if (result != CmdPrepareResult::success) {
+        return result;
+    }
+    return set(Parameter::key_max, where.high);
+}
+
+CmdPrepareResult Statement::plan(const InsertNode& node) {
+    type = StatementType::insert;
+    on_conflict_update = node.on_conflict_update;
+
+    /* One value per column, in row order */
+    const ASTList* value = node.values;
+    CmdPrepareResult result = CmdPrepareResult::success;
+    for (Parameter column :
+         {Parameter::id, Parameter::username, Parameter::email}) {
+        if (!value) {
+            return CmdPrepareResult::syntax_error;
         }
-        if (id < 0 || id > std::numeric_limits<uint32_t>::max()) {
-            return CmdPrepareResult::id_out_of_range;
+        if (result == CmdPrepareResult::success) {
+            result = set(column, value->value);
         }
-        if (std::cin.fail()) {
+        value = value->next;
+    }
+    return value ? CmdPrepareResult::syntax_error : result;
+}
+
+CmdPrepareResult Statement::plan(const UpdateNode& node) {
+    type = StatementType::update;
+
+    for (const Assignment* assignment = node.assignments; assignment;
+         assignment = assignment->next) {
+        Column column;
+        if (!parse_column(assignment->column, column) ||
+            column == Column::id) {
             return CmdPrepareResult::syntax_error;
         }
-        row_to_insert.id = id;
-        strncpy(row_to_insert.username, username.c_str(),
-                sizeof(row_to_insert.username));
-        strncpy(row_to_insert.email, email.c_str(),
-                sizeof(row_to_insert.email));
+        set_username |= column == Column::username;
+        set_email |= column == Column::email;
+        CmdPrepareResult result =
+            set(column == Column::username ? Parameter::username
+                                           : Parameter::email,
+                assignment->value);
+        if (result != CmdPrepareResult::success) {
+            return result;
+        }
+    }
+    return plan_key_range(*node.where);
+}
+
+CmdPrepareResult Statement::plan(const SelectNode& node) {
+    type = StatementType::select;
+    if (!node.join_table.empty()) {
+        return plan_join(node);
+    }
+    if (!node.group_by.empty()) {
+        has_group = true;
+        if (!parse_column(node.group_by, group_column)) {
+            return CmdPrepareResult::syntax_error;
+        }
+    }
+
+    for (const SelectItem* item = node.items; item; item = item->next) {
+        Column column = Column::id;
+        if (!item->column.empty() && !parse_column(item->column, column)) {
+            return CmdPrepareResult::syntax_error;
+        }
+        if (item->function.empty()) {
+            /* Rows are printed whole, so id is the only projection */
+            if (has_group && column == group_column &&
+                group_position == UINT32_MAX) {
+                group_position = aggregates.size();
+            } else if (!has_group && column == Column::id &&
+                       item == node.items && !item->next) {
+                select_id_only = true;
+            } else {
+                return CmdPrepareResult::syntax_error;
+            }
+            continue;
+        }
+
+        AggregateSpec spec{AggregateFunction::count, column};
+        if (!parse_aggregate(item->function, spec.function) ||
+            aggregates.size() == Batch::MAX_AGGREGATES) {
+            return CmdPrepareResult::syntax_error;
+        }
+        /* * only counts, and id is the only numeric column */
+        if (spec.function != AggregateFunction::count &&
+            (item->column.empty() || column != Column::id)) {
+            return CmdPrepareResult::syntax_error;
+        }
+        aggregates.push_back(spec);
+    }
+    if (has_group && !node.items) {
+        return CmdPrepareResult::syntax_error;
+    }
+    count_only = !has_group && aggregates.size() == 1 &&
+                 aggregates[0].function == AggregateFunction::count;
+
+    if (!node.order_by.empty()) {
+        has_order = true;
+        order_descending = node.descending;
+        if (!parse_column(node.order_by, order_column)) {
+            return CmdPrepareResult::syntax_error;
+        }
+        /* Aggregates come out a row per group, so only groups are ordered */
+        if ((has_group || !aggregates.empty()) &&
+            (!has_group || order_column != group_column)) {
+            return CmdPrepareResult::syntax_error;
+        }
+    }
+
+    CmdPrepareResult result = CmdPrepareResult::success;
+    if (const Predicate* where = node.where) {
+        has_where = true;
+        if (!parse_column(where->column, where_column)) {
+            return CmdPrepareResult::syntax_error;
+        }
+        if (where_column == Column::id) {
+            result = plan_key_range(*where);
+        } else if (where->op == PredicateOp::between) {
+            return CmdPrepareResult::syntax_error;
+        } else {
+            result = set(where->op == PredicateOp::like
+                             ? Parameter::where_pattern
+                             : Parameter::where_value,
+                         where->value);
+        }
+        if (result != CmdPrepareResult::success) {
+            return result;
+        }
+    }
+
+    if (node.limit.type != TokenType::end) {
+        result = set(Parameter::limit, node.limit);
+    }
+    if (result == CmdPrepareResult::success &&
+        node.offset.type != TokenType::end) {
+        result = set(Parameter::offset, node.offset);
+    }
+    return result;
+}
+
+/* [<table>.]<column> */
+static bool parse_qualified(std::string_view text, std::string_view& table,
+                            Column& column) {
+    size_t dot = text.find('.');
+    if (dot != std::string_view::npos) {
+        table = text.substr(0, dot);
+        text = text.substr(dot + 1);
+    }
+    return parse_column(text, column);
+}
+
+CmdPrepareResult Statement::plan_join(const SelectNode& node) {
+    has_join = true;
+    join_table = node.join_table;
+
+    /* Whole pairs of rows or their count */
+    if (node.where || !node.group_by.empty() || !node.order_by.empty()) {
+        return CmdPrepareResult::syntax_error;
+    }
+    if (const SelectItem* item = node.items) {
+        if (item->next || !iequals(item->function, "count") ||
+            !item->column.empty()) {
+            return CmdPrepareResult::syntax_error;
+        }
+        count_only = true;
+        aggregates.push_back({AggregateFunction::count, Column::id});
+    }
+
+    /* Either column may come first, as long as its table says so */
+    std::string_view first_table, second_table;
+    Column first, second;
+    if (!parse_qualified(node.join_left, first_table, first) ||
+        !parse_qualified(node.join_right, second_table, second)) {
+        return CmdPrepareResult::syntax_error;
+    }
+    bool swapped = (!first_table.empty() && first_table != node.table) ||
+                   (!second_table.empty() && second_table != node.join_table);
+    if (swapped && ((!first_table.empty() && first_table != node.join_table) ||
+                    (!second_table.empty() && second_table != node.table))) {
+        return CmdPrepareResult::syntax_error;
+    }
+    join_left = swapped ? second : first;
+    join_right = swapped ? first : second;
+
+    CmdPrepareResult result = CmdPrepareResult::success;
+    if (node.limit.type != TokenType::end) {
+        result = set(Parameter::limit, node.limit);
+    }
+    if (result == CmdPrepareResult::success &&
+        node.offset.type != TokenType::end) {
+        result = set(Parameter::offset, node.offset);
+    }
+    return result;
+}
+
+CmdPrepareResult Statement::plan(const CreateIndexNode& node) {
+    type = StatementType::create_index;
+
+    if (!parse_column(node.column, index_column)) {
+        return CmdPrepareResult::syntax_error;
+    }
+    /* create index on <column> [using btree | using hash] */
+    if (!node.method.empty() && !iequals(node.method, "btree") &&
+        !iequals(node.method, "hash")) {
+        return CmdPrepareResult::syntax_error;
+    }
+    index_hash = iequals(node.method, "hash");
+    /* id already has the table's own tree */
+    if (index_column == Column::id && !index_hash) {
+        return CmdPrepareResult::syntax_error;
+    }
+    return CmdPrepareResult::success;
+}
+
+CmdPrepareResult Statement::plan(const CreateTableNode& node) {
+    type = StatementType::create_table;
+    /* The name becomes part of a file name */
+    for (char c : table_name) {
+        if (!isalnum(c) && c != '_') {
+            return CmdPrepareResult::syntax_error;
+        }
+    }
+    if (node.partitions.type == TokenType::end) {
         return CmdPrepareResult::success;
     }
-    if (input.starts_with("select")) {
-        type = StatementType::select;
+
+    CmdPrepareResult result =
+        parse_key(node.partitions.text, partitioning.partitions);
+    if (result != CmdPrepareResult::success) {
+        return result;
+    }
+    partitioning.range = node.range;
+    if (node.range) {
+        result = parse_key(node.range_width.text, partitioning.range_width);
+        if (result != CmdPrepareResult::success) {
+            return result;
+        }
+    }
+    if (partitioning.partitions == 0 ||
+        partitioning.partitions > PartitionedTable::MAX_PARTITIONS ||
+        (node.range && partitioning.range_width == 0)) {
+        return CmdPrepareResult::syntax_error;
+    }
+    return CmdPrepareResult::success;
+}
+
+/* Lowest FILL, at which rewritten leaves already hold a single row */
+static const uint32_t MIN_FILL_PERCENT = 10;
+
+CmdPrepareResult Statement::plan(const VacuumNode& node) {
+    type = StatementType::vacuum;
+    if (node.fill.type == TokenType::end) {
         return CmdPrepareResult::success;
     }
-    return CmdPrepareResult::unrecognized;
+    CmdPrepareResult result = parse_key(node.fill.text, fill_percent);
+    if (result != CmdPrepareResult::success) {
+        return result;
+    }
+    return fill_percent >= MIN_FILL_PERCENT && fill_percent <= 100
+               ? CmdPrepareResult::success
+               : CmdPrepareResult::syntax_error;
 }
 
 ExecuteResult Statement::execute_insert(Table& table) {
     std::unique_lock lock(table.mutex);
-    char* node = table.pager.get(table.root_page_num);
-    uint32_t num_cells = *LeafNode::num_cells(node);
 
     uint32_t key_to_insert = row_to_insert.id;
     Cursor cursor = table.find(key_to_insert);
-    if (cursor.cell_num < num_cells) {
-        uint32_t key_at_index = *LeafNode::key(node, cursor.cell_num);
-        if (key_at_index == key_to_insert) {
+    if (cursor.at_key(key_to_insert)) {
+        if (!on_conflict_update) {
             return ExecuteResult::duplicate_key;
         }
+        /* Same descent, overwrite the cell in place */
+        char* value = cursor.value();
+        Row old_row;
+        old_row.deserialize(value);
+        row_to_insert.serialize(value);
+        table.update(cursor, old_row);
+        return ExecuteResult::success;
     }
 
-    LeafNode::insert(cursor, row_to_insert.id, row_to_insert);
+    table.insert(cursor, row_to_insert);
 
     return ExecuteResult::success;
 }
 
-ExecuteResult Statement::execute_select(Table& table) const {
+void Statement::apply_update(char* value) const {
+    if (set_username) {
+        memcpy(value + Row::USERNAME_OFFSET, row_to_insert.username,
+               Row::USERNAME_SIZE);
+    }
+    if (set_email) {
+        memcpy(value + Row::EMAIL_OFFSET, row_to_insert.email,
+               Row::EMAIL_SIZE);
+    }
+}
+
+ExecuteResult Statement::execute_update(Table& table) {
+    std::unique_lock lock(table.mutex);
+
+    /* Keys are never modified, so cells can be rewritten where they are */
+    Row old_row;
+
+    Cursor cursor = table.lower_bound(key_min);
+    while (!cursor.end_of_table && cursor.key() <= key_max) {
+        char* value = cursor.value();
+        old_row.deserialize(value);
+        apply_update(value);
+        table.update(cursor, old_row);
+        cursor.advance();
+    }
+    return ExecuteResult::success;
+}
+
+ColumnSet Statement::projection() const {
+    return select_id_only ? column_set(Column::id) : ALL_COLUMNS;
+}
+
+bool Statement::key_ordered() const {
+    return !has_order || (order_column == Column::id && !order_descending);
+}
+
+bool Statement::single_row_dropped() const {
+    return offset > 0 || limit == 0;
+}
+
+std::unique_ptr<Operator> Statement::sorted(std::unique_ptr<Operator> scan,
+                                            const Table& table) const {
+    /* Only the first offset + limit rows of the order are ever needed */
+    uint32_t top = offset + std::min(limit, UINT32_MAX - offset);
+    std::unique_ptr<Operator> plan = std::make_unique<SortOperator>(
+        std::move(scan), order_column, order_descending, top,
+        table.work_memory);
+    plan = std::make_unique<LimitOperator>(std::move(plan), offset, limit);
+    return std::make_unique<ProjectOperator>(std::move(plan), projection());
+}
+
+std::unique_ptr<Operator> Statement::finish(std::unique_ptr<Operator> scan,
+                                            const Table& table) const {
+    if (count_only) {
+        return std::make_unique<CountOperator>(std::move(scan));
+    } else if (!key_ordered()) {
+        return sorted(std::move(scan), table);
+    }
+    std::unique_ptr<Operator> plan =
+        std::make_unique<LimitOperator>(std::move(scan), offset, limit);
+    return std::make_unique<ProjectOperator>(std::move(plan), projection());
+}
+
+/* Bytes of a string column up to its NUL */
+static std::string_view text(const char* value, size_t size) {
+    return std::string_view(value, strnlen(value, size));
+}
+
+void Statement::print_row(const Row& row, ResultSink& sink) const {
+    sink.begin_row();
+    sink.value(uint64_t(row.id));
+    if (!select_id_only) {
+        sink.value(text(row.username, sizeof(row.username)));
+        sink.value(text(row.email, sizeof(row.email)));
+    }
+    sink.end_row();
+}
+
+void Statement::print(Operator& plan, ResultSink& sink) const {
+    auto batch = std::make_unique<Batch>();
+    while (plan.next(*batch)) {
+        print(*batch, sink);
+    }
+}
+
+static void print_aggregate(const AggregateValue& value,
+                            AggregateFunction function, ResultSink& sink) {
+    if (value.null) {
+        sink.null();
+    } else if (function == AggregateFunction::avg) {
+        sink.value(value.real);
+    } else {
+        sink.value(value.integer);
+    }
+}
+
+void Statement::print(const Batch& batch, ResultSink& sink) const {
+    for (uint32_t i = 0; i < batch.size; i++) {
+        uint32_t row = batch.selection[i];
+        sink.begin_row();
+        if (batch.columns & AGGREGATE_COLUMN) {
+            uint32_t outputs =
+                aggregates.size() + (group_position != UINT32_MAX);
+            for (uint32_t k = 0, position = 0; position < outputs; position++) {
+                if (position != group_position) {
+                    print_aggregate(batch.aggregate[k][row],
+                                    aggregates[k].function, sink);
+                    k++;
+                } else if (group_column == Column::id) {
+                    sink.value(uint64_t(batch.id[row]));
+                } else {
+                    sink.value(text(batch.column(group_column, row),
+                                    Batch::stride(group_column)));
+                }
+            }
+        } else {
+            sink.value(uint64_t(batch.id[row]));
+            if (batch.columns != column_set(Column::id)) {
+                sink.value(text(batch.username[row], sizeof(batch.username[0])));
+                sink.value(text(batch.email[row], sizeof(batch.email[0])));
+            }
+        }
+        sink.end_row();
+    }
+}
+
+ExecuteResult Statement::execute_aggregate(Table& table,
+                                           ResultSink& sink) const {
+    bool structural = !has_group && (!has_where || where_column == Column::id);
+    for (const AggregateSpec& spec : aggregates) {
+        structural = structural && (spec.function == AggregateFunction::count ||
+                                    spec.function == AggregateFunction::min ||
+                                    spec.function == AggregateFunction::max);
+    }
+
+    if (structural) {
+        /*
+        COUNT, MIN(id) and MAX(id) over the whole table or a key range come
+        from the outermost leaves and the subtree counts, without a scan
+        */
+        uint32_t rows, min = 0, max = 0;
+        if (!has_where) {
+            rows = table.count();
+            table.min_key(min);
+            table.max_key(max);
+        } else {
+            uint32_t begin = table.rank(key_min);
+            uint32_t end = key_max == UINT32_MAX ? table.count()
+                                                 : table.rank(key_max + 1);
+            rows = end > begin ? end - begin : 0;
+            if (rows > 0) {
+                min = table.at(begin).key();
+                max = table.at(end - 1).key();
+            }
+        }
+        if (single_row_dropped()) {
+            return ExecuteResult::success;
+        }
+
+        auto batch = std::make_unique<Batch>();
+        batch->count = batch->size = 1;
+        batch->selection[0] = 0;
+        batch->columns = AGGREGATE_COLUMN;
+        for (uint32_t k = 0; k < aggregates.size(); k++) {
+            AggregateValue& value = batch->aggregate[k][0];
+            value.null = rows == 0 &&
+                         aggregates[k].function != AggregateFunction::count;
+            value.integer =
+                aggregates[k].function == AggregateFunction::count ? rows
+                : aggregates[k].function == AggregateFunction::min ? min
+                                                                    : max;
+        }
+        print(*batch, sink);
+        return ExecuteResult::success;
+    }
+
+    ColumnSet columns = column_set(Column::id);
+    if (has_group) {
+        columns |= column_set(group_column);
+    }
+    std::unique_ptr<Operator> plan;
+    if (has_where && where_column == Column::id) {
+        plan = std::make_unique<ScanOperator>(table, table.lower_bound(key_min),
+                                              key_max, columns);
+    } else {
+        RowFilter filter = has_where ? RowFilter::column(where_column,
+                                                         where_value,
+                                                         where_prefix)
+                                     : RowFilter();
+        if (table.parallelism > 1 && !table.lsm) {
+            plan = std::make_unique<ParallelScanOperator>(
+                table, columns, filter, table.parallelism, false);
+        } else {
+            plan = std::make_unique<ScanOperator>(table, table.start(),
+                                                  UINT32_MAX, columns, filter);
+        }
+    }
+    auto aggregate = std::make_unique<HashAggregateOperator>(
+        std::move(plan), has_group, group_column, aggregates);
+    if (has_order) {
+        aggregate->order_groups(order_descending);
+    }
+    plan = std::make_unique<LimitOperator>(std::move(aggregate), offset,
+                                           limit);
+    print(*plan, sink);
+    return ExecuteResult::success;
+}
+
+ExecuteResult Statement::execute_select(Table& table,
+                                        ResultSink& sink) const {
     std::shared_lock lock(table.mutex);
     Row row;
-    Cursor cursor = table.start();
 
-    while (!cursor.end_of_table) {
-        row.deserialize(cursor.value());
-        std::cout << "(" << row.id << ", " << row.username << ", " << row.email
-                  << ")\n";
-        cursor.advance();
+    if ((!aggregates.empty() && !count_only) || has_group) {
+        return execute_aggregate(table, sink);
+    }
+    if (count_only && single_row_dropped()) {
+        return ExecuteResult::success;
+    }
+
+    if (has_where && where_column == Column::id && key_min == key_max &&
+        !count_only && offset == 0) {
+        /* Point lookup, through the hash index on id when there is one */
+        Cursor cursor = table.find(key_min);
+        if (limit > 0 && cursor.at_key(key_min)) {
+            row.deserialize(cursor.value());
+            print_row(row, sink);
+        }
+        return ExecuteResult::success;
+    }
+
+    /* Scans stop after the rows a key ordered select prints */
+    uint32_t end = offset + std::min(limit, UINT32_MAX - offset);
+    ColumnSet columns = count_only ? 0 : projection();
+    if (!key_ordered()) {
+        columns |= column_set(order_column);
+    }
+
+    if (table.lsm && (!has_where || where_column == Column::id)) {
+        /*
+        Runs keep no subtree counts, so positions would each cost a walk of
+        the merge. The range is scanned from its first key instead.
+        */
+        std::unique_ptr<Operator> plan = std::make_unique<ScanOperator>(
+            table, table.lower_bound(has_where ? key_min : 0),
+            has_where ? key_max : UINT32_MAX, columns, RowFilter(),
+            count_only || !key_ordered() ? UINT32_MAX : end);
+        print(*finish(std::move(plan), table), sink);
+        return ExecuteResult::success;
+    }
+
+    if (!has_where || where_column == Column::id) {
+        /*
+        Key order, so subtree counts give the positions of the range and of
+        the offset without walking the leaves before them
+        */
+        uint32_t begin = has_where ? table.rank(key_min) : 0;
+        uint32_t end = !has_where || key_max == UINT32_MAX
+                           ? table.count()
+                           : table.rank(key_max + 1);
+        if (end < begin) {
+            end = begin;
+        }
+        if (count_only) {
+            sink.begin_row();
+            sink.value(uint64_t(end - begin));
+            sink.end_row();
+            return ExecuteResult::success;
+        }
+
+        std::unique_ptr<Operator> plan;
+        if (key_ordered()) {
+            /* The scan stops at the last row instead of being truncated */
+            begin += std::min(offset, end - begin);
+            end = begin + std::min(limit, end - begin);
+            if (begin == end) {
+                return ExecuteResult::success;
+            }
+            plan = std::make_unique<ScanOperator>(table, table.at(begin),
+                                                  UINT32_MAX, projection(),
+                                                  RowFilter(), end - begin);
+        } else if (order_column == Column::id) {
+            /* Descending key order, the window is known from the positions */
+            end -= std::min(offset, end - begin);
+            begin = end - std::min(limit, end - begin);
+            if (begin == end) {
+                return ExecuteResult::success;
+            }
+            plan = std::make_unique<SortOperator>(
+                std::make_unique<ScanOperator>(table, table.at(begin),
+                                               UINT32_MAX, projection(),
+                                               RowFilter(), end - begin),
+                Column::id, true, UINT32_MAX, table.work_memory);
+        } else {
+            plan = sorted(std::make_unique<ScanOperator>(
+                              table, table.at(begin), UINT32_MAX,
+                              projection() | column_set(order_column),
+                              RowFilter(), end - begin),
+                          table);
+        }
+        print(*plan, sink);
+        return ExecuteResult::success;
+    }
+
+    uint32_t matched = 0;
+    Index* index = table.index(where_column);
+    HashIndex* hash = where_prefix ? nullptr : table.hash_index(where_column);
+    if ((index || hash) && key_ordered()) {
+        std::vector<uint32_t> keys;
+        if (hash) {
+            char key[Row::EMAIL_SIZE];
+            hash->make_key(where_value, key);
+            hash->find(key, keys);
+            std::sort(keys.begin(), keys.end());
+        } else {
+            /* In index order, which is id order only for an equality */
+            index->find(where_value, where_prefix, keys);
+            if (has_order && where_prefix) {
+                std::sort(keys.begin(), keys.end());
+            }
+        }
+        if (count_only) {
+            sink.begin_row();
+            sink.value(uint64_t(keys.size()));
+            sink.end_row();
+            return ExecuteResult::success;
+        }
+        for (; matched < keys.size() && matched < end; matched++) {
+            if (matched < offset) {
+                continue;
+            }
+            if (select_id_only) {
+                /* The primary key is part of the index key */
+                row.id = keys[matched];
+            } else {
+                row.deserialize(table.find(keys[matched]).value());
+            }
+            print_row(row, sink);
+        }
+        return ExecuteResult::success;
+    }
+
+    /* Full scan, the WHERE pushed down onto the cell bytes */
+    RowFilter filter = RowFilter::column(where_column, where_value,
+                                         where_prefix);
+    std::unique_ptr<Operator> plan;
+    if (table.parallelism > 1 && !table.lsm) {
+        /* Counts and sorts do not care which range finishes first */
+        bool ordered = !count_only && key_ordered();
+        plan = std::make_unique<ParallelScanOperator>(
+            table, columns, filter, table.parallelism, ordered,
+            ordered ? end : UINT32_MAX);
+    } else {
+        plan = std::make_unique<ScanOperator>(
+            table, table.start(), UINT32_MAX, columns, filter,
+            count_only || !key_ordered() ? UINT32_MAX : end);
+    }
+    print(*finish(std::move(plan), table), sink);
+    return ExecuteResult::success;
+}
+
+ExecuteResult Statement::execute_select(PartitionedTable& table,
+                                        ResultSink& sink) const {
+    bool by_key = has_where && where_column == Column::id;
+    if (by_key && key_min == key_max) {
+        /* Every row the select can see is in one shard */
+        return execute_select(table.shard(key_min), sink);
+    }
+
+    std::vector<Table*> shards = by_key
+                                     ? table.shards_between(key_min, key_max)
+                                     : table.shards_between(0, UINT32_MAX);
+    /* Writers lock a single shard, so taking these in turn cannot deadlock */
+    std::vector<std::shared_lock<std::shared_mutex>> locks;
+    for (Table* shard : shards) {
+        locks.emplace_back(shard->mutex);
+    }
+
+    bool aggregate = (!aggregates.empty() && !count_only) || has_group;
+    if (count_only && single_row_dropped()) {
+        return ExecuteResult::success;
+    }
+    if (count_only && !aggregate && (!has_where || by_key)) {
+        /* Summed from the subtree counts of the shards */
+        uint64_t rows = 0;
+        for (Table* shard : shards) {
+            uint32_t begin = has_where ? shard->rank(key_min) : 0;
+            uint32_t end = !has_where || key_max == UINT32_MAX
+                               ? shard->count()
+                               : shard->rank(key_max + 1);
+            rows += end > begin ? end - begin : 0;
+        }
+        sink.begin_row();
+        sink.value(rows);
+        sink.end_row();
+        return ExecuteResult::success;
+    }
+
+    ColumnSet columns;
+    if (aggregate) {
+        columns = column_set(Column::id);
+        if (has_group) {
+            columns |= column_set(group_column);
+        }
+    } else {
+        columns = count_only ? 0 : projection();
+        if (!key_ordered()) {
+            columns |= column_set(order_column);
+        }
+    }
+    RowFilter filter = has_where && !by_key
+                           ? RowFilter::column(where_column, where_value,
+                                               where_prefix)
+                           : RowFilter();
+
+    /*
+    Only rows in key order need merging; no shard gives more than the
+    offset and limit of them
+    */
+    bool ordered = !aggregate && !count_only && key_ordered();
+    uint32_t end = offset + std::min(limit, UINT32_MAX - offset);
+    std::vector<std::unique_ptr<Operator>> scans;
+    for (Table* shard : shards) {
+        scans.push_back(std::make_unique<ScanOperator>(
+            *shard, by_key ? shard->lower_bound(key_min) : shard->start(),
+            by_key ? key_max : UINT32_MAX, columns, filter,
+            ordered ? end : UINT32_MAX));
+    }
+    std::unique_ptr<Operator> plan =
+        std::make_unique<MergeOperator>(std::move(scans), ordered);
+
+    if (aggregate) {
+        auto groups = std::make_unique<HashAggregateOperator>(
+            std::move(plan), has_group, group_column, aggregates);
+        if (has_order) {
+            groups->order_groups(order_descending);
+        }
+        plan = std::make_unique<LimitOperator>(std::move(groups), offset,
+                                               limit);
+    } else if (count_only) {
+        plan = std::make_unique<CountOperator>(std::move(plan));
+    } else if (!key_ordered()) {
+        plan = sorted(std::move(plan), *shards[0]);
+    } else {
+        plan = std::make_unique<LimitOperator>(std::move(plan), offset, limit);
+        plan = std::make_unique<ProjectOperator>(std::move(plan),
+                                                 projection());
+    }
+    print(*plan, sink);
+    return ExecuteResult::success;
+}
+
+ExecuteResult Statement::execute_create_index(Table& table) {
+    std::unique_lock lock(table.mutex);
+    if (index_hash) {
+        table.create_hash_index(index_column);
+    } else {
+        table.create_index(index_column);
+    }
+    return ExecuteResult::success;
+}
+
+ExecuteResult Statement::execute_join(Table& left, Table& right,
+                                      ResultSink& sink) const {
+    /*
+    Locked in address order, so joins in opposite directions cannot wait
+    on each other behind a writer
+    */
+    Table* first = std::min(&left, &right, std::less<Table*>());
+    Table* second = std::max(&left, &right, std::less<Table*>());
+    std::shared_lock first_lock(first->mutex);
+    std::shared_lock<std::shared_mutex> second_lock;
+    if (second != first) {
+        second_lock = std::shared_lock(second->mutex);
+    }
+
+    if (count_only && single_row_dropped()) {
+        return ExecuteResult::success;
+    }
+    std::unique_ptr<JoinOperator> join;
+    if (join_left == Column::id && join_right == Column::id) {
+        join = std::make_unique<MergeJoinOperator>(left, right);
+    } else {
+        join = std::make_unique<HashJoinOperator>(left, join_left, right,
+                                                  join_right, left.work_memory);
+    }
+
+    auto left_rows = std::make_unique<Batch>();
+    auto right_rows = std::make_unique<Batch>();
+    uint64_t matched = 0;
+    uint64_t end = uint64_t(offset) + limit;
+    while ((count_only || matched < end) &&
+           join->next(*left_rows, *right_rows)) {
+        if (count_only) {
+            matched += left_rows->size;
+            continue;
+        }
+        for (uint32_t i = 0; i < left_rows->size && matched < end; i++) {
+            if (matched++ < offset) {
+                continue;
+            }
+            uint32_t l = left_rows->selection[i];
+            uint32_t r = right_rows->selection[i];
+            sink.begin_row();
+            for (const Batch* rows : {left_rows.get(), right_rows.get()}) {
+                uint32_t at = rows == left_rows.get() ? l : r;
+                sink.value(uint64_t(rows->id[at]));
+                sink.value(text(rows->username[at], sizeof(rows->username[0])));
+                sink.value(text(rows->email[at], sizeof(rows->email[0])));
+            }
+            sink.end_row();
+        }
+    }
+    if (count_only) {
+        sink.begin_row();
+        sink.value(matched);
+        sink.end_row();
+    }
+    return ExecuteResult::success;
+}
+
+ExecuteResult Statement::execute(Catalog& catalog) {
+    ResultSink sink{stdout};
+    return execute(catalog, sink);
+}
+
+ExecuteResult Statement::execute(Catalog& catalog, ResultSink& sink) {
+    if (std::find(bound.begin(), bound.end(), false) != bound.end()) {
+        return ExecuteResult::unbound_parameter;
+    }
+    /* VACUUM moves rows between pages without changing them */
+    if (catalog.read_only && type != StatementType::select &&
+        type != StatementType::noop && type != StatementType::vacuum) {
+        return ExecuteResult::read_only;
+    }
+    if (type == StatementType::create_table) {
+        return catalog.create(table_name, partitioning)
+                   ? ExecuteResult::success
+                   : ExecuteResult::table_exists;
+    }
+    PartitionedTable* partitioned = catalog.partitioned(table_name);
+    if (has_join) {
+        if (partitioned || catalog.partitioned(join_table)) {
+            return ExecuteResult::partitioned_join;
+        }
+        return execute_join(catalog.table(table_name),
+                            catalog.table(join_table), sink);
+    }
+    if (partitioned) {
+        return execute(*partitioned, sink);
+    }
+    return execute(catalog.table(table_name), sink);
+}
+
+ExecuteResult Statement::execute(PartitionedTable& table, ResultSink& sink) {
+    if (std::find(bound.begin(), bound.end(), false) != bound.end()) {
+        return ExecuteResult::unbound_parameter;
+    }
+    switch (type) {
+        case (StatementType::noop):
+        case (StatementType::create_table):
+            return ExecuteResult::success;
+        case (StatementType::insert):
+            return execute_insert(table.shard(row_to_insert.id));
+        case (StatementType::select):
+            return execute_select(table, sink);
+        case (StatementType::update):
+            for (Table* shard : table.shards_between(key_min, key_max)) {
+                execute_update(*shard);
+            }
+            return ExecuteResult::success;
+        case (StatementType::create_index):
+            for (const auto& shard : table.shards) {
+                execute_create_index(*shard);
+            }
+            return ExecuteResult::success;
+        case (StatementType::vacuum):
+            for (const auto& shard : table.shards) {
+                shard->vacuum(fill_percent);
+            }
+            return ExecuteResult::success;
     }
     return ExecuteResult::success;
 }
 
 ExecuteResult Statement::execute(Table& table) {
+    ResultSink sink{stdout};
+    return execute(table, sink);
+}
+
+ExecuteResult Statement::execute(Table& table, ResultSink& sink) {
+    if (std::find(bound.begin(), bound.end(), false) != bound.end()) {
+        return ExecuteResult::unbound_parameter;
+    }
+    if (has_join) {
+        return execute_join(table, table, sink);
+    }
     switch (type) {
+        case (StatementType::noop):
+        case (StatementType::create_table):
+            return ExecuteResult::success;
         case (StatementType::insert):
             return execute_insert(table);
         case (StatementType::select):
-            return execute_select(table);
+            return execute_select(table, sink);
+        case (StatementType::update):
+            return execute_update(table);
+        case (StatementType::create_index):
+            return execute_create_index(table);
+        case (StatementType::vacuum):
+            table.vacuum(fill_percent);
+            return ExecuteResult::success;
     }
 }
\ No newline at end of file
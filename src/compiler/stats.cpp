@@ -0,0 +1,22 @@
+#include "eggshell/compiler/stats.hpp"
+
+#include "eggshell/compiler/arena.hpp"
+
+StatementScope::StatementScope(Arena& arena, StatementStats& stats)
+    : arena{arena},
+      stats{stats},
+      previous{Arena::current()},
+      previous_count{Arena::heap_object_count()},
+      heap_blocks{arena.heap_blocks()} {
+    Arena::make_current(&arena);
+    Arena::count_heap_objects(&heap_objects);
+}
+
+StatementScope::~StatementScope() {
+    stats.heap_objects = heap_objects.load(std::memory_order_relaxed);
+    stats.arena_blocks = arena.heap_blocks() - heap_blocks;
+    stats.arena_bytes = arena.used();
+    arena.reset();
+    Arena::make_current(previous);
+    Arena::count_heap_objects(previous_count);
+}
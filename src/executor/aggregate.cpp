@@ -0,0 +1,156 @@
+#include "eggshell/executor/aggregate.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+CountOperator::CountOperator(std::unique_ptr<Operator> child)
+    : child{std::move(child)}, done{false} {
+}
+
+bool CountOperator::next(Batch& batch) {
+    if (done) {
+        return false;
+    }
+    uint64_t count = 0;
+    while (child->next(batch)) {
+        count += batch.size;
+    }
+    done = true;
+
+    batch.count = batch.size = 1;
+    batch.selection[0] = 0;
+    batch.aggregate[0][0].null = false;
+    batch.aggregate[0][0].integer = count;
+    batch.columns = AGGREGATE_COLUMN;
+    return true;
+}
+
+HashAggregateOperator::HashAggregateOperator(
+    std::unique_ptr<Operator> child, bool grouped, Column group_column,
+    std::vector<AggregateSpec> aggregates)
+    : child{std::move(child)},
+      grouped{grouped},
+      group_column{group_column},
+      aggregates{std::move(aggregates)},
+      built{false},
+      emitted{0} {
+}
+
+void HashAggregateOperator::build(Batch& batch) {
+    if (!grouped) {
+        keys.emplace_back();
+        groups.emplace_back();
+    }
+
+    std::string key;
+    while (child->next(batch)) {
+        for (uint32_t i = 0; i < batch.size; i++) {
+            uint32_t row = batch.selection[i];
+            uint32_t id = batch.id[row];
+
+            uint32_t position = 0;
+            if (grouped) {
+                if (group_column == Column::id) {
+                    key.assign(reinterpret_cast<const char*>(&id), sizeof(id));
+                } else {
+                    const char* value = batch.column(group_column, row);
+                    key.assign(value,
+                               strnlen(value, Batch::stride(group_column)));
+                }
+                auto [it, inserted] = positions.try_emplace(key, groups.size());
+                if (inserted) {
+                    keys.push_back(key);
+                    groups.emplace_back();
+                }
+                position = it->second;
+            }
+
+            Group& group = groups[position];
+            group.count++;
+            group.sum += id;
+            group.min = std::min(group.min, id);
+            group.max = std::max(group.max, id);
+        }
+    }
+    built = true;
+
+    order.resize(groups.size());
+    for (uint32_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    if (ordered) {
+        /* An id group key is its 4 bytes, so compare it as a number */
+        auto less = [this](uint32_t a, uint32_t b) {
+            if (group_column == Column::id) {
+                uint32_t a_id, b_id;
+                memcpy(&a_id, keys[a].data(), sizeof(a_id));
+                memcpy(&b_id, keys[b].data(), sizeof(b_id));
+                return descending ? a_id > b_id : a_id < b_id;
+            }
+            return descending ? keys[a] > keys[b] : keys[a] < keys[b];
+        };
+        std::sort(order.begin(), order.end(), less);
+    }
+}
+
+void HashAggregateOperator::order_groups(bool descending) {
+    ordered = true;
+    this->descending = descending;
+}
+
+AggregateValue HashAggregateOperator::result(const AggregateSpec& spec,
+                                             const Group& group) {
+    AggregateValue value;
+    value.null = group.count == 0 && spec.function != AggregateFunction::count;
+    switch (spec.function) {
+        case (AggregateFunction::count):
+            value.integer = group.count;
+            break;
+        case (AggregateFunction::sum):
+            value.integer = group.sum;
+            break;
+        case (AggregateFunction::min):
+            value.integer = group.min;
+            break;
+        case (AggregateFunction::max):
+            value.integer = group.max;
+            break;
+        case (AggregateFunction::avg):
+            value.real = group.count ? double(group.sum) / group.count : 0;
+            break;
+    }
+    return value;
+}
+
+bool HashAggregateOperator::next(Batch& batch) {
+    if (!built) {
+        build(batch);
+    }
+
+    batch.count = 0;
+    batch.columns = AGGREGATE_COLUMN;
+    if (grouped) {
+        batch.columns |= column_set(group_column);
+    }
+    for (; emitted < groups.size() && batch.count < Batch::CAPACITY;
+         emitted++) {
+        uint32_t row = batch.count++;
+        uint32_t group = order[emitted];
+        if (grouped) {
+            const std::string& key = keys[group];
+            if (group_column == Column::id) {
+                memcpy(&batch.id[row], key.data(), sizeof(batch.id[row]));
+            } else {
+                char* value = batch.column(group_column, row);
+                memcpy(value, key.data(), key.size());
+                value[key.size()] = '\0';
+            }
+        }
+        for (uint32_t k = 0; k < aggregates.size(); k++) {
+            batch.aggregate[k][row] = result(aggregates[k], groups[group]);
+        }
+        batch.selection[row] = row;
+    }
+    batch.size = batch.count;
+    return batch.size > 0;
+}
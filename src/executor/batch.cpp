@@ -0,0 +1,46 @@
+#include "eggshell/executor/batch.hpp"
+
+#include <cstring>
+
+char* Batch::column(Column column, uint32_t row) {
+    return column == Column::username ? username[row] : email[row];
+}
+
+const char* Batch::column(Column column, uint32_t row) const {
+    return column == Column::username ? username[row] : email[row];
+}
+
+uint32_t Batch::stride(Column column) {
+    return column == Column::username ? sizeof(username[0])
+                                      : sizeof(email[0]);
+}
+
+void Batch::assign(const Batch& other) {
+    columns = other.columns;
+    count = size = other.size;
+    for (uint32_t i = 0; i < size; i++) {
+        selection[i] = i;
+        copy(i, other, other.selection[i]);
+    }
+}
+
+void Batch::copy(uint32_t row, const Batch& other, uint32_t other_row) {
+    id[row] = other.id[other_row];
+    if (other.columns & column_set(Column::username)) {
+        memcpy(username[row], other.username[other_row], sizeof(username[row]));
+    }
+    if (other.columns & column_set(Column::email)) {
+        memcpy(email[row], other.email[other_row], sizeof(email[row]));
+    }
+    if (other.columns & AGGREGATE_COLUMN) {
+        for (uint32_t k = 0; k < MAX_AGGREGATES; k++) {
+            aggregate[k][row] = other.aggregate[k][other_row];
+        }
+    }
+}
+
+void Batch::set(uint32_t row, const Row& value) {
+    id[row] = value.id;
+    memcpy(username[row], value.username, sizeof(username[row]));
+    memcpy(email[row], value.email, sizeof(email[row]));
+}
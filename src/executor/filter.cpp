@@ -0,0 +1,61 @@
+#include "eggshell/executor/filter.hpp"
+
+#include <cstring>
+
+#include "eggshell/executor/rowfilter.hpp"
+
+FilterOperator::FilterOperator(std::unique_ptr<Operator> child,
+                               uint32_t key_min, uint32_t key_max)
+    : child{std::move(child)},
+      column{Column::id},
+      key_min{key_min},
+      key_max{key_max},
+      length{0} {
+}
+
+FilterOperator::FilterOperator(std::unique_ptr<Operator> child, Column column,
+                               std::string value, bool prefix)
+    : child{std::move(child)},
+      column{column},
+      key_min{0},
+      key_max{0},
+      value{std::move(value)},
+      length{uint32_t(this->value.size()) + !prefix} {
+    /* Room for bytes_equal to load whole 16 byte blocks */
+    this->value.resize(this->value.size() + 16);
+}
+
+void FilterOperator::evaluate(Batch& batch) {
+    /* Over every filled row, branch free, so the id loop vectorizes */
+    if (column == Column::id) {
+        uint32_t width = key_max - key_min;
+        for (uint32_t i = 0; i < batch.count; i++) {
+            keep[i] = batch.id[i] - key_min <= width;
+        }
+        return;
+    }
+
+    /* Columns are zero padded, so equality compares the terminator too */
+    const char* values = batch.column(column, 0);
+    uint32_t stride = Batch::stride(column);
+    for (uint32_t i = 0; i < batch.count; i++) {
+        keep[i] = bytes_equal(values + i * stride, value.data(), length);
+    }
+}
+
+bool FilterOperator::next(Batch& batch) {
+    while (child->next(batch)) {
+        evaluate(batch);
+        uint32_t size = 0;
+        for (uint32_t i = 0; i < batch.size; i++) {
+            uint32_t row = batch.selection[i];
+            batch.selection[size] = row;
+            size += keep[row];
+        }
+        batch.size = size;
+        if (size > 0) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,188 @@
+#include "eggshell/executor/hashjoin.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+
+/* Hands every row of table to visit, in key order */
+static void scan_rows(Table& table, const std::function<void(Row&)>& visit) {
+    ScanOperator scan{table, table.start(), UINT32_MAX, ALL_COLUMNS};
+    auto batch = std::make_unique<Batch>();
+    Row row;
+    while (scan.next(*batch)) {
+        for (uint32_t i = 0; i < batch->size; i++) {
+            uint32_t position = batch->selection[i];
+            row.id = batch->id[position];
+            memcpy(row.username, batch->username[position],
+                   sizeof(row.username));
+            memcpy(row.email, batch->email[position], sizeof(row.email));
+            visit(row);
+        }
+    }
+}
+
+HashJoinOperator::HashJoinOperator(Table& left, Column left_column,
+                                   Table& right, Column right_column,
+                                   uint64_t memory_budget)
+    : build_table{left.count() <= right.count() ? left : right},
+      build_column{&build_table == &left ? left_column : right_column},
+      probe_table{&build_table == &left ? right : left},
+      probe_column{&build_table == &left ? right_column : left_column},
+      build_left{&build_table == &left} {
+    uint64_t build_bytes =
+        uint64_t(build_table.count()) * (sizeof(Row) + ROW_OVERHEAD);
+    if (build_bytes > memory_budget) {
+        num_partitions = std::min<uint64_t>(
+            build_bytes / std::max<uint64_t>(memory_budget, 1) + 1,
+            MAX_PARTITIONS);
+        partition_rows(build_table, build_column, build_files);
+        partition_rows(probe_table, probe_column, probe_files);
+    }
+}
+
+HashJoinOperator::~HashJoinOperator() {
+    for (FILE* file : build_files) {
+        fclose(file);
+    }
+    for (FILE* file : probe_files) {
+        fclose(file);
+    }
+}
+
+uint32_t HashJoinOperator::partitions() const {
+    return num_partitions;
+}
+
+void HashJoinOperator::make_key(const Row& row, Column column,
+                                std::string& key) {
+    if (column == Column::id) {
+        char text[16];
+        auto [end, error] = std::to_chars(text, text + sizeof(text), row.id);
+        key.assign(text, end);
+    } else {
+        key.assign(column == Column::username ? row.username : row.email);
+    }
+}
+
+uint32_t HashJoinOperator::partition_of(const std::string& key) const {
+    /* Mixed, so partitions do not line up with the map's own buckets */
+    uint64_t hash = std::hash<std::string>{}(key) * 0x9E3779B97F4A7C15ull;
+    return (hash >> 32) % num_partitions;
+}
+
+void HashJoinOperator::partition_rows(Table& table, Column column,
+                                      std::vector<FILE*>& files) {
+    for (uint32_t i = 0; i < num_partitions; i++) {
+        FILE* file = tmpfile();
+        if (!file) {
+            std::cout << "Unable to create join partition file.\n";
+            exit(EXIT_FAILURE);
+        }
+        files.push_back(file);
+    }
+
+    char value[Row::SIZE];
+    scan_rows(table, [&](Row& row) {
+        make_key(row, column, key);
+        row.serialize(value);
+        if (fwrite(value, Row::SIZE, 1, files[partition_of(key)]) != 1) {
+            std::cout << "Error writing join partition file.\n";
+            exit(EXIT_FAILURE);
+        }
+    });
+    for (FILE* file : files) {
+        rewind(file);
+    }
+}
+
+void HashJoinOperator::load() {
+    matches = {};
+    rows.clear();
+    map.clear();
+    if (num_partitions == 1) {
+        scan_rows(build_table, [this](Row& row) { rows.push_back(row); });
+        probe_scan = std::make_unique<ScanOperator>(
+            probe_table, probe_table.start(), UINT32_MAX, ALL_COLUMNS);
+        probe_rows = std::make_unique<Batch>();
+        probe_position = 0;
+    } else {
+        char value[Row::SIZE];
+        while (fread(value, Row::SIZE, 1, build_files[partition]) == 1) {
+            rows.emplace_back().deserialize(value);
+        }
+    }
+
+    map.reserve(rows.size());
+    for (uint32_t i = 0; i < rows.size(); i++) {
+        make_key(rows[i], build_column, key);
+        map.emplace(key, i);
+    }
+    loaded = true;
+}
+
+bool HashJoinOperator::next_probe() {
+    if (num_partitions > 1) {
+        char value[Row::SIZE];
+        if (fread(value, Row::SIZE, 1, probe_files[partition]) != 1) {
+            return false;
+        }
+        probe_row.deserialize(value);
+        return true;
+    }
+
+    if (probe_position == probe_rows->size) {
+        probe_position = 0;
+        if (!probe_scan->next(*probe_rows)) {
+            return false;
+        }
+    }
+    uint32_t position = probe_rows->selection[probe_position++];
+    probe_row.id = probe_rows->id[position];
+    memcpy(probe_row.username, probe_rows->username[position],
+           sizeof(probe_row.username));
+    memcpy(probe_row.email, probe_rows->email[position],
+           sizeof(probe_row.email));
+    return true;
+}
+
+void HashJoinOperator::emit(Batch& left, Batch& right,
+                            const Row& build_row) {
+    left.set(left.count++, build_left ? build_row : probe_row);
+    right.set(right.count++, build_left ? probe_row : build_row);
+}
+
+bool HashJoinOperator::next(Batch& left, Batch& right) {
+    left.count = right.count = 0;
+    while (left.count < Batch::CAPACITY) {
+        if (matches.first != matches.second) {
+            emit(left, right, rows[matches.first->second]);
+            ++matches.first;
+            continue;
+        }
+        if (!loaded) {
+            if (partition == num_partitions) {
+                break;
+            }
+            load();
+        }
+        if (!next_probe()) {
+            loaded = false;
+            partition++;
+            continue;
+        }
+        make_key(probe_row, probe_column, key);
+        matches = map.equal_range(key);
+    }
+
+    for (Batch* batch : {&left, &right}) {
+        batch->columns = ALL_COLUMNS;
+        for (uint32_t i = 0; i < batch->count; i++) {
+            batch->selection[i] = i;
+        }
+        batch->size = batch->count;
+    }
+    return left.size > 0;
+}
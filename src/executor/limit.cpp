@@ -0,0 +1,26 @@
+#include "eggshell/executor/limit.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+LimitOperator::LimitOperator(std::unique_ptr<Operator> child, uint32_t offset,
+                             uint32_t limit)
+    : child{std::move(child)}, offset{offset}, limit{limit} {
+}
+
+bool LimitOperator::next(Batch& batch) {
+    while (limit > 0 && child->next(batch)) {
+        uint32_t skipped = std::min(offset, batch.size);
+        offset -= skipped;
+        batch.size -= skipped;
+        memmove(batch.selection, batch.selection + skipped,
+                batch.size * sizeof(batch.selection[0]));
+
+        batch.size = std::min(limit, batch.size);
+        limit -= batch.size;
+        if (batch.size > 0) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,61 @@
+#include "eggshell/executor/merge.hpp"
+
+MergeOperator::MergeOperator(std::vector<std::unique_ptr<Operator>> children,
+                             bool ordered)
+    : ordered{ordered} {
+    for (std::unique_ptr<Operator>& child : children) {
+        Input input;
+        input.child = std::move(child);
+        if (ordered) {
+            input.batch = std::make_unique<Batch>();
+        }
+        inputs.push_back(std::move(input));
+    }
+}
+
+void MergeOperator::refill(Input& input) {
+    if (!input.done && input.position == input.batch->size) {
+        input.position = 0;
+        input.done = !input.child->next(*input.batch);
+    }
+}
+
+bool MergeOperator::next(Batch& batch) {
+    if (!ordered) {
+        for (; current < inputs.size(); current++) {
+            if (inputs[current].child->next(batch)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    batch.count = batch.size = 0;
+    while (batch.count < Batch::CAPACITY) {
+        /* A linear pass finds the smallest head, shards being few */
+        Input* smallest = nullptr;
+        uint32_t smallest_key = 0;
+        for (Input& input : inputs) {
+            refill(input);
+            if (input.done) {
+                continue;
+            }
+            const Batch& rows = *input.batch;
+            uint32_t key = rows.id[rows.selection[input.position]];
+            if (!smallest || key < smallest_key) {
+                smallest = &input;
+                smallest_key = key;
+            }
+        }
+        if (!smallest) {
+            break;
+        }
+        const Batch& from = *smallest->batch;
+        batch.columns = from.columns;
+        batch.copy(batch.count, from, from.selection[smallest->position++]);
+        batch.selection[batch.count] = batch.count;
+        batch.count++;
+    }
+    batch.size = batch.count;
+    return batch.size > 0;
+}
@@ -0,0 +1,49 @@
+#include "eggshell/executor/mergejoin.hpp"
+
+MergeJoinOperator::MergeJoinOperator(Table& left, Table& right)
+    : left_scan{left, left.start(), UINT32_MAX, ALL_COLUMNS},
+      right_scan{right, right.start(), UINT32_MAX, ALL_COLUMNS},
+      left_rows{std::make_unique<Batch>()},
+      right_rows{std::make_unique<Batch>()} {
+}
+
+bool MergeJoinOperator::fill(ScanOperator& scan, Batch& rows,
+                             uint32_t& position) {
+    if (position < rows.size) {
+        return true;
+    }
+    position = 0;
+    return scan.next(rows);
+}
+
+bool MergeJoinOperator::next(Batch& left, Batch& right) {
+    left.count = right.count = 0;
+    while (left.count < Batch::CAPACITY &&
+           fill(left_scan, *left_rows, left_position) &&
+           fill(right_scan, *right_rows, right_position)) {
+        uint32_t left_row = left_rows->selection[left_position];
+        uint32_t right_row = right_rows->selection[right_position];
+        uint32_t left_key = left_rows->id[left_row];
+        uint32_t right_key = right_rows->id[right_row];
+        if (left_key < right_key) {
+            left_position++;
+        } else if (right_key < left_key) {
+            right_position++;
+        } else {
+            /* Keys are unique on both sides, so a match pairs exactly once */
+            left.copy(left.count++, *left_rows, left_row);
+            right.copy(right.count++, *right_rows, right_row);
+            left_position++;
+            right_position++;
+        }
+    }
+
+    for (Batch* batch : {&left, &right}) {
+        batch->columns = ALL_COLUMNS;
+        for (uint32_t i = 0; i < batch->count; i++) {
+            batch->selection[i] = i;
+        }
+        batch->size = batch->count;
+    }
+    return left.size > 0;
+}
@@ -0,0 +1,194 @@
+#include "eggshell/executor/parallelscan.hpp"
+
+#include <algorithm>
+
+#include "eggshell/executor/scan.hpp"
+#include "eggshell/executor/threadpool.hpp"
+
+ParallelScanOperator::ParallelScanOperator(Table& table, ColumnSet columns,
+                                           const RowFilter& filter,
+                                           uint32_t parallelism, bool ordered,
+                                           uint32_t max_rows)
+    : table{table},
+      columns{columns},
+      filter{filter},
+      ordered{ordered},
+      max_rows{max_rows},
+      remaining{max_rows} {
+    parallelism = std::max(parallelism, 1u);
+    std::vector<uint32_t> keys = table.split(parallelism * RANGES_PER_WORKER);
+    ranges = std::vector<Range>(keys.size() + 1);
+    for (uint32_t i = 0; i < keys.size(); i++) {
+        ranges[i].key_max = keys[i];
+        ranges[i + 1].key_min = keys[i] + 1;
+    }
+    ranges.back().key_max = UINT32_MAX;
+
+    /* Contiguous runs, so each worker mostly follows one leaf chain */
+    parallelism = std::min<uint32_t>(parallelism, ranges.size());
+    for (uint32_t i = 0; i < parallelism; i++) {
+        workers.push_back(std::make_unique<Worker>());
+        for (uint32_t r = i * ranges.size() / parallelism;
+             !ordered && r < (i + 1) * ranges.size() / parallelism; r++) {
+            workers[i]->ranges.push_back(r);
+        }
+    }
+
+    running = parallelism;
+    /* Batches the workers make count to the statement starting the scan */
+    std::atomic<uint64_t>* count = Arena::heap_object_count();
+    for (uint32_t i = 0; i < parallelism; i++) {
+        ThreadPool::shared().submit([this, i, count] {
+            Arena::count_heap_objects(count);
+            run(i);
+            Arena::count_heap_objects(nullptr);
+        });
+    }
+}
+
+ParallelScanOperator::~ParallelScanOperator() {
+    cancelled = true;
+    std::unique_lock lock(mutex);
+    changed.notify_all();
+    changed.wait(lock, [this] { return running == 0; });
+}
+
+bool ParallelScanOperator::take(uint32_t worker, uint32_t& range) {
+    if (cancelled) {
+        return false;
+    }
+    if (ordered) {
+        range = next_range++;
+        return range < ranges.size();
+    }
+    {
+        Worker& own = *workers[worker];
+        std::lock_guard lock(own.mutex);
+        if (!own.ranges.empty()) {
+            range = own.ranges.front();
+            own.ranges.pop_front();
+            return true;
+        }
+    }
+    for (uint32_t i = 1; i < workers.size(); i++) {
+        Worker& victim = *workers[(worker + i) % workers.size()];
+        std::lock_guard lock(victim.mutex);
+        if (!victim.ranges.empty()) {
+            range = victim.ranges.back();
+            victim.ranges.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ParallelScanOperator::run(uint32_t worker) {
+    uint32_t range;
+    while (take(worker, range)) {
+        scan(range);
+    }
+    std::lock_guard lock(mutex);
+    running--;
+    changed.notify_all();
+}
+
+void ParallelScanOperator::scan(uint32_t range) {
+    Range& bounds = ranges[range];
+    ScanOperator scan(table,
+                      bounds.key_min == 0 ? table.start()
+                                          : table.lower_bound(bounds.key_min),
+                      bounds.key_max, columns, filter, max_rows);
+
+    while (!cancelled) {
+        std::unique_ptr<Batch> batch;
+        {
+            std::lock_guard lock(mutex);
+            if (!spare.empty()) {
+                batch = std::move(spare.back());
+                spare.pop_back();
+            }
+        }
+        if (!batch) {
+            batch = std::make_unique<Batch>();
+        }
+        bool more = scan.next(*batch);
+
+        std::unique_lock lock(mutex);
+        if (!more) {
+            spare.push_back(std::move(batch));
+            break;
+        }
+        if (ordered) {
+            /*
+            Ranges are taken in order by running workers, so the current
+            one is either being scanned or not yet taken, in which case no
+            range is and nobody waits here. Waiting on the consumer cannot
+            leave it waiting on us.
+            */
+            changed.wait(lock, [this, range] {
+                return cancelled || range == current ||
+                       buffered < QUEUE_LIMIT;
+            });
+            bounds.output.push_back(std::move(batch));
+            buffered++;
+        } else {
+            changed.wait(lock, [this] {
+                return cancelled || output.size() < QUEUE_LIMIT;
+            });
+            output.push_back(std::move(batch));
+        }
+        changed.notify_all();
+    }
+
+    std::lock_guard lock(mutex);
+    bounds.done = true;
+    changed.notify_all();
+}
+
+bool ParallelScanOperator::next(Batch& batch) {
+    if (remaining == 0) {
+        return false;
+    }
+    std::unique_ptr<Batch> taken;
+    {
+        std::unique_lock lock(mutex);
+        while (!taken) {
+            std::deque<std::unique_ptr<Batch>>* queue = &output;
+            if (ordered) {
+                if (current == ranges.size()) {
+                    return false;
+                }
+                queue = &ranges[current].output;
+                if (queue->empty() && ranges[current].done) {
+                    current++;
+                    /* The worker on the new current range may go on */
+                    changed.notify_all();
+                    continue;
+                }
+            } else if (output.empty() && running == 0) {
+                return false;
+            }
+            if (queue->empty()) {
+                changed.wait(lock);
+                continue;
+            }
+            taken = std::move(queue->front());
+            queue->pop_front();
+            if (ordered) {
+                buffered--;
+            }
+            changed.notify_all();
+        }
+    }
+
+    batch.assign(*taken);
+    remaining -= std::min(remaining, batch.size);
+    std::lock_guard lock(mutex);
+    spare.push_back(std::move(taken));
+    if (remaining == 0) {
+        /* Nothing more is needed, so the workers stop between batches */
+        cancelled = true;
+        changed.notify_all();
+    }
+    return true;
+}
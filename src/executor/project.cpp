@@ -0,0 +1,14 @@
+#include "eggshell/executor/project.hpp"
+
+ProjectOperator::ProjectOperator(std::unique_ptr<Operator> child,
+                                 ColumnSet columns)
+    : child{std::move(child)}, columns{columns} {
+}
+
+bool ProjectOperator::next(Batch& batch) {
+    if (!child->next(batch)) {
+        return false;
+    }
+    batch.columns &= columns;
+    return true;
+}
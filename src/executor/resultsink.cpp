@@ -0,0 +1,217 @@
+#include "eggshell/executor/resultsink.hpp"
+
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+bool parse_output_format(std::string_view name, OutputFormat& format) {
+    if (name == "text") {
+        format = OutputFormat::text;
+    } else if (name == "csv") {
+        format = OutputFormat::csv;
+    } else if (name == "tsv") {
+        format = OutputFormat::tsv;
+    } else if (name == "binary") {
+        format = OutputFormat::binary;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+ResultSink::ResultSink(FILE* file, OutputFormat format)
+    : format{format}, file{file}, buffer(BUFFER_SIZE) {
+}
+
+ResultSink::ResultSink(std::string& target, OutputFormat format)
+    : format{format}, file{nullptr}, target{&target}, buffer(BUFFER_SIZE) {
+}
+
+ResultSink::~ResultSink() {
+    flush();
+}
+
+void ResultSink::flush() {
+    /* A binary row frame stays until its length is known */
+    size_t complete =
+        in_row && format == OutputFormat::binary ? row_start : used;
+    if (target) {
+        target->append(buffer.data(), complete);
+    } else if (complete > 0 &&
+               fwrite(buffer.data(), 1, complete, file) != complete) {
+        std::cout << "Error writing results.\n";
+        exit(EXIT_FAILURE);
+    }
+    memmove(buffer.data(), buffer.data() + complete, used - complete);
+    used -= complete;
+    row_start = 0;
+}
+
+char* ResultSink::reserve(size_t size) {
+    if (used + size > buffer.size()) {
+        flush();
+        if (used + size > buffer.size()) {
+            buffer.resize(used + size);
+        }
+    }
+    char* start = buffer.data() + used;
+    used += size;
+    return start;
+}
+
+void ResultSink::append(std::string_view bytes) {
+    memcpy(reserve(bytes.size()), bytes.data(), bytes.size());
+}
+
+void ResultSink::separator() {
+    if (values++ == 0) {
+        return;
+    }
+    switch (format) {
+        case (OutputFormat::text):
+            append(", ");
+            break;
+        case (OutputFormat::csv):
+            append(",");
+            break;
+        case (OutputFormat::tsv):
+            append("\t");
+            break;
+        case (OutputFormat::binary):
+            break;
+    }
+}
+
+void ResultSink::begin_row() {
+    values = 0;
+    if (format == OutputFormat::binary) {
+        /* Length and count are filled in by end_row */
+        char* frame = reserve(1 + sizeof(uint32_t) + sizeof(uint16_t));
+        frame[0] = 'R';
+        row_start = frame - buffer.data();
+    } else if (format == OutputFormat::text) {
+        append("(");
+    }
+    in_row = true;
+}
+
+void ResultSink::end_row() {
+    if (format == OutputFormat::binary) {
+        uint32_t length = used - row_start - 1 - sizeof(uint32_t);
+        uint16_t count = values;
+        char* frame = buffer.data() + row_start;
+        memcpy(frame + 1, &length, sizeof(length));
+        memcpy(frame + 1 + sizeof(length), &count, sizeof(count));
+    } else {
+        append(format == OutputFormat::text ? ")\n" : "\n");
+    }
+    in_row = false;
+    rows++;
+}
+
+void ResultSink::value(uint64_t value) {
+    separator();
+    if (format == OutputFormat::binary) {
+        char* start = reserve(1 + sizeof(value));
+        start[0] = 1;
+        memcpy(start + 1, &value, sizeof(value));
+        return;
+    }
+    char* start = reserve(20);
+    auto [end, error] = std::to_chars(start, start + 20, value);
+    used -= start + 20 - end;
+}
+
+void ResultSink::value(double value) {
+    separator();
+    if (format == OutputFormat::binary) {
+        char* start = reserve(1 + sizeof(value));
+        start[0] = 2;
+        memcpy(start + 1, &value, sizeof(value));
+        return;
+    }
+    char* start = reserve(32);
+    auto [end, error] = std::to_chars(start, start + 32, value);
+    used -= start + 32 - end;
+}
+
+void ResultSink::value(std::string_view value) {
+    separator();
+    switch (format) {
+        case (OutputFormat::text):
+            append(value);
+            break;
+        case (OutputFormat::csv):
+            if (value.find_first_of(",\"\r\n") == std::string_view::npos) {
+                append(value);
+                break;
+            }
+            append("\"");
+            for (char c : value) {
+                append(c == '"' ? std::string_view("\"\"")
+                                : std::string_view(&c, 1));
+            }
+            append("\"");
+            break;
+        case (OutputFormat::tsv):
+            if (value.find_first_of("\t\r\n\\") == std::string_view::npos) {
+                append(value);
+                break;
+            }
+            for (char c : value) {
+                switch (c) {
+                    case '\t':
+                        append("\\t");
+                        break;
+                    case '\n':
+                        append("\\n");
+                        break;
+                    case '\r':
+                        append("\\r");
+                        break;
+                    case '\\':
+                        append("\\\\");
+                        break;
+                    default:
+                        append(std::string_view(&c, 1));
+                }
+            }
+            break;
+        case (OutputFormat::binary): {
+            uint32_t length = value.size();
+            char* start = reserve(1 + sizeof(length) + length);
+            start[0] = 3;
+            memcpy(start + 1, &length, sizeof(length));
+            memcpy(start + 1 + sizeof(length), value.data(), length);
+            break;
+        }
+    }
+}
+
+void ResultSink::null() {
+    separator();
+    switch (format) {
+        case (OutputFormat::text):
+            append("NULL");
+            break;
+        case (OutputFormat::csv):
+            break;
+        case (OutputFormat::tsv):
+            append("\\N");
+            break;
+        case (OutputFormat::binary):
+            reserve(1)[0] = 0;
+            break;
+    }
+}
+
+void ResultSink::message(std::string_view text) {
+    if (format == OutputFormat::binary) {
+        uint32_t length = text.size();
+        char* start = reserve(1 + sizeof(length));
+        start[0] = 'M';
+        memcpy(start + 1, &length, sizeof(length));
+    }
+    append(text);
+}
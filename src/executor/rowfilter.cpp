@@ -0,0 +1,24 @@
+#include "eggshell/executor/rowfilter.hpp"
+
+RowFilter::RowFilter()
+    : kind{Kind::all}, key_min{0}, key_max{0}, offset{0}, length{0} {
+}
+
+RowFilter RowFilter::key_range(uint32_t key_min, uint32_t key_max) {
+    RowFilter filter;
+    filter.kind = Kind::key_range;
+    filter.key_min = key_min;
+    filter.key_max = key_max;
+    return filter;
+}
+
+RowFilter RowFilter::column(Column column, std::string_view value,
+                            bool prefix) {
+    RowFilter filter;
+    filter.kind = Kind::bytes;
+    filter.offset = Row::offset(column);
+    filter.length = value.size() + !prefix;
+    memset(filter.pattern, 0, sizeof(filter.pattern));
+    memcpy(filter.pattern, value.data(), value.size());
+    return filter;
+}
@@ -0,0 +1,89 @@
+#include "eggshell/executor/scan.hpp"
+
+#include <cstring>
+
+#include "eggshell/storage/bplus/leafnode.hpp"
+
+ScanOperator::ScanOperator(Table& table, Cursor cursor, uint32_t key_max,
+                           ColumnSet columns, const RowFilter& filter,
+                           uint32_t max_rows)
+    : table{table},
+      cursor{cursor},
+      key_max{key_max},
+      columns{columns},
+      filter{filter},
+      max_rows{max_rows} {
+}
+
+void ScanOperator::copy(Batch& batch, const char* value) {
+    uint32_t row = batch.count++;
+    if (--max_rows == 0) {
+        cursor.end_of_table = true;
+    }
+    memcpy(&batch.id[row], value + Row::ID_OFFSET, Row::ID_SIZE);
+    if (columns & column_set(Column::username)) {
+        memcpy(batch.username[row], value + Row::USERNAME_OFFSET,
+               Row::USERNAME_SIZE);
+    }
+    if (columns & column_set(Column::email)) {
+        memcpy(batch.email[row], value + Row::EMAIL_OFFSET, Row::EMAIL_SIZE);
+    }
+}
+
+bool ScanOperator::next(Batch& batch) {
+    batch.count = 0;
+    batch.columns = columns | column_set(Column::id);
+
+    if (max_rows == 0) {
+        cursor.end_of_table = true;
+    }
+    while (!cursor.end_of_table && batch.count < Batch::CAPACITY) {
+        if (cursor.lsm) {
+            uint32_t key = cursor.key();
+            if (key > key_max) {
+                cursor.end_of_table = true;
+                break;
+            }
+            char* value = cursor.value();
+            if (filter.matches(key, value)) {
+                copy(batch, value);
+            }
+            /* advance() recomputes end_of_table, which copy() may have set */
+            cursor.advance();
+            cursor.end_of_table |= max_rows == 0;
+            continue;
+        }
+
+        /* Whole leaves at a time, one page lookup per leaf */
+        char* node = table.pager.get(cursor.page_num);
+        uint32_t num_cells = *LeafNode::num_cells(node);
+        for (; cursor.cell_num < num_cells && batch.count < Batch::CAPACITY &&
+               !cursor.end_of_table;
+             cursor.cell_num++) {
+            uint32_t key = *LeafNode::key(node, cursor.cell_num);
+            if (key > key_max) {
+                cursor.end_of_table = true;
+                break;
+            }
+            char* value = LeafNode::value(node, cursor.cell_num);
+            if (filter.matches(key, value)) {
+                copy(batch, value);
+            }
+        }
+        if (cursor.cell_num >= num_cells) {
+            uint32_t next_page_num = *LeafNode::next_leaf(node);
+            if (next_page_num == 0) {
+                cursor.end_of_table = true;
+            } else {
+                cursor.page_num = next_page_num;
+                cursor.cell_num = 0;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < batch.count; i++) {
+        batch.selection[i] = i;
+    }
+    batch.size = batch.count;
+    return batch.size > 0;
+}
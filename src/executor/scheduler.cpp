@@ -0,0 +1,110 @@
+#include "eggshell/executor/scheduler.hpp"
+
+#include <unistd.h>
+
+#include <cerrno>
+
+#include "eggshell/storage/ioring.hpp"
+
+namespace {
+
+/* Threads standing in for the ring, each blocked in one pread at a time */
+const uint32_t FALLBACK_READERS = 8;
+
+}  // namespace
+
+Scheduler::Scheduler(uint32_t threads, bool use_io_uring) {
+    if (use_io_uring) {
+        ring = std::make_unique<IoRing>(QUEUE_DEPTH);
+        if (!ring->ok()) {
+            ring.reset();
+        }
+    }
+    if (!ring) {
+        readers = std::make_unique<ThreadPool>(FALLBACK_READERS);
+    }
+    for (uint32_t i = 0; i < threads; i++) {
+        this->threads.emplace_back([this] { work(); });
+    }
+}
+
+Scheduler::~Scheduler() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+bool Scheduler::io_uring() const {
+    return ring != nullptr;
+}
+
+void Scheduler::schedule(std::coroutine_handle<> handle) {
+    {
+        std::lock_guard lock(mutex);
+        queue.push_back(handle);
+    }
+    wake.notify_one();
+}
+
+void Scheduler::read(int fd, char* buffer, size_t size, off_t offset,
+                     ssize_t* result, std::coroutine_handle<> handle) {
+    auto done = [this, result, handle](ssize_t read) {
+        *result = read;
+        schedule(handle);
+    };
+    if (ring) {
+        ring->read(fd, buffer, size, offset, done);
+        return;
+    }
+    readers->submit([fd, buffer, size, offset, done] {
+        ssize_t read = pread(fd, buffer, size, offset);
+        done(read < 0 ? -errno : read);
+    });
+}
+
+void Scheduler::start(std::deque<std::coroutine_handle<>> tasks,
+                      uint32_t in_flight) {
+    std::unique_lock lock(mutex);
+    pending = std::move(tasks);
+    for (; running < in_flight && !pending.empty(); running++) {
+        queue.push_back(pending.front());
+        pending.pop_front();
+    }
+    wake.notify_all();
+    idle.wait(lock, [this] { return running == 0; });
+}
+
+void Scheduler::finished() {
+    std::lock_guard lock(mutex);
+    if (!pending.empty()) {
+        /* The next task takes the finished one's place */
+        queue.push_back(pending.front());
+        pending.pop_front();
+        wake.notify_one();
+        return;
+    }
+    if (--running == 0) {
+        idle.notify_all();
+    }
+}
+
+void Scheduler::work() {
+    while (true) {
+        std::coroutine_handle<> handle;
+        {
+            std::unique_lock lock(mutex);
+            wake.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) {
+                return;
+            }
+            handle = queue.front();
+            queue.pop_front();
+        }
+        handle.resume();
+    }
+}
@@ -0,0 +1,258 @@
+#include "eggshell/executor/sort.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+/* Records read back per run at a time during the merge, at most */
+static const uint32_t MERGE_BLOCK_RECORDS = 1024;
+
+SortOperator::SortOperator(std::unique_ptr<Operator> child, Column column,
+                           bool descending, uint32_t limit,
+                           uint64_t memory_budget)
+    : child{std::move(child)},
+      column{column},
+      descending{descending},
+      limit{limit},
+      memory_budget{memory_budget} {
+}
+
+SortOperator::~SortOperator() {
+    for (Run& run : spilled) {
+        fclose(run.file);
+    }
+}
+
+uint32_t SortOperator::runs() const {
+    return spilled.size();
+}
+
+void SortOperator::layout(ColumnSet child_columns) {
+    columns = child_columns & ALL_COLUMNS;
+    record_size = sizeof(uint32_t);
+    if (columns & column_set(Column::username)) {
+        username_offset = record_size;
+        record_size += Batch::stride(Column::username);
+    }
+    if (columns & column_set(Column::email)) {
+        email_offset = record_size;
+        record_size += Batch::stride(Column::email);
+    }
+    capacity = std::clamp<uint64_t>(memory_budget / record_size, 1, UINT32_MAX);
+    top_k = limit <= capacity;
+    candidate.resize(record_size);
+}
+
+char* SortOperator::record(uint32_t index) {
+    return records.data() + uint64_t(index) * record_size;
+}
+
+void SortOperator::write(char* record, const Batch& batch,
+                         uint32_t row) const {
+    memcpy(record, &batch.id[row], sizeof(uint32_t));
+    if (columns & column_set(Column::username)) {
+        memcpy(record + username_offset, batch.username[row],
+               Batch::stride(Column::username));
+    }
+    if (columns & column_set(Column::email)) {
+        memcpy(record + email_offset, batch.email[row],
+               Batch::stride(Column::email));
+    }
+}
+
+bool SortOperator::less(const char* a, const char* b) const {
+    uint32_t a_id, b_id;
+    memcpy(&a_id, a, sizeof(a_id));
+    memcpy(&b_id, b, sizeof(b_id));
+
+    int compared = 0;
+    if (column == Column::id) {
+        compared = a_id < b_id ? -1 : a_id > b_id;
+    } else {
+        uint32_t offset =
+            column == Column::username ? username_offset : email_offset;
+        compared = strcmp(a + offset, b + offset);
+    }
+    if (compared != 0) {
+        return descending ? compared > 0 : compared < 0;
+    }
+    return a_id < b_id;
+}
+
+void SortOperator::add(const Batch& batch, uint32_t row) {
+    auto worse = [this](uint32_t a, uint32_t b) {
+        return less(record(a), record(b));
+    };
+
+    if (top_k) {
+        /* Max-heap on the sort order, the worst row kept on top */
+        if (order.size() < limit) {
+            uint32_t index = order.size();
+            records.resize(uint64_t(index + 1) * record_size);
+            write(record(index), batch, row);
+            order.push_back(index);
+            std::push_heap(order.begin(), order.end(), worse);
+            return;
+        }
+        write(candidate.data(), batch, row);
+        if (limit == 0 || !less(candidate.data(), record(order.front()))) {
+            return;
+        }
+        std::pop_heap(order.begin(), order.end(), worse);
+        memcpy(record(order.back()), candidate.data(), record_size);
+        std::push_heap(order.begin(), order.end(), worse);
+        return;
+    }
+
+    if (order.size() == capacity) {
+        spill();
+    }
+    uint32_t index = order.size();
+    records.resize(uint64_t(index + 1) * record_size);
+    write(record(index), batch, row);
+    order.push_back(index);
+}
+
+void SortOperator::spill() {
+    std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+        return less(record(a), record(b));
+    });
+
+    FILE* file = tmpfile();
+    if (!file) {
+        std::cout << "Unable to create sort run file.\n";
+        exit(EXIT_FAILURE);
+    }
+    for (uint32_t index : order) {
+        if (fwrite(record(index), record_size, 1, file) != 1) {
+            std::cout << "Error writing sort run file.\n";
+            exit(EXIT_FAILURE);
+        }
+    }
+    rewind(file);
+
+    spilled.push_back(Run{file, uint32_t(order.size())});
+    order.clear();
+    records.clear();
+}
+
+const char* SortOperator::current(const Run& run) const {
+    return run.block + uint64_t(run.position) * record_size;
+}
+
+bool SortOperator::advance(Run& run) {
+    if (++run.position < run.filled) {
+        return true;
+    }
+    if (run.rows_left == 0) {
+        return false;
+    }
+    uint32_t rows = std::min(run.rows_left, run.block_rows);
+    if (fread(run.block, record_size, rows, run.file) != rows) {
+        std::cout << "Error reading sort run file.\n";
+        exit(EXIT_FAILURE);
+    }
+    run.position = 0;
+    run.filled = rows;
+    run.rows_left -= rows;
+    return true;
+}
+
+void SortOperator::build(Batch& batch) {
+    built = true;
+    while (child->next(batch)) {
+        if (record_size == 0) {
+            layout(batch.columns);
+        }
+        for (uint32_t i = 0; i < batch.size; i++) {
+            add(batch, batch.selection[i]);
+        }
+    }
+
+    auto before = [this](uint32_t a, uint32_t b) {
+        return less(record(a), record(b));
+    };
+    if (top_k) {
+        std::sort_heap(order.begin(), order.end(), before);
+        return;
+    }
+    if (spilled.empty()) {
+        std::sort(order.begin(), order.end(), before);
+        return;
+    }
+
+    if (!order.empty()) {
+        spill();
+    }
+    /*
+    The runs' read blocks are slices of the record buffer, which the first
+    spill left at its full size
+    */
+    uint64_t block_records = std::clamp<uint64_t>(
+        capacity / spilled.size(), 1, MERGE_BLOCK_RECORDS);
+    records.resize(block_records * spilled.size() * record_size);
+    for (uint32_t i = 0; i < spilled.size(); i++) {
+        spilled[i].block = record(uint32_t(i * block_records));
+        spilled[i].block_rows = block_records;
+        if (advance(spilled[i])) {
+            merge.push_back(i);
+        }
+    }
+    std::make_heap(merge.begin(), merge.end(), [this](uint32_t a, uint32_t b) {
+        return less(current(spilled[b]), current(spilled[a]));
+    });
+}
+
+void SortOperator::emit(Batch& batch, const char* record) {
+    uint32_t row = batch.count++;
+    memcpy(&batch.id[row], record, sizeof(uint32_t));
+    if (columns & column_set(Column::username)) {
+        memcpy(batch.username[row], record + username_offset,
+               Batch::stride(Column::username));
+    }
+    if (columns & column_set(Column::email)) {
+        memcpy(batch.email[row], record + email_offset,
+               Batch::stride(Column::email));
+    }
+}
+
+bool SortOperator::next(Batch& batch) {
+    if (!built) {
+        build(batch);
+    }
+
+    auto after = [this](uint32_t a, uint32_t b) {
+        return less(current(spilled[b]), current(spilled[a]));
+    };
+    batch.count = 0;
+    batch.columns = columns;
+    while (batch.count < Batch::CAPACITY && emitted < limit) {
+        if (spilled.empty()) {
+            if (emitted == order.size()) {
+                break;
+            }
+            emit(batch, record(order[emitted]));
+        } else {
+            /* Smallest current record of all runs */
+            if (merge.empty()) {
+                break;
+            }
+            std::pop_heap(merge.begin(), merge.end(), after);
+            Run& run = spilled[merge.back()];
+            emit(batch, current(run));
+            if (advance(run)) {
+                std::push_heap(merge.begin(), merge.end(), after);
+            } else {
+                merge.pop_back();
+            }
+        }
+        emitted++;
+    }
+
+    for (uint32_t i = 0; i < batch.count; i++) {
+        batch.selection[i] = i;
+    }
+    batch.size = batch.count;
+    return batch.size > 0;
+}
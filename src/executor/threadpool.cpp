@@ -0,0 +1,53 @@
+#include "eggshell/executor/threadpool.hpp"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(uint32_t threads) {
+    for (uint32_t i = 0; i < threads; i++) {
+        this->threads.emplace_back([this] { run(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool{std::max(std::thread::hardware_concurrency(), 1u)};
+    return pool;
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    wake.notify_one();
+}
+
+uint32_t ThreadPool::size() const {
+    return threads.size();
+}
+
+void ThreadPool::run() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(mutex);
+            wake.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
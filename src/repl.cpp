@@ -1,7 +1,12 @@
+#include <chrono>
 #include <exception>
 #include <iostream>
 #include <eggshell/compiler/metacmd/metacmd.hpp>
+#include <eggshell/compiler/script.hpp>
+#include <eggshell/compiler/session.hpp>
 #include <eggshell/compiler/statement.hpp>
+#include <eggshell/executor/resultsink.hpp>
+#include <eggshell/storage/catalog.hpp>
 #include <eggshell/storage/table.hpp>
 #include <string>
 
@@ -17,6 +22,75 @@ void read_input(std::string& str) {
     }
 }
 
+/*
+Runs every statement of a script without prompts or "Executed." lines.
+Errors go to stderr with the statement's number, and a summary follows
+the run. With stop_on_error the first error ends the script; statements
+before it stay applied, nothing is rolled back. With defer_sync the LSM
+log is synced once at the end instead of after each insert.
+*/
+int run_script(FILE* script, Catalog& catalog, ResultSink& sink,
+               bool stop_on_error, bool defer_sync) {
+    auto started = std::chrono::steady_clock::now();
+    if (defer_sync) {
+        for (Table* table : catalog.tables()) {
+            if (table->lsm) {
+                table->lsm->sync_puts = false;
+            }
+        }
+    }
+
+    ScriptReader reader{script};
+    Session session;
+    std::string input;
+    uint64_t statements = 0;
+    uint64_t errors = 0;
+    while ((!stop_on_error || errors == 0) && reader.next(input)) {
+        statements++;
+        std::string error;
+        if (input[0] == '.') {
+            MetaCmdResult result =
+                do_meta_cmd(input, catalog, sink, session);
+            if (result == MetaCmdResult::exit) {
+                break;
+            } else if (result == MetaCmdResult::unrecognized) {
+                error = "Unrecognized command '" + input + "'.\n";
+            }
+        } else {
+            StatementScope scope{session.arena, session.stats};
+            Statement statement;
+            CmdPrepareResult prepared = session.prepare(input, statement);
+            error = prepare_error(prepared, input);
+            if (prepared == CmdPrepareResult::success) {
+                ExecuteResult result = statement.execute(catalog, sink);
+                if (result != ExecuteResult::success) {
+                    error = execute_message(result);
+                }
+            }
+        }
+        if (!error.empty()) {
+            errors++;
+            sink.flush();
+            std::cerr << "Statement " << statements << ": " << error;
+        }
+    }
+
+    if (defer_sync) {
+        for (Table* table : catalog.tables()) {
+            if (table->lsm) {
+                table->lsm->sync();
+                table->lsm->sync_puts = true;
+            }
+        }
+    }
+    sink.flush();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - started;
+    std::cerr << statements << " statements, " << sink.rows << " rows, "
+              << errors << " errors in " << elapsed.count() << " s\n";
+    return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 int main(int argc, char* argv[]) {
     if (argc < 2) {
         std::cout << "Must supply a database filename.\n";
@@ -24,54 +98,90 @@ int main(int argc, char* argv[]) {
     }
 
     char* filename = argv[1];
-    Table table(filename);
+    Engine engine = Engine::btree;
+    OutputFormat format = OutputFormat::text;
+    bool batch = false;
+    bool stop_on_error = false;
+    bool defer_sync = false;
+    bool wal = false;
+    PagerOptions options;
+    const char* script_filename = nullptr;
+    for (int i = 2; i < argc; i++) {
+        std::string flag = argv[i];
+        if (flag == "--lsm") {
+            engine = Engine::lsm;
+        } else if (flag == "--format" && i + 1 < argc &&
+                   parse_output_format(argv[i + 1], format)) {
+            i++;
+        } else if (flag == "--batch") {
+            batch = true;
+        } else if (flag == "--stop-on-error") {
+            stop_on_error = true;
+        } else if (flag == "--defer-sync") {
+            defer_sync = true;
+        } else if (flag == "--wal") {
+            wal = true;
+        } else if (flag == "--compress") {
+            options.compress = true;
+        } else if (flag == "--direct-io") {
+            options.direct_io = true;
+        } else if (flag == "--huge-pages") {
+            options.huge_pages = true;
+        } else if (flag == "--warm-restart") {
+            options.warm_restart = true;
+        } else if (flag == "-f" && i + 1 < argc) {
+            batch = true;
+            script_filename = argv[++i];
+        } else {
+            std::cout << "Unrecognized option \'" << flag << "\'.\n";
+            exit(EXIT_FAILURE);
+        }
+    }
+    Catalog catalog(filename, engine, wal, options);
+    Session session;
     std::string input;
+    /* Prompts, results and errors, handed to stdout before each read */
+    ResultSink sink(stdout, format);
+
+    if (batch) {
+        FILE* script = script_filename ? fopen(script_filename, "rb") : stdin;
+        if (!script) {
+            std::cout << "Unable to open script.\n";
+            exit(EXIT_FAILURE);
+        }
+        int status =
+            run_script(script, catalog, sink, stop_on_error, defer_sync);
+        if (script != stdin) {
+            fclose(script);
+        }
+        return status;
+    }
 
     while (true) {
-        std::cout << "eggshell > ";
+        sink.message("eggshell > ");
+        sink.flush();
         read_input(input);
         if (input[0] == '.') {
-            switch (do_meta_cmd(input, table)) {
+            switch (do_meta_cmd(input, catalog, sink, session)) {
                 case MetaCmdResult::success:
                     continue;
                 case MetaCmdResult::unrecognized:
-                    std::cout << "Unrecognized command \'" << input << "\'.\n";
+                    sink.message("Unrecognized command '" + input + "'.\n");
                     continue;
                 case MetaCmdResult::exit:
                     break;
             }
             break;
         } else {
+            StatementScope scope{session.arena, session.stats};
             Statement statement;
-            switch (statement.prepare(input)) {
-                case (CmdPrepareResult::success):
-                    break;
-                case (CmdPrepareResult::id_out_of_range):
-                    std::cout << "Id out of range\n";
-                    continue;
-                case (CmdPrepareResult::string_too_long):
-                    std::cout << "String is too long.\n";
-                    continue;
-                case (CmdPrepareResult::syntax_error):
-                    std::cout << "Syntax error. Could not parse statement.\n";
-                    continue;
-                case (CmdPrepareResult::unrecognized):
-                    std::cout << "Unrecognized keyword at start of \'" << input
-                              << "\'.\n";
-                    continue;
-            }
-            switch (statement.execute(table)) {
-                case (ExecuteResult::success):
-                    std::cout << "Executed.\n";
-                    break;
-                case (ExecuteResult::duplicate_key):
-                    std::cout << "Error: Duplicate key.\n";
-                    break;
-                case (ExecuteResult::table_full):
-                    std::cout << "Error: Table full.\n";
-                    break;
+            CmdPrepareResult prepared = session.prepare(input, statement);
+            if (prepared != CmdPrepareResult::success) {
+                sink.message(prepare_error(prepared, input));
+                continue;
             }
+            sink.message(execute_message(statement.execute(catalog, sink)));
         }
     }
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
@@ -0,0 +1,131 @@
+#include <unistd.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <eggshell/server/server.hpp>
+#include <eggshell/storage/catalog.hpp>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace {
+
+/* How often a caught up replica looks for new log records */
+const int REPLICA_POLL_MS = 10;
+
+/*
+How often the cached pages are recorded for a warm restart, so that a
+server that is killed rather than stopped still has a recent set
+*/
+const auto WARM_SET_INTERVAL = std::chrono::seconds(30);
+
+Server* running = nullptr;
+
+void stop(int) {
+    running->stop();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cout << "Must supply a database filename.\n";
+        exit(EXIT_FAILURE);
+    }
+
+    char* filename = argv[1];
+    Engine engine = Engine::btree;
+    std::string listen = "unix:" + std::string(filename) + ".sock";
+    uint32_t workers = std::max(std::thread::hardware_concurrency(), 1u);
+    bool wal = false;
+    PagerOptions options;
+    std::string primary;
+    for (int i = 2; i < argc; i++) {
+        std::string flag = argv[i];
+        if (flag == "--lsm") {
+            engine = Engine::lsm;
+        } else if (flag == "--listen" && i + 1 < argc) {
+            listen = argv[++i];
+        } else if (flag == "--workers" && i + 1 < argc &&
+                   atoi(argv[i + 1]) > 0) {
+            workers = atoi(argv[++i]);
+        } else if (flag == "--wal") {
+            wal = true;
+        } else if (flag == "--compress") {
+            options.compress = true;
+        } else if (flag == "--direct-io") {
+            options.direct_io = true;
+        } else if (flag == "--huge-pages") {
+            options.huge_pages = true;
+        } else if (flag == "--warm-restart") {
+            options.warm_restart = true;
+        } else if (flag == "--replica-of" && i + 1 < argc) {
+            primary = argv[++i];
+        } else {
+            std::cout << "Unrecognized option \'" << flag << "\'.\n";
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    Address address;
+    if (!parse_address(listen, address)) {
+        std::cout << "Invalid address \'" << listen << "\'.\n";
+        exit(EXIT_FAILURE);
+    }
+    Catalog catalog(filename, engine, wal, options);
+    std::unique_ptr<Replica> replica;
+    if (!primary.empty()) {
+        /* Caught up before serving, then kept up by its own thread */
+        replica = std::make_unique<Replica>(catalog, Wal::filename(primary));
+        replica->poll();
+        replica->start(std::chrono::milliseconds(REPLICA_POLL_MS));
+    }
+    Server server{catalog, workers, replica.get()};
+    if (!server.listen(address)) {
+        std::cout << "Unable to listen on " << listen << ": " << strerror(errno)
+                  << "\n";
+        exit(EXIT_FAILURE);
+    }
+
+    std::mutex recorder_mutex;
+    std::condition_variable recorder_wake;
+    bool served = false;
+    std::thread recorder;
+    if (options.warm_restart) {
+        recorder = std::thread{[&] {
+            std::unique_lock lock(recorder_mutex);
+            while (!recorder_wake.wait_for(lock, WARM_SET_INTERVAL,
+                                           [&] { return served; })) {
+                catalog.save_warm_sets();
+            }
+        }};
+    }
+
+    running = &server;
+    signal(SIGINT, stop);
+    signal(SIGTERM, stop);
+    std::cout << "Listening on " << listen << " with " << workers
+              << " workers.\n";
+    server.run();
+    {
+        std::lock_guard lock(recorder_mutex);
+        served = true;
+    }
+    recorder_wake.notify_all();
+    if (recorder.joinable()) {
+        recorder.join();
+    }
+    if (replica) {
+        replica->stop();
+    }
+    std::cout << "Served " << server.requests_served() << " requests on "
+              << server.connections_accepted() << " connections.\n";
+    if (address.unix_socket) {
+        unlink(address.path.c_str());
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,85 @@
+#include "eggshell/server/client.hpp"
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+Client::~Client() {
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+bool Client::connect(const Address& address) {
+    if (address.unix_socket) {
+        sockaddr_un name{};
+        name.sun_family = AF_UNIX;
+        if (address.path.size() >= sizeof(name.sun_path)) {
+            errno = ENAMETOOLONG;
+            return false;
+        }
+        strcpy(name.sun_path, address.path.c_str());
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        return fd >= 0 && ::connect(fd, (sockaddr*)&name, sizeof(name)) == 0;
+    }
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* found;
+    std::string port = std::to_string(address.port);
+    if (getaddrinfo(address.host.c_str(), port.c_str(), &hints, &found)) {
+        errno = EADDRNOTAVAIL;
+        return false;
+    }
+    fd = socket(found->ai_family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    bool connected =
+        fd >= 0 && ::connect(fd, found->ai_addr, found->ai_addrlen) == 0;
+    freeaddrinfo(found);
+    if (connected) {
+        /* Small requests go out at once instead of waiting to coalesce */
+        int on = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    }
+    return connected;
+}
+
+bool Client::send(std::string_view statement) {
+    std::string frame;
+    append_frame(frame, statement);
+    for (size_t sent = 0; sent < frame.size();) {
+        ssize_t written = ::send(fd, frame.data() + sent, frame.size() - sent,
+                                 MSG_NOSIGNAL);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        } else if (written < 0) {
+            return false;
+        }
+        sent += written;
+    }
+    return true;
+}
+
+bool Client::receive(std::string& response) {
+    while (true) {
+        if (size_t size = frame_size(input)) {
+            response.assign(input, sizeof(uint32_t), size - sizeof(uint32_t));
+            input.erase(0, size);
+            return true;
+        }
+        char chunk[1 << 16];
+        ssize_t read = recv(fd, chunk, sizeof(chunk), 0);
+        if (read < 0 && errno == EINTR) {
+            continue;
+        } else if (read <= 0) {
+            return false;
+        }
+        input.append(chunk, read);
+    }
+}
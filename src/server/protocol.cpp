@@ -0,0 +1,67 @@
+#include "eggshell/server/protocol.hpp"
+
+#include <charconv>
+#include <cstring>
+
+void append_frame(std::string& out, std::string_view payload) {
+    uint32_t length = payload.size();
+    out.append((const char*)&length, sizeof(length));
+    out.append(payload);
+}
+
+size_t frame_size(std::string_view bytes) {
+    uint32_t length;
+    if (bytes.size() < sizeof(length)) {
+        return 0;
+    }
+    memcpy(&length, bytes.data(), sizeof(length));
+    size_t size = sizeof(length) + size_t(length);
+    return bytes.size() < size ? 0 : size;
+}
+
+bool parse_response(std::string_view payload, Response& response) {
+    if (payload.empty()) {
+        return false;
+    }
+    response.status = ResponseStatus(payload[0]);
+    response.rows = 0;
+    response.message.clear();
+    for (size_t at = 1; at < payload.size();) {
+        char kind = payload[at];
+        uint32_t length;
+        if (payload.size() - at < 1 + sizeof(length)) {
+            return false;
+        }
+        memcpy(&length, payload.data() + at + 1, sizeof(length));
+        at += 1 + sizeof(length);
+        if (payload.size() - at < length) {
+            return false;
+        }
+        if (kind == 'R') {
+            response.rows++;
+        } else if (kind == 'M') {
+            response.message.assign(payload.data() + at, length);
+        } else {
+            return false;
+        }
+        at += length;
+    }
+    return true;
+}
+
+bool parse_address(std::string_view text, Address& address) {
+    address.unix_socket = text.starts_with("unix:");
+    if (address.unix_socket) {
+        address.path = text.substr(strlen("unix:"));
+        return !address.path.empty();
+    }
+    size_t colon = text.rfind(':');
+    address.host = colon == std::string_view::npos
+                       ? "127.0.0.1"
+                       : std::string(text.substr(0, colon));
+    std::string_view port =
+        colon == std::string_view::npos ? text : text.substr(colon + 1);
+    auto [end, error] =
+        std::from_chars(port.data(), port.data() + port.size(), address.port);
+    return error == std::errc() && end == port.data() + port.size();
+}
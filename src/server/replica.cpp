@@ -0,0 +1,162 @@
+#include "eggshell/server/replica.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <shared_mutex>
+#include <vector>
+
+Replica::Replica(Catalog& catalog, std::string wal_filename)
+    : catalog{catalog},
+      wal_filename{wal_filename},
+      applied_filename{filename(catalog.table("").filename)},
+      reader{wal_filename} {
+    catalog.read_only = true;
+
+    std::ifstream in{applied_filename, std::ios::binary};
+    uint64_t applied_offset, applied_lsn;
+    in.read((char*)&applied_offset, sizeof(applied_offset));
+    in.read((char*)&applied_lsn, sizeof(applied_lsn));
+    std::error_code error;
+    uint64_t size = std::filesystem::file_size(wal_filename, error);
+    if (in && !error && applied_offset <= size) {
+        reader.seek(applied_offset);
+        offset = applied_offset;
+        lsn = applied_lsn;
+        resumed = true;
+    }
+}
+
+Replica::~Replica() {
+    stop();
+}
+
+uint64_t Replica::poll() {
+    WalRecord record;
+    uint64_t applied = 0;
+    while (!stopping && reader.next(record)) {
+        if (resumed && record.lsn != lsn + 1) {
+            /* Not the log checkpointed, so it is applied from its start */
+            resumed = false;
+            reader.seek(0);
+            continue;
+        }
+        resumed = false;
+        apply(record);
+        applied++;
+        {
+            std::lock_guard lock(mutex);
+            lsn = record.lsn;
+            last_time = record.time;
+            offset = reader.offset();
+        }
+        if (++since_checkpoint == CHECKPOINT_RECORDS) {
+            checkpoint();
+        }
+    }
+    return applied;
+}
+
+void Replica::apply(const WalRecord& record) {
+    if (record.type == WalRecordType::create_table) {
+        /* Fails harmlessly when the log is applied again */
+        catalog.create(record.table, record.spec);
+        return;
+    }
+
+    std::vector<Table*> tables;
+    PartitionedTable* partitioned = catalog.partitioned(record.table);
+    if (!partitioned) {
+        tables.push_back(&catalog.table(record.table));
+    } else if (record.type == WalRecordType::put) {
+        tables.push_back(&partitioned->shard(record.row.id));
+    } else {
+        for (const auto& shard : partitioned->shards) {
+            tables.push_back(shard.get());
+        }
+    }
+
+    for (Table* table : tables) {
+        std::unique_lock lock(table->mutex);
+        if (record.type == WalRecordType::create_index) {
+            if (record.hash) {
+                table->create_hash_index(record.column);
+            } else {
+                table->create_index(record.column);
+            }
+            continue;
+        }
+        Row row = record.row;
+        Cursor cursor = table->find(row.id);
+        if (cursor.at_key(row.id)) {
+            Row old_row;
+            old_row.deserialize(cursor.value());
+            row.serialize(cursor.value());
+            table->update(cursor, old_row);
+        } else {
+            table->insert(cursor, row);
+        }
+    }
+}
+
+void Replica::start(std::chrono::milliseconds interval) {
+    follower = std::thread{[this, interval] {
+        std::mutex sleep;
+        std::unique_lock lock(sleep);
+        while (!stopping) {
+            if (poll() == 0) {
+                wake.wait_for(lock, interval,
+                              [this] { return stopping.load(); });
+            }
+        }
+    }};
+}
+
+void Replica::stop() {
+    stopping = true;
+    wake.notify_all();
+    if (follower.joinable()) {
+        follower.join();
+    }
+    checkpoint();
+}
+
+void Replica::checkpoint() {
+    /* Tables first, the offset must not claim records they do not hold */
+    for (Table* table : catalog.tables()) {
+        std::unique_lock lock(table->mutex);
+        table->write_back();
+    }
+    uint64_t applied_offset, applied_lsn;
+    {
+        std::lock_guard lock(mutex);
+        applied_offset = offset;
+        applied_lsn = lsn;
+    }
+    std::string temp_filename = applied_filename + ".tmp";
+    {
+        std::ofstream out{temp_filename, std::ios::binary | std::ios::trunc};
+        out.write((const char*)&applied_offset, sizeof(applied_offset));
+        out.write((const char*)&applied_lsn, sizeof(applied_lsn));
+    }
+    std::filesystem::rename(temp_filename, applied_filename);
+    since_checkpoint = 0;
+}
+
+std::string Replica::filename(const std::string& database) {
+    return database + ".applied";
+}
+
+ReplicationStatus Replica::status() {
+    std::error_code error;
+    uint64_t size = std::filesystem::file_size(wal_filename, error);
+    std::lock_guard lock(mutex);
+    uint64_t behind = !error && size > offset ? size - offset : 0;
+    double lag_ms = 0;
+    if (behind > 0) {
+        auto now = std::chrono::duration_cast<std::chrono::microseconds>(
+                       std::chrono::system_clock::now().time_since_epoch())
+                       .count();
+        lag_ms = last_time > 0 ? (now - last_time) / 1000.0 : 0;
+    }
+    return {lsn, behind, lag_ms};
+}
@@ -0,0 +1,419 @@
+#include "eggshell/server/server.hpp"
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include "eggshell/compiler/metacmd/metacmd.hpp"
+#include "eggshell/compiler/statement.hpp"
+
+namespace {
+
+const int MAX_EVENTS = 64;
+const size_t READ_SIZE = 1 << 16;
+
+void watch(int epoll_fd, int op, int fd, uint32_t events) {
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = fd;
+    if (epoll_ctl(epoll_fd, op, fd, &event) < 0) {
+        std::cout << "Error watching socket: " << strerror(errno) << "\n";
+        exit(EXIT_FAILURE);
+    }
+}
+
+}  // namespace
+
+Server::Server(Catalog& catalog, uint32_t workers, Replica* replica)
+    : catalog{catalog},
+      replica{replica},
+      pool{std::make_unique<ThreadPool>(workers)} {
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd < 0 || wake_fd < 0) {
+        std::cout << "Error creating event loop: " << strerror(errno) << "\n";
+        exit(EXIT_FAILURE);
+    }
+    watch(epoll_fd, EPOLL_CTL_ADD, wake_fd, EPOLLIN);
+}
+
+Server::~Server() {
+    /* Lets running tasks finish, they still wake the loop */
+    pool.reset();
+    for (const auto& [fd, connection] : connections) {
+        close(fd);
+    }
+    if (listen_fd >= 0) {
+        close(listen_fd);
+    }
+    close(wake_fd);
+    close(epoll_fd);
+}
+
+bool Server::listen(const Address& address) {
+    if (address.unix_socket) {
+        sockaddr_un name{};
+        name.sun_family = AF_UNIX;
+        if (address.path.size() >= sizeof(name.sun_path)) {
+            errno = ENAMETOOLONG;
+            return false;
+        }
+        strcpy(name.sun_path, address.path.c_str());
+        listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                           0);
+        /* A socket file left by a previous server would fail the bind */
+        unlink(address.path.c_str());
+        if (listen_fd < 0 ||
+            bind(listen_fd, (sockaddr*)&name, sizeof(name)) < 0) {
+            return false;
+        }
+    } else {
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = AI_PASSIVE;
+        addrinfo* found;
+        std::string port = std::to_string(address.port);
+        if (getaddrinfo(address.host.c_str(), port.c_str(), &hints, &found)) {
+            errno = EADDRNOTAVAIL;
+            return false;
+        }
+        listen_fd = socket(found->ai_family,
+                           SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        int on = 1;
+        bool bound =
+            listen_fd >= 0 &&
+            setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)) ==
+                0 &&
+            bind(listen_fd, found->ai_addr, found->ai_addrlen) == 0;
+        freeaddrinfo(found);
+        if (!bound) {
+            return false;
+        }
+    }
+    if (::listen(listen_fd, SOMAXCONN) < 0) {
+        return false;
+    }
+    watch(epoll_fd, EPOLL_CTL_ADD, listen_fd, EPOLLIN);
+    return true;
+}
+
+void Server::run() {
+    epoll_event events[MAX_EVENTS];
+    while (true) {
+        int count = epoll_wait(epoll_fd, events, MAX_EVENTS, -1);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        } else if (count < 0) {
+            std::cout << "Error waiting for events: " << strerror(errno)
+                      << "\n";
+            exit(EXIT_FAILURE);
+        }
+
+        for (int i = 0; i < count; i++) {
+            int fd = events[i].data.fd;
+            if (fd == listen_fd) {
+                accept_all();
+                continue;
+            }
+            if (fd == wake_fd) {
+                uint64_t wakes;
+                while (read(wake_fd, &wakes, sizeof(wakes)) > 0) {
+                }
+                if (stopping) {
+                    return;
+                }
+                std::vector<std::shared_ptr<Connection>> finished;
+                {
+                    std::lock_guard lock(mutex);
+                    finished.swap(ready);
+                }
+                for (const auto& connection : finished) {
+                    if (connection->fd < 0) {
+                        continue;
+                    }
+                    {
+                        std::lock_guard lock(connection->mutex);
+                        connection->output.append(connection->responses);
+                        connection->responses.clear();
+                    }
+                    write_all(*connection);
+                    close_if_done(*connection);
+                }
+                continue;
+            }
+
+            auto it = connections.find(fd);
+            if (it == connections.end()) {
+                continue;
+            }
+            std::shared_ptr<Connection> connection = it->second;
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                read_all(connection);
+            }
+            if (events[i].events & EPOLLOUT) {
+                write_all(*connection);
+            }
+            close_if_done(*connection);
+        }
+    }
+}
+
+void Server::stop() {
+    /* Only an atomic store and a write, both fine in a signal handler */
+    stopping = true;
+    wake();
+}
+
+uint64_t Server::connections_accepted() const {
+    return accepted;
+}
+
+uint64_t Server::requests_served() const {
+    return served;
+}
+
+void Server::wake() {
+    uint64_t one = 1;
+    if (write(wake_fd, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+        std::cout << "Error waking event loop: " << strerror(errno) << "\n";
+        exit(EXIT_FAILURE);
+    }
+}
+
+void Server::accept_all() {
+    while (true) {
+        int fd = accept4(listen_fd, nullptr, nullptr,
+                         SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0 && (errno == ECONNABORTED || errno == EINTR)) {
+            continue;
+        } else if (fd < 0) {
+            /* EAGAIN once the backlog is empty, or out of fds for now */
+            return;
+        }
+        /* Fails harmlessly on Unix sockets */
+        int on = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+        auto connection = std::make_shared<Connection>();
+        connection->fd = fd;
+        connections[fd] = connection;
+        update_events(*connection);
+        accepted++;
+    }
+}
+
+void Server::read_all(const std::shared_ptr<Connection>& connection) {
+    std::string& input = connection->input;
+    char chunk[READ_SIZE];
+    while (!connection->closing) {
+        ssize_t read = recv(connection->fd, chunk, sizeof(chunk), 0);
+        if (read > 0) {
+            input.append(chunk, read);
+        } else if (read < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else if (read < 0 && errno == EINTR) {
+            continue;
+        } else {
+            connection->closing = true;
+        }
+    }
+    update_events(*connection);
+
+    /* Whole frames become requests, a partial one waits for more input */
+    std::deque<std::string> requests;
+    size_t pos = 0;
+    while (size_t size = frame_size(std::string_view(input).substr(pos))) {
+        requests.emplace_back(input.data() + pos + sizeof(uint32_t),
+                              size - sizeof(uint32_t));
+        pos += size;
+    }
+    input.erase(0, pos);
+    uint32_t length;
+    if (input.size() >= sizeof(length)) {
+        memcpy(&length, input.data(), sizeof(length));
+        if (length > MAX_REQUEST_SIZE) {
+            connection->closing = true;
+            update_events(*connection);
+        }
+    }
+    if (requests.empty()) {
+        return;
+    }
+
+    bool idle;
+    {
+        std::lock_guard lock(connection->mutex);
+        for (std::string& request : requests) {
+            connection->requests.push_back(std::move(request));
+        }
+        idle = !connection->busy;
+        connection->busy = true;
+    }
+    if (idle) {
+        pool->submit([this, connection] { drain(connection); });
+    }
+}
+
+void Server::write_all(Connection& connection) {
+    std::string& output = connection.output;
+    while (connection.output_pos < output.size()) {
+        ssize_t written =
+            send(connection.fd, output.data() + connection.output_pos,
+                 output.size() - connection.output_pos, MSG_NOSIGNAL);
+        if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            /* The rest goes out when the socket has room again */
+            connection.writing = true;
+            update_events(connection);
+            return;
+        } else if (written < 0 && errno == EINTR) {
+            continue;
+        } else if (written < 0) {
+            /* The client is gone, nobody is left to read the rest */
+            connection.closing = true;
+            break;
+        }
+        connection.output_pos += written;
+    }
+    output.clear();
+    connection.output_pos = 0;
+    connection.writing = false;
+    update_events(connection);
+}
+
+void Server::update_events(Connection& connection) {
+    uint32_t events =
+        (connection.closing ? 0 : uint32_t(EPOLLIN | EPOLLRDHUP)) |
+        (connection.writing ? uint32_t(EPOLLOUT) : 0);
+    if (events == connection.events) {
+        return;
+    }
+    int op = connection.events == 0 ? EPOLL_CTL_ADD
+             : events == 0          ? EPOLL_CTL_DEL
+                                    : EPOLL_CTL_MOD;
+    watch(epoll_fd, op, connection.fd, events);
+    connection.events = events;
+}
+
+void Server::close_if_done(Connection& connection) {
+    if (!connection.closing || connection.fd < 0 ||
+        connection.output_pos < connection.output.size()) {
+        return;
+    }
+    {
+        std::lock_guard lock(connection.mutex);
+        if (connection.busy || !connection.responses.empty()) {
+            return;
+        }
+    }
+    close(connection.fd);
+    connections.erase(connection.fd);
+    connection.fd = -1;
+}
+
+void Server::drain(std::shared_ptr<Connection> connection) {
+    std::deque<std::string> requests;
+    std::string responses;
+    while (true) {
+        {
+            std::lock_guard lock(connection->mutex);
+            connection->responses.append(responses);
+            if (connection->requests.empty()) {
+                connection->busy = false;
+                break;
+            }
+            requests.swap(connection->requests);
+        }
+        if (!responses.empty()) {
+            /* Answers so far go out while the next requests run */
+            {
+                std::lock_guard lock(mutex);
+                ready.push_back(connection);
+            }
+            wake();
+            responses.clear();
+        }
+        for (const std::string& request : requests) {
+            execute(*connection, request, responses);
+        }
+        served += requests.size();
+        requests.clear();
+    }
+    {
+        std::lock_guard lock(mutex);
+        ready.push_back(connection);
+    }
+    wake();
+}
+
+void Server::execute(Connection& connection, std::string_view input,
+                     std::string& out) {
+    std::string& response = connection.response;
+    ResultSink& sink = connection.sink;
+    /* Length and status are filled in once the output is known */
+    response.assign(sizeof(uint32_t) + 1, '\0');
+
+    ResponseStatus status = ResponseStatus::error;
+    Session& session = connection.session;
+    if (input == ".replication") {
+        if (replication(sink)) {
+            status = ResponseStatus::ok;
+        } else {
+            sink.message("Error: Replication is not enabled.\n");
+        }
+    } else if (input == ".stats") {
+        print_stats(session.stats, sink);
+        status = ResponseStatus::ok;
+    } else {
+        StatementScope scope{session.arena, session.stats};
+        Statement statement;
+        CmdPrepareResult prepared = input.starts_with('.')
+                                        ? CmdPrepareResult::unrecognized
+                                        : session.prepare(input, statement);
+        if (prepared != CmdPrepareResult::success) {
+            sink.message(prepare_error(prepared, input));
+        } else {
+            ExecuteResult result = statement.execute(catalog, sink);
+            if (result == ExecuteResult::success) {
+                status = ResponseStatus::ok;
+            }
+            sink.message(execute_message(result));
+        }
+    }
+    sink.flush();
+
+    uint32_t length = response.size() - sizeof(length);
+    memcpy(response.data(), &length, sizeof(length));
+    response[sizeof(length)] = char(status);
+    out.append(response);
+}
+
+bool Server::replication(ResultSink& sink) {
+    if (!replica && !catalog.wal()) {
+        return false;
+    }
+    sink.begin_row();
+    if (replica) {
+        ReplicationStatus status = replica->status();
+        sink.value("replica");
+        sink.value(status.lsn);
+        sink.value(status.bytes_behind);
+        sink.value(status.lag_ms);
+    } else {
+        sink.value("primary");
+        sink.value(catalog.wal()->lsn());
+        sink.value(uint64_t(0));
+        sink.value(0.0);
+    }
+    sink.end_row();
+    return true;
+}
@@ -0,0 +1,107 @@
+#include "eggshell/storage/bplus/indexnode.hpp"
+
+#include <cstring>
+
+#include "eggshell/storage/bplus/internalnode.hpp"
+#include "eggshell/storage/bplus/node.hpp"
+#include "eggshell/storage/pager.hpp"
+
+const uint32_t IndexNode::INDEX_NODE_NUM_CELLS_SIZE = sizeof(uint32_t);
+const uint32_t IndexNode::INDEX_NODE_NUM_CELLS_OFFSET =
+    Node::COMMON_NODE_HEADER_SIZE;
+const uint32_t IndexNode::INDEX_NODE_LINK_SIZE = sizeof(uint32_t);
+const uint32_t IndexNode::INDEX_NODE_LINK_OFFSET =
+    INDEX_NODE_NUM_CELLS_OFFSET + INDEX_NODE_NUM_CELLS_SIZE;
+const uint32_t IndexNode::INDEX_NODE_HEADER_SIZE =
+    Node::COMMON_NODE_HEADER_SIZE + INDEX_NODE_NUM_CELLS_SIZE +
+    INDEX_NODE_LINK_SIZE;
+const uint32_t IndexNode::INDEX_NODE_CHILD_SIZE = sizeof(uint32_t);
+
+uint32_t* IndexNode::num_cells(char* node) {
+    return (uint32_t*)(node + INDEX_NODE_NUM_CELLS_OFFSET);
+}
+
+uint32_t* IndexNode::next_leaf(char* node) {
+    return (uint32_t*)(node + INDEX_NODE_LINK_OFFSET);
+}
+
+uint32_t* IndexNode::right_child(char* node) {
+    return (uint32_t*)(node + INDEX_NODE_LINK_OFFSET);
+}
+
+uint32_t IndexNode::leaf_max_cells(uint32_t key_size) {
+    return (Pager::PAGE_SIZE - INDEX_NODE_HEADER_SIZE) / key_size - 1;
+}
+
+uint32_t IndexNode::internal_max_cells(uint32_t key_size) {
+    return (Pager::PAGE_SIZE - INDEX_NODE_HEADER_SIZE) /
+               (INDEX_NODE_CHILD_SIZE + key_size) -
+           1;
+}
+
+char* IndexNode::leaf_key(char* node, uint32_t key_size, uint32_t cell_num) {
+    return node + INDEX_NODE_HEADER_SIZE + cell_num * key_size;
+}
+
+char* IndexNode::internal_cell(char* node, uint32_t key_size,
+                               uint32_t cell_num) {
+    return node + INDEX_NODE_HEADER_SIZE +
+           cell_num * (INDEX_NODE_CHILD_SIZE + key_size);
+}
+
+uint32_t* IndexNode::child(char* node, uint32_t key_size, uint32_t child_num) {
+    if (child_num == *num_cells(node)) {
+        return right_child(node);
+    }
+    return (uint32_t*)internal_cell(node, key_size, child_num);
+}
+
+char* IndexNode::internal_key(char* node, uint32_t key_size,
+                              uint32_t key_num) {
+    return internal_cell(node, key_size, key_num) + INDEX_NODE_CHILD_SIZE;
+}
+
+void IndexNode::init_leaf(char* node) {
+    Node::set_node_type(node, NodeType::leaf);
+    Node::set_node_root(node, false);
+    *num_cells(node) = 0;
+    *next_leaf(node) = 0;
+}
+
+void IndexNode::init_internal(char* node) {
+    Node::set_node_type(node, NodeType::internal);
+    Node::set_node_root(node, false);
+    *num_cells(node) = 0;
+    *right_child(node) = InternalNode::INVALID_PAGE_NUM;
+}
+
+uint32_t IndexNode::leaf_lower_bound(char* node, uint32_t key_size,
+                                     const char* key) {
+    uint32_t min_index = 0;
+    uint32_t one_past_max_index = *num_cells(node);
+    while (min_index != one_past_max_index) {
+        uint32_t index = (min_index + one_past_max_index) / 2;
+        if (memcmp(leaf_key(node, key_size, index), key, key_size) < 0) {
+            min_index = index + 1;
+        } else {
+            one_past_max_index = index;
+        }
+    }
+    return min_index;
+}
+
+uint32_t IndexNode::find_child(char* node, uint32_t key_size,
+                               const char* key) {
+    /* Keys are the max key of the child to their left, as in InternalNode */
+    uint32_t min_index = 0;
+    uint32_t max_index = *num_cells(node);
+    while (min_index != max_index) {
+        uint32_t index = (min_index + max_index) / 2;
+        if (memcmp(internal_key(node, key_size, index), key, key_size) >= 0) {
+            max_index = index;
+        } else {
+            min_index = index + 1;
+        }
+    }
+    return min_index;
+}
@@ -13,17 +13,23 @@ const uint32_t InternalNode::INTERNAL_NODE_NUM_KEYS_OFFSET =
 const uint32_t InternalNode::INTERNAL_NODE_RIGHT_CHILD_SIZE = sizeof(uint32_t);
 const uint32_t InternalNode::INTERNAL_NODE_RIGHT_CHILD_OFFSET =
     INTERNAL_NODE_NUM_KEYS_OFFSET + INTERNAL_NODE_NUM_KEYS_SIZE;
+const uint32_t InternalNode::INTERNAL_NODE_RIGHT_COUNT_SIZE = sizeof(uint32_t);
+const uint32_t InternalNode::INTERNAL_NODE_RIGHT_COUNT_OFFSET =
+    INTERNAL_NODE_RIGHT_CHILD_OFFSET + INTERNAL_NODE_RIGHT_CHILD_SIZE;
 const uint32_t InternalNode::INTERNAL_NODE_HEADER_SIZE =
     Node::COMMON_NODE_HEADER_SIZE + INTERNAL_NODE_NUM_KEYS_SIZE +
-    INTERNAL_NODE_RIGHT_CHILD_SIZE;
+    INTERNAL_NODE_RIGHT_CHILD_SIZE + INTERNAL_NODE_RIGHT_COUNT_SIZE;
 
 /*
  * Internal Node Body Layout
  */
 const uint32_t InternalNode::INTERNAL_NODE_KEY_SIZE = sizeof(uint32_t);
 const uint32_t InternalNode::INTERNAL_NODE_CHILD_SIZE = sizeof(uint32_t);
+/* Subtree sizes make COUNT and OFFSET a single descent */
+const uint32_t InternalNode::INTERNAL_NODE_COUNT_SIZE = sizeof(uint32_t);
 const uint32_t InternalNode::INTERNAL_NODE_CELL_SIZE =
-    INTERNAL_NODE_CHILD_SIZE + INTERNAL_NODE_KEY_SIZE;
+    INTERNAL_NODE_CHILD_SIZE + INTERNAL_NODE_COUNT_SIZE +
+    INTERNAL_NODE_KEY_SIZE;
 const uint32_t InternalNode::INVALID_PAGE_NUM = UINT32_MAX;
 
 /* Keep this small for testing */
@@ -43,7 +49,15 @@ uint32_t* InternalNode::cell(char* node, uint32_t cell_num) {
 }
 
 uint32_t* InternalNode::key(char* node, uint32_t key_num) {
-    return (uint32_t*)((char*)cell(node, key_num) + INTERNAL_NODE_CHILD_SIZE);
+    return (uint32_t*)((char*)cell(node, key_num) + INTERNAL_NODE_CHILD_SIZE +
+                       INTERNAL_NODE_COUNT_SIZE);
+}
+
+uint32_t* InternalNode::child_count(char* node, uint32_t child_num) {
+    if (child_num == *num_keys(node)) {
+        return (uint32_t*)(node + INTERNAL_NODE_RIGHT_COUNT_OFFSET);
+    }
+    return (uint32_t*)((char*)cell(node, child_num) + INTERNAL_NODE_CHILD_SIZE);
 }
 
 void InternalNode::init(char* node) {
@@ -57,6 +71,7 @@ void InternalNode::init(char* node) {
     of the root
     */
     *right_child(node) = INVALID_PAGE_NUM;
+    *child_count(node, 0) = 0;
 }
 
 uint32_t* InternalNode::child(char* node, uint32_t child_num) {
@@ -111,7 +126,10 @@ uint32_t InternalNode::find_child(char* node, uint32_t key) {
 void InternalNode::update_internal_node_key(char* node, uint32_t old_key,
                                             uint32_t new_key) {
     uint32_t old_child_index = find_child(node, old_key);
-    *key(node, old_child_index) = new_key;
+    /* The right child has no key of its own */
+    if (old_child_index < *num_keys(node)) {
+        *key(node, old_child_index) = new_key;
+    }
 }
 
 Cursor InternalNode::find(Table& table, uint32_t page_num, uint32_t key) {
@@ -156,6 +174,7 @@ void InternalNode::insert(Table& table, uint32_t parent_page_num,
     */
     if (right_child_page_num == INVALID_PAGE_NUM) {
         *right_child(parent) = child_page_num;
+        *child_count(parent, 0) = Node::subtree_count(child);
         return;
     }
 
@@ -166,14 +185,18 @@ void InternalNode::insert(Table& table, uint32_t parent_page_num,
     and immediately calling internal_node_split_and_insert has the effect
     of creating a new key at (max_cells + 1) with an uninitialized value
     */
+    uint32_t right_child_count = *child_count(parent, original_num_keys);
     *num_keys(parent) = original_num_keys + 1;
 
     if (child_max_key > Node::get_node_max_key(table.pager, right_child)) {
         /* Replace right child */
         *InternalNode::child(parent, original_num_keys) = right_child_page_num;
+        *child_count(parent, original_num_keys) = right_child_count;
         *key(parent, original_num_keys) =
             Node::get_node_max_key(table.pager, right_child);
         *InternalNode::right_child(parent) = child_page_num;
+        *child_count(parent, original_num_keys + 1) =
+            Node::subtree_count(child);
     } else {
         /* Make room for the new cell */
         for (uint32_t i = original_num_keys; i > index; i--) {
@@ -182,6 +205,7 @@ void InternalNode::insert(Table& table, uint32_t parent_page_num,
             memcpy(destination, source, INTERNAL_NODE_CELL_SIZE);
         }
         *InternalNode::child(parent, index) = child_page_num;
+        *child_count(parent, index) = Node::subtree_count(child);
         *key(parent, index) = child_max_key;
     }
 }
@@ -262,8 +286,10 @@ void InternalNode::internal_node_split_and_insert(Table& table,
     Set child before middle key, which is now the highest key, to be node's
     right child, and decrement number of keys
     */
+    uint32_t moved_count = *child_count(old_node, *old_num_keys - 1);
     *right_child(old_node) = *child(old_node, *old_num_keys - 1);
     (*old_num_keys)--;
+    *child_count(old_node, *old_num_keys) = moved_count;
 
     /*
     Determine which of the two nodes after the split should contain the child to
@@ -281,7 +307,14 @@ void InternalNode::internal_node_split_and_insert(Table& table,
                              Node::get_node_max_key(table.pager, old_node));
 
     if (!splitting_root) {
-        insert(table, *Node::node_parent(old_node), new_page_num);
+        /*
+        Set the parent before inserting; if the parent has to split in turn,
+        it reassigns the pointer to whichever half the new node lands in
+        */
         *Node::node_parent(new_node) = *Node::node_parent(old_node);
+        insert(table, *Node::node_parent(old_node), new_page_num);
     }
+
+    Node::update_counts(table, old_page_num);
+    Node::update_counts(table, new_page_num);
 }
\ No newline at end of file
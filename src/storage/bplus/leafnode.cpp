@@ -100,21 +100,23 @@ void LeafNode::split_and_insert(const Cursor& cursor, uint32_t key,
             memcpy(destination, LeafNode::cell(old_node, i),
                    LeafNode::LEAF_NODE_CELL_SIZE);
         }
+    }
 
-        /* Update cell count on both leaf nodes */
-        *LeafNode::num_cells(old_node) = LeafNode::LEAF_NODE_LEFT_SPLIT_COUNT;
-        *LeafNode::num_cells(new_node) = LeafNode::LEAF_NODE_RIGHT_SPLIT_COUNT;
-        if (Node::is_node_root(old_node)) {
-            return Node::create_new_root(cursor.table, new_page_num);
-        } else {
-            uint32_t parent_page_num = *Node::node_parent(old_node);
-            uint32_t new_max = Node::get_node_max_key(old_node);
-            char* parent = cursor.table.pager.get(parent_page_num);
-
-            InternalNode::update_internal_node_key(parent, old_max, new_max);
-            InternalNode::insert(cursor.table, parent_page_num, new_page_num);
-            return;
-        }
+    /* Update cell count on both leaf nodes */
+    *LeafNode::num_cells(old_node) = LeafNode::LEAF_NODE_LEFT_SPLIT_COUNT;
+    *LeafNode::num_cells(new_node) = LeafNode::LEAF_NODE_RIGHT_SPLIT_COUNT;
+    if (Node::is_node_root(old_node)) {
+        return Node::create_new_root(cursor.table, new_page_num);
+    } else {
+        uint32_t parent_page_num = *Node::node_parent(old_node);
+        uint32_t new_max = Node::get_node_max_key(old_node);
+        char* parent = cursor.table.pager.get(parent_page_num);
+
+        InternalNode::update_internal_node_key(parent, old_max, new_max);
+        InternalNode::insert(cursor.table, parent_page_num, new_page_num);
+        Node::update_counts(cursor.table, cursor.page_num);
+        Node::update_counts(cursor.table, new_page_num);
+        return;
     }
 }
 
@@ -139,6 +141,7 @@ void LeafNode::insert(const Cursor& cursor, uint32_t key, Row& value) {
     *LeafNode::num_cells(node) += 1;
     *LeafNode::key(node, cursor.cell_num) = key;
     value.serialize(LeafNode::value(node, cursor.cell_num));
+    Node::update_counts(cursor.table, cursor.page_num);
 }
 
 Cursor LeafNode::find(Table& table, uint32_t page_num, uint32_t key) {
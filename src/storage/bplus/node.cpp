@@ -93,6 +93,40 @@ void Node::create_new_root(Table& table, uint32_t right_child_page_num) {
     uint32_t left_child_max_key = get_node_max_key(table.pager, left_child);
     *InternalNode::key(root, 0) = left_child_max_key;
     *InternalNode::right_child(root) = right_child_page_num;
+    *InternalNode::child_count(root, 0) = subtree_count(left_child);
+    *InternalNode::child_count(root, 1) = subtree_count(right_child);
     *node_parent(left_child) = table.root_page_num;
     *node_parent(right_child) = table.root_page_num;
+}
+
+uint32_t Node::subtree_count(char* node) {
+    if (get_node_type(node) == NodeType::leaf) {
+        return *LeafNode::num_cells(node);
+    }
+    uint32_t num_keys = *InternalNode::num_keys(node);
+    uint32_t count = 0;
+    for (uint32_t i = 0; i <= num_keys; i++) {
+        count += *InternalNode::child_count(node, i);
+    }
+    return count;
+}
+
+void Node::update_counts(Table& table, uint32_t page_num) {
+    char* node = table.pager.get(page_num);
+    while (!is_node_root(node)) {
+        uint32_t parent_page_num = *node_parent(node);
+        char* parent = table.pager.get(parent_page_num);
+        uint32_t num_keys = *InternalNode::num_keys(parent);
+        for (uint32_t i = 0; i <= num_keys; i++) {
+            uint32_t child_page_num = i == num_keys
+                                          ? *InternalNode::right_child(parent)
+                                          : *InternalNode::cell(parent, i);
+            if (child_page_num == page_num) {
+                *InternalNode::child_count(parent, i) = subtree_count(node);
+                break;
+            }
+        }
+        page_num = parent_page_num;
+        node = parent;
+    }
 }
\ No newline at end of file
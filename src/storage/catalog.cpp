@@ -0,0 +1,170 @@
+#include "eggshell/storage/catalog.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <shared_mutex>
+#include <sstream>
+
+Catalog::Catalog(std::string filename, Engine engine, bool wal,
+                 const PagerOptions& options)
+    : filename{filename},
+      main{std::make_unique<Table>(filename, engine, options)} {
+    if (wal || std::filesystem::exists(Wal::filename(filename))) {
+        log = std::make_unique<Wal>(Wal::filename(filename));
+    }
+    attach(*main, "");
+
+    /* <name> [<partitions> hash | <partitions> range <width>] per line */
+    std::ifstream list{filename + ".catalog"};
+    std::string line;
+    while (std::getline(list, line)) {
+        std::istringstream fields{line};
+        std::string name, scheme;
+        PartitionSpec spec;
+        if (!(fields >> name)) {
+            continue;
+        }
+        if (fields >> spec.partitions >> scheme) {
+            spec.range = scheme == "range";
+            fields >> spec.range_width;
+            auto table = std::make_unique<PartitionedTable>(
+                filename + "." + name, spec, false, this->options());
+            for (const auto& shard : table->shards) {
+                attach(*shard, name);
+            }
+            partitioned_tables[name] = std::move(table);
+        } else {
+            named[name] = std::make_unique<Table>(
+                table_filename(filename, name), Engine::btree,
+                this->options());
+            attach(*named[name], name);
+        }
+    }
+}
+
+PagerOptions Catalog::options() const {
+    PagerOptions options = main->pager.options;
+    options.compress = main->pager.map != nullptr;
+    return options;
+}
+
+void Catalog::attach(Table& table, std::string_view name) {
+    table.wal = log.get();
+    table.name = name;
+}
+
+Wal* Catalog::wal() {
+    return log.get();
+}
+
+std::string Catalog::table_filename(const std::string& filename,
+                                    std::string_view name) {
+    return filename + "." + std::string(name) + ".tbl";
+}
+
+Table& Catalog::table(std::string_view name) {
+    std::lock_guard lock(mutex);
+    auto it = named.find(name);
+    return it == named.end() ? *main : *it->second;
+}
+
+PartitionedTable* Catalog::partitioned(std::string_view name) {
+    std::lock_guard lock(mutex);
+    auto it = partitioned_tables.find(name);
+    return it == partitioned_tables.end() ? nullptr : it->second.get();
+}
+
+bool Catalog::contains(std::string_view name) {
+    std::lock_guard lock(mutex);
+    return named.find(name) != named.end() ||
+           partitioned_tables.find(name) != partitioned_tables.end();
+}
+
+bool Catalog::create(std::string_view name, const PartitionSpec& spec) {
+    std::lock_guard lock(mutex);
+    if (named.find(name) != named.end() ||
+        partitioned_tables.find(name) != partitioned_tables.end()) {
+        return false;
+    }
+    if (log) {
+        /* Ahead of its files and rows, nothing sees the table until unlock */
+        log->create_table(name, spec);
+    }
+
+    std::vector<Table*> tables;
+    if (spec.partitions > 0) {
+        auto table = std::make_unique<PartitionedTable>(
+            filename + "." + std::string(name), spec, true, options());
+        for (const auto& shard : table->shards) {
+            tables.push_back(shard.get());
+        }
+        partitioned_tables.emplace(name, std::move(table));
+    } else {
+        std::string table_file = table_filename(filename, name);
+        std::ofstream{table_file, std::ios::trunc};
+        auto table =
+            std::make_unique<Table>(table_file, Engine::btree, options());
+        tables.push_back(table.get());
+        named.emplace(name, std::move(table));
+    }
+    /* Settings made with meta commands carry over */
+    for (Table* table : tables) {
+        table->parallelism = main->parallelism;
+        table->work_memory = main->work_memory;
+        attach(*table, name);
+    }
+    save();
+    return true;
+}
+
+std::vector<Table*> Catalog::tables() {
+    std::lock_guard lock(mutex);
+    std::vector<Table*> tables{main.get()};
+    for (const auto& [name, table] : named) {
+        tables.push_back(table.get());
+    }
+    for (const auto& [name, table] : partitioned_tables) {
+        for (const auto& shard : table->shards) {
+            tables.push_back(shard.get());
+        }
+    }
+    return tables;
+}
+
+void Catalog::save_warm_sets() {
+    for (Table* table : tables()) {
+        std::shared_lock lock(table->mutex);
+        table->save_warm_set();
+    }
+}
+
+std::vector<std::string> Catalog::names() {
+    std::lock_guard lock(mutex);
+    std::vector<std::string> names;
+    for (const auto& [name, table] : named) {
+        names.push_back(name);
+    }
+    for (const auto& [name, table] : partitioned_tables) {
+        names.push_back(name);
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+void Catalog::save() {
+    std::string list_filename = filename + ".catalog";
+    {
+        std::ofstream list{list_filename + ".tmp", std::ios::trunc};
+        for (const auto& [name, table] : named) {
+            list << name << "\n";
+        }
+        for (const auto& [name, table] : partitioned_tables) {
+            const PartitionSpec& spec = table->spec;
+            list << name << " " << spec.partitions << " "
+                 << (spec.range ? "range " : "hash ") << spec.range_width
+                 << "\n";
+        }
+    }
+    std::filesystem::rename(list_filename + ".tmp", list_filename);
+}
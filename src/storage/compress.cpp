@@ -0,0 +1,161 @@
+#include "eggshell/storage/compress.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const uint32_t MIN_MATCH = 4;
+const uint32_t MAX_OFFSET = 0xFFFF;
+const uint32_t HASH_BITS = 12;
+/* A length nibble of 15 continues in bytes added to it, 255 for more */
+const uint32_t LENGTH_NIBBLE = 15;
+
+uint32_t load32(const char* p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint32_t hash(uint32_t value) {
+    return (value * 2654435761u) >> (32 - HASH_BITS);
+}
+
+/* Appends the bytes of a length past its nibble, false if out is full */
+bool put_length(char* out, uint32_t& op, uint32_t capacity, uint32_t length) {
+    if (length < LENGTH_NIBBLE) {
+        return true;
+    }
+    for (length -= LENGTH_NIBBLE;; length -= 255) {
+        if (op == capacity) {
+            return false;
+        }
+        out[op++] = char(length < 255 ? length : 255);
+        if (length < 255) {
+            return true;
+        }
+    }
+}
+
+/* Literals, then a match unless match_length is 0 */
+bool put_sequence(char* out, uint32_t& op, uint32_t capacity,
+                  const char* literals, uint32_t literal_length,
+                  uint32_t offset, uint32_t match_length) {
+    uint32_t match_nibble = match_length ? match_length - MIN_MATCH : 0;
+    if (op == capacity) {
+        return false;
+    }
+    out[op++] = char(std::min(literal_length, LENGTH_NIBBLE) << 4 |
+                     std::min(match_nibble, LENGTH_NIBBLE));
+    if (!put_length(out, op, capacity, literal_length) ||
+        capacity - op < literal_length) {
+        return false;
+    }
+    memcpy(out + op, literals, literal_length);
+    op += literal_length;
+    if (match_length == 0) {
+        return true;
+    }
+    if (capacity - op < 2) {
+        return false;
+    }
+    out[op++] = char(offset & 0xFF);
+    out[op++] = char(offset >> 8);
+    return put_length(out, op, capacity, match_nibble);
+}
+
+/* Reads the bytes of a length past its nibble, false past the end */
+bool get_length(const char* in, uint32_t& ip, uint32_t size,
+                uint32_t& length) {
+    if (length < LENGTH_NIBBLE) {
+        return true;
+    }
+    uint8_t byte;
+    do {
+        if (ip == size) {
+            return false;
+        }
+        byte = in[ip++];
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+}  // namespace
+
+namespace Compression {
+
+uint32_t compress(const char* in, uint32_t size, char* out,
+                  uint32_t capacity) {
+    /* Last position each hashed 4 bytes were seen at */
+    uint32_t seen[1 << HASH_BITS] = {};
+    uint32_t op = 0;
+    uint32_t anchor = 0;
+    uint32_t pos = 0;
+    while (pos + MIN_MATCH <= size) {
+        uint32_t value = load32(in + pos);
+        uint32_t& slot = seen[hash(value)];
+        uint32_t candidate = slot;
+        slot = pos;
+        if (candidate >= pos || pos - candidate > MAX_OFFSET ||
+            load32(in + candidate) != value) {
+            pos++;
+            continue;
+        }
+        uint32_t length = MIN_MATCH;
+        while (pos + length < size &&
+               in[candidate + length] == in[pos + length]) {
+            length++;
+        }
+        if (!put_sequence(out, op, capacity, in + anchor, pos - anchor,
+                          pos - candidate, length)) {
+            return 0;
+        }
+        pos += length;
+        anchor = pos;
+    }
+    if (!put_sequence(out, op, capacity, in + anchor, size - anchor, 0, 0)) {
+        return 0;
+    }
+    return op;
+}
+
+bool decompress(const char* in, uint32_t size, char* out, uint32_t out_size) {
+    uint32_t ip = 0;
+    uint32_t op = 0;
+    while (ip < size) {
+        uint8_t token = in[ip++];
+        uint32_t literal_length = token >> 4;
+        if (!get_length(in, ip, size, literal_length) ||
+            size - ip < literal_length || out_size - op < literal_length) {
+            return false;
+        }
+        memcpy(out + op, in + ip, literal_length);
+        ip += literal_length;
+        op += literal_length;
+        if (ip == size) {
+            break;
+        }
+
+        if (size - ip < 2) {
+            return false;
+        }
+        uint32_t offset = uint8_t(in[ip]) | uint8_t(in[ip + 1]) << 8;
+        ip += 2;
+        uint32_t match_length = token & LENGTH_NIBBLE;
+        if (!get_length(in, ip, size, match_length)) {
+            return false;
+        }
+        match_length += MIN_MATCH;
+        if (offset == 0 || offset > op || out_size - op < match_length) {
+            return false;
+        }
+        /* Byte by byte, since the match may overlap what it writes */
+        for (uint32_t i = 0; i < match_length; i++, op++) {
+            out[op] = out[op - offset];
+        }
+    }
+    return op == out_size;
+}
+
+}  // namespace Compression
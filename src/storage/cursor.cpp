@@ -1,6 +1,7 @@
 #include "eggshell/storage/cursor.hpp"
 
 #include "eggshell/storage/bplus/leafnode.hpp"
+#include "eggshell/storage/lsm/lsmtree.hpp"
 
 Cursor::Cursor(Table& table, uint32_t page_num, uint32_t cell_num,
                bool end_of_table)
@@ -11,11 +12,27 @@ Cursor::Cursor(Table& table, uint32_t page_num, uint32_t cell_num,
 }
 
 char* Cursor::value() {
+    if (lsm) {
+        return lsm->value();
+    }
     char* page = table.pager.get(page_num);
     return LeafNode::value(page, cell_num);
 }
 
+uint32_t Cursor::key() {
+    if (lsm) {
+        return lsm->key();
+    }
+    char* page = table.pager.get(page_num);
+    return *LeafNode::key(page, cell_num);
+}
+
 void Cursor::advance() {
+    if (lsm) {
+        lsm->next();
+        end_of_table = !lsm->valid();
+        return;
+    }
     char* node = table.pager.get(page_num);
     cell_num += 1;
     if (cell_num >= *LeafNode::num_cells(node)) {
@@ -29,4 +46,13 @@ void Cursor::advance() {
             cell_num = 0;
         }
     }
-}
\ No newline at end of file
+}
+
+bool Cursor::at_key(uint32_t key) {
+    if (lsm) {
+        return lsm->at(key);
+    }
+    char* node = table.pager.get(page_num);
+    return cell_num < *LeafNode::num_cells(node) &&
+           *LeafNode::key(node, cell_num) == key;
+}
@@ -0,0 +1,70 @@
+#include "eggshell/storage/frameslab.hpp"
+
+#include <sys/mman.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+FrameSlab::FrameSlab(size_t frame_size, bool huge_pages)
+    : frame_size{frame_size}, huge_pages{huge_pages} {}
+
+FrameSlab::~FrameSlab() {
+    for (void* region : regions) {
+        munmap(region, REGION_SIZE);
+    }
+}
+
+char* FrameSlab::allocate() {
+    std::lock_guard lock(mutex);
+    if (free_list) {
+        char* frame = free_list;
+        memcpy(&free_list, frame, sizeof(free_list));
+        return frame;
+    }
+    if (next == end) {
+        void* region = MAP_FAILED;
+        if (huge_pages) {
+            region = mmap(nullptr, REGION_SIZE, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            got_huge |= region != MAP_FAILED;
+        }
+        if (region == MAP_FAILED) {
+            region = mmap(nullptr, REGION_SIZE, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (region != MAP_FAILED && huge_pages) {
+                madvise(region, REGION_SIZE, MADV_HUGEPAGE);
+            }
+        }
+        if (region == MAP_FAILED) {
+            std::cout << "Error mapping page frames: " << strerror(errno)
+                      << "\n";
+            exit(EXIT_FAILURE);
+        }
+        regions.push_back(region);
+        next = (char*)region;
+        end = next + REGION_SIZE / frame_size * frame_size;
+    }
+    char* frame = next;
+    next += frame_size;
+    return frame;
+}
+
+void FrameSlab::free(char* frame) {
+    if (frame == nullptr) {
+        return;
+    }
+    std::lock_guard lock(mutex);
+    memcpy(frame, &free_list, sizeof(free_list));
+    free_list = frame;
+}
+
+size_t FrameSlab::mapped() {
+    std::lock_guard lock(mutex);
+    return regions.size() * REGION_SIZE;
+}
+
+bool FrameSlab::huge() {
+    std::lock_guard lock(mutex);
+    return got_huge;
+}
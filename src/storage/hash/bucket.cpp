@@ -0,0 +1,61 @@
+#include "eggshell/storage/hash/bucket.hpp"
+
+#include "eggshell/storage/pager.hpp"
+
+const uint32_t Bucket::HEADER_GLOBAL_DEPTH_OFFSET = 0;
+const uint32_t Bucket::HEADER_NUM_DIRECTORY_PAGES_OFFSET = sizeof(uint32_t);
+const uint32_t Bucket::HEADER_DIRECTORY_PAGES_OFFSET = 2 * sizeof(uint32_t);
+const uint32_t Bucket::HEADER_MAX_DIRECTORY_PAGES =
+    (Pager::PAGE_SIZE - HEADER_DIRECTORY_PAGES_OFFSET) / sizeof(uint32_t);
+
+const uint32_t Bucket::DIRECTORY_ENTRIES_PER_PAGE =
+    Pager::PAGE_SIZE / sizeof(uint32_t);
+
+const uint32_t Bucket::BUCKET_LOCAL_DEPTH_OFFSET = 0;
+const uint32_t Bucket::BUCKET_NUM_ENTRIES_OFFSET = sizeof(uint32_t);
+const uint32_t Bucket::BUCKET_OVERFLOW_OFFSET = 2 * sizeof(uint32_t);
+const uint32_t Bucket::BUCKET_HEADER_SIZE = 3 * sizeof(uint32_t);
+const uint32_t Bucket::VALUE_SIZE = sizeof(uint32_t);
+
+uint32_t* Bucket::global_depth(char* header) {
+    return (uint32_t*)(header + HEADER_GLOBAL_DEPTH_OFFSET);
+}
+
+uint32_t* Bucket::num_directory_pages(char* header) {
+    return (uint32_t*)(header + HEADER_NUM_DIRECTORY_PAGES_OFFSET);
+}
+
+uint32_t* Bucket::directory_page(char* header, uint32_t num) {
+    return (uint32_t*)(header + HEADER_DIRECTORY_PAGES_OFFSET) + num;
+}
+
+uint32_t* Bucket::local_depth(char* bucket) {
+    return (uint32_t*)(bucket + BUCKET_LOCAL_DEPTH_OFFSET);
+}
+
+uint32_t* Bucket::num_entries(char* bucket) {
+    return (uint32_t*)(bucket + BUCKET_NUM_ENTRIES_OFFSET);
+}
+
+uint32_t* Bucket::overflow(char* bucket) {
+    return (uint32_t*)(bucket + BUCKET_OVERFLOW_OFFSET);
+}
+
+uint32_t Bucket::max_entries(uint32_t key_size) {
+    return (Pager::PAGE_SIZE - BUCKET_HEADER_SIZE) / (key_size + VALUE_SIZE);
+}
+
+char* Bucket::entry_key(char* bucket, uint32_t key_size, uint32_t entry_num) {
+    return bucket + BUCKET_HEADER_SIZE + entry_num * (key_size + VALUE_SIZE);
+}
+
+uint32_t* Bucket::entry_value(char* bucket, uint32_t key_size,
+                              uint32_t entry_num) {
+    return (uint32_t*)(entry_key(bucket, key_size, entry_num) + key_size);
+}
+
+void Bucket::init(char* bucket, uint32_t depth) {
+    *local_depth(bucket) = depth;
+    *num_entries(bucket) = 0;
+    *overflow(bucket) = 0;
+}
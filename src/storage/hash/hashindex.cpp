@@ -0,0 +1,253 @@
+#include "eggshell/storage/hash/hashindex.hpp"
+
+#include <cstring>
+
+#include "eggshell/storage/hash/bucket.hpp"
+
+HashIndex::HashIndex(std::string filename, Column column)
+    : pager{filename},
+      column{column},
+      key_size{column == Column::id ? Row::ID_SIZE : Row::size(column)},
+      unique{column == Column::id} {
+    if (pager.num_pages == 0) {
+        /* Header, one directory page and a single bucket of depth 0 */
+        char* header = pager.get(0);
+        *Bucket::global_depth(header) = 0;
+        *Bucket::num_directory_pages(header) = 1;
+        *Bucket::directory_page(header, 0) = 1;
+        *(uint32_t*)pager.get(1) = 2;
+        Bucket::init(pager.get(2), 0);
+    }
+}
+
+HashIndex::~HashIndex() {
+    for (uint32_t i = 0; i < pager.pages.size(); i++) {
+        if (pager.pages[i] == nullptr) continue;
+        pager.flush(i);
+        pager.frames.free(pager.pages[i]);
+        pager.pages[i] = nullptr;
+    }
+    pager.file.close();
+}
+
+std::string HashIndex::filename(const std::string& table_filename,
+                                Column column) {
+    switch (column) {
+        case Column::username:
+            return table_filename + ".username.hash";
+        case Column::email:
+            return table_filename + ".email.hash";
+        default:
+            return table_filename + ".id.hash";
+    }
+}
+
+void HashIndex::make_key(const Row& row, char* key) const {
+    switch (column) {
+        case Column::id:
+            memcpy(key, &row.id, Row::ID_SIZE);
+            break;
+        case Column::username:
+            make_key(row.username, key);
+            break;
+        case Column::email:
+            make_key(row.email, key);
+            break;
+    }
+}
+
+void HashIndex::make_key(const std::string& value, char* key) const {
+    memset(key, 0, key_size);
+    strncpy(key, value.c_str(), key_size - 1);
+}
+
+uint32_t HashIndex::hash(const char* key, uint32_t key_size) {
+    /* FNV-1a, then a murmur finalizer so the low bits are well mixed */
+    uint32_t h = 2166136261u;
+    for (uint32_t i = 0; i < key_size && (i < 4 || key[i]); i++) {
+        h = (h ^ (unsigned char)key[i]) * 16777619u;
+    }
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+    return h;
+}
+
+uint32_t* HashIndex::directory_entry(char* header, uint32_t index) {
+    uint32_t page_num = *Bucket::directory_page(
+        header, index / Bucket::DIRECTORY_ENTRIES_PER_PAGE);
+    return (uint32_t*)pager.get(page_num) +
+           index % Bucket::DIRECTORY_ENTRIES_PER_PAGE;
+}
+
+uint32_t HashIndex::bucket_for(uint32_t hash) {
+    char* header = pager.get(0);
+    uint32_t global_depth = *Bucket::global_depth(header);
+    return *directory_entry(header, hash & ((1u << global_depth) - 1));
+}
+
+void HashIndex::find(const char* key, std::vector<uint32_t>& values) {
+    uint32_t page_num = bucket_for(hash(key, key_size));
+    while (page_num != 0) {
+        char* bucket = pager.get(page_num);
+        uint32_t num_entries = *Bucket::num_entries(bucket);
+        for (uint32_t i = 0; i < num_entries; i++) {
+            if (memcmp(Bucket::entry_key(bucket, key_size, i), key,
+                       key_size) == 0) {
+                values.push_back(*Bucket::entry_value(bucket, key_size, i));
+            }
+        }
+        page_num = *Bucket::overflow(bucket);
+    }
+}
+
+void HashIndex::insert(const char* key, uint32_t value) {
+    uint32_t h = hash(key, key_size);
+
+    if (unique) {
+        for (uint32_t page_num = bucket_for(h); page_num != 0;) {
+            char* bucket = pager.get(page_num);
+            uint32_t num_entries = *Bucket::num_entries(bucket);
+            for (uint32_t i = 0; i < num_entries; i++) {
+                if (memcmp(Bucket::entry_key(bucket, key_size, i), key,
+                           key_size) == 0) {
+                    *Bucket::entry_value(bucket, key_size, i) = value;
+                    return;
+                }
+            }
+            page_num = *Bucket::overflow(bucket);
+        }
+    }
+
+    while (true) {
+        uint32_t bucket_page_num = bucket_for(h);
+        char* bucket = pager.get(bucket_page_num);
+        uint32_t num_entries = *Bucket::num_entries(bucket);
+        if (num_entries < Bucket::max_entries(key_size) ||
+            *Bucket::overflow(bucket) != 0) {
+            break;
+        }
+
+        /*
+        A full bucket is split, unless it is at the maximum depth or every
+        entry has the same hash as the new key; then it overflows
+        */
+        bool separable = false;
+        for (uint32_t i = 0; i < num_entries && !separable; i++) {
+            separable =
+                hash(Bucket::entry_key(bucket, key_size, i), key_size) != h;
+        }
+        uint32_t local_depth = *Bucket::local_depth(bucket);
+        if (!separable || local_depth >= MAX_GLOBAL_DEPTH) {
+            break;
+        }
+        if (local_depth == *Bucket::global_depth(pager.get(0))) {
+            double_directory();
+        }
+        split(bucket_page_num, h);
+    }
+    append(bucket_for(h), key, value);
+}
+
+void HashIndex::append(uint32_t bucket_page_num, const char* key,
+                       uint32_t value) {
+    /* Into the first page of the chain with room, or a new overflow page */
+    char* bucket = pager.get(bucket_page_num);
+    while (*Bucket::num_entries(bucket) >= Bucket::max_entries(key_size)) {
+        uint32_t overflow_page_num = *Bucket::overflow(bucket);
+        if (overflow_page_num == 0) {
+            overflow_page_num = pager.get_unused_page_num();
+            *Bucket::overflow(bucket) = overflow_page_num;
+            Bucket::init(pager.get(overflow_page_num),
+                         *Bucket::local_depth(bucket));
+        }
+        bucket = pager.get(overflow_page_num);
+    }
+
+    uint32_t num_entries = *Bucket::num_entries(bucket);
+    memcpy(Bucket::entry_key(bucket, key_size, num_entries), key, key_size);
+    *Bucket::entry_value(bucket, key_size, num_entries) = value;
+    *Bucket::num_entries(bucket) = num_entries + 1;
+}
+
+void HashIndex::double_directory() {
+    char* header = pager.get(0);
+    uint32_t global_depth = *Bucket::global_depth(header);
+    uint32_t size = 1u << global_depth;
+
+    uint32_t pages_needed =
+        (2 * size + Bucket::DIRECTORY_ENTRIES_PER_PAGE - 1) /
+        Bucket::DIRECTORY_ENTRIES_PER_PAGE;
+    while (*Bucket::num_directory_pages(header) < pages_needed) {
+        uint32_t num = *Bucket::num_directory_pages(header);
+        *Bucket::directory_page(header, num) = pager.get_unused_page_num();
+        pager.get(*Bucket::directory_page(header, num));
+        *Bucket::num_directory_pages(header) = num + 1;
+    }
+
+    /* The upper half mirrors the lower half */
+    for (uint32_t i = 0; i < size; i++) {
+        *directory_entry(header, size + i) = *directory_entry(header, i);
+    }
+    *Bucket::global_depth(header) = global_depth + 1;
+}
+
+void HashIndex::split(uint32_t bucket_page_num, uint32_t h) {
+    char* bucket = pager.get(bucket_page_num);
+    uint32_t local_depth = *Bucket::local_depth(bucket);
+    char* header = pager.get(0);
+    uint32_t global_depth = *Bucket::global_depth(header);
+    uint32_t high_bit = 1u << local_depth;
+
+    uint32_t new_page_num = pager.get_unused_page_num();
+    char* new_bucket = pager.get(new_page_num);
+    Bucket::init(new_bucket, local_depth + 1);
+    *Bucket::local_depth(bucket) = local_depth + 1;
+
+    /* Directory entries sharing the low bits, with the new bit set */
+    uint32_t low_bits = h & (high_bit - 1);
+    for (uint32_t i = low_bits; i < (1u << global_depth); i += high_bit) {
+        if (i & high_bit) {
+            *directory_entry(header, i) = new_page_num;
+        }
+    }
+
+    uint32_t num_entries = *Bucket::num_entries(bucket);
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < num_entries; i++) {
+        char* key = Bucket::entry_key(bucket, key_size, i);
+        uint32_t value = *Bucket::entry_value(bucket, key_size, i);
+        if (hash(key, key_size) & high_bit) {
+            append(new_page_num, key, value);
+        } else {
+            memmove(Bucket::entry_key(bucket, key_size, kept), key,
+                    key_size + Bucket::VALUE_SIZE);
+            kept++;
+        }
+    }
+    *Bucket::num_entries(bucket) = kept;
+}
+
+void HashIndex::remove(const char* key, uint32_t value) {
+    /* Swap with the last entry of the same page, buckets never merge */
+    uint32_t page_num = bucket_for(hash(key, key_size));
+    while (page_num != 0) {
+        char* bucket = pager.get(page_num);
+        uint32_t num_entries = *Bucket::num_entries(bucket);
+        for (uint32_t i = 0; i < num_entries; i++) {
+            if (memcmp(Bucket::entry_key(bucket, key_size, i), key,
+                       key_size) != 0 ||
+                (!unique && *Bucket::entry_value(bucket, key_size, i) != value)) {
+                continue;
+            }
+            memcpy(Bucket::entry_key(bucket, key_size, i),
+                   Bucket::entry_key(bucket, key_size, num_entries - 1),
+                   key_size + Bucket::VALUE_SIZE);
+            *Bucket::num_entries(bucket) = num_entries - 1;
+            return;
+        }
+        page_num = *Bucket::overflow(bucket);
+    }
+}
@@ -0,0 +1,257 @@
+#include "eggshell/storage/index.hpp"
+
+#include <cstring>
+
+#include "eggshell/storage/bplus/indexnode.hpp"
+#include "eggshell/storage/bplus/node.hpp"
+
+Index::Index(std::string filename, Column column)
+    : pager{filename},
+      column{column},
+      key_size{Row::size(column) + uint32_t(sizeof(uint32_t))},
+      root_page_num{0} {
+    if (pager.num_pages == 0) {
+        char* root_node = pager.get(0);
+        IndexNode::init_leaf(root_node);
+        Node::set_node_root(root_node, true);
+    }
+}
+
+Index::~Index() {
+    for (uint32_t i = 0; i < pager.pages.size(); i++) {
+        if (pager.pages[i] == nullptr) continue;
+        pager.flush(i);
+        pager.frames.free(pager.pages[i]);
+        pager.pages[i] = nullptr;
+    }
+    pager.file.close();
+}
+
+std::string Index::filename(const std::string& table_filename,
+                            Column column) {
+    switch (column) {
+        case Column::username:
+            return table_filename + ".username.idx";
+        case Column::email:
+            return table_filename + ".email.idx";
+        default:
+            return table_filename + ".id.idx";
+    }
+}
+
+void Index::make_key(const char* value, uint32_t primary_key,
+                     char* key) const {
+    uint32_t value_size = key_size - sizeof(uint32_t);
+    memset(key, 0, value_size);
+    strncpy(key, value, value_size - 1);
+    /* Big-endian so that memcmp orders equal values by primary key */
+    key[value_size] = char(primary_key >> 24);
+    key[value_size + 1] = char(primary_key >> 16);
+    key[value_size + 2] = char(primary_key >> 8);
+    key[value_size + 3] = char(primary_key);
+}
+
+static const char* column_value(const Row& row, Column column) {
+    return column == Column::username ? row.username : row.email;
+}
+
+void Index::insert(const Row& row) {
+    char key[Row::EMAIL_SIZE + sizeof(uint32_t)];
+    char split_key[sizeof(key)];
+    uint32_t split_page_num;
+    make_key(column_value(row, column), row.id, key);
+
+    if (insert_into(root_page_num, key, split_key, split_page_num)) {
+        split_root(split_key, split_page_num);
+    }
+}
+
+bool Index::insert_into(uint32_t page_num, const char* key, char* split_key,
+                        uint32_t& split_page_num) {
+    /*
+    Returns true if the node at page_num was split. Its lower half stays at
+    page_num and ends at split_key, the upper half is at split_page_num.
+    */
+    char* node = pager.get(page_num);
+    uint32_t num_cells = *IndexNode::num_cells(node);
+
+    if (Node::get_node_type(node) == NodeType::leaf) {
+        uint32_t index = IndexNode::leaf_lower_bound(node, key_size, key);
+        memmove(IndexNode::leaf_key(node, key_size, index + 1),
+                IndexNode::leaf_key(node, key_size, index),
+                (num_cells - index) * key_size);
+        memcpy(IndexNode::leaf_key(node, key_size, index), key, key_size);
+        *IndexNode::num_cells(node) = num_cells + 1;
+
+        if (num_cells + 1 > IndexNode::leaf_max_cells(key_size)) {
+            return split_leaf(node, split_key, split_page_num);
+        }
+        return false;
+    }
+
+    uint32_t index = IndexNode::find_child(node, key_size, key);
+    uint32_t child_page_num = *IndexNode::child(node, key_size, index);
+    char child_split_key[sizeof(uint32_t) + Row::EMAIL_SIZE];
+    uint32_t child_split_page_num;
+    if (!insert_into(child_page_num, key, child_split_key,
+                     child_split_page_num)) {
+        return false;
+    }
+
+    /*
+    The child kept its lower half. It takes a new cell at index keyed by
+    child_split_key, and the pointer that used to lead to it now leads to
+    the upper half.
+    */
+    node = pager.get(page_num);
+    uint32_t cell_size = IndexNode::INDEX_NODE_CHILD_SIZE + key_size;
+    char* cell = IndexNode::internal_cell(node, key_size, index);
+    if (index == num_cells) {
+        *IndexNode::right_child(node) = child_split_page_num;
+    } else {
+        memmove(cell + cell_size, cell, (num_cells - index) * cell_size);
+        *(uint32_t*)(cell + cell_size) = child_split_page_num;
+    }
+    *(uint32_t*)cell = child_page_num;
+    memcpy(cell + IndexNode::INDEX_NODE_CHILD_SIZE, child_split_key,
+           key_size);
+    *IndexNode::num_cells(node) = num_cells + 1;
+
+    if (num_cells + 1 > IndexNode::internal_max_cells(key_size)) {
+        return split_internal(node, split_key, split_page_num);
+    }
+    return false;
+}
+
+bool Index::split_leaf(char* node, char* split_key,
+                       uint32_t& split_page_num) {
+    uint32_t num_cells = *IndexNode::num_cells(node);
+    uint32_t left_count = num_cells / 2;
+
+    split_page_num = pager.get_unused_page_num();
+    char* new_node = pager.get(split_page_num);
+    IndexNode::init_leaf(new_node);
+    memcpy(IndexNode::leaf_key(new_node, key_size, 0),
+           IndexNode::leaf_key(node, key_size, left_count),
+           (num_cells - left_count) * key_size);
+    *IndexNode::num_cells(new_node) = num_cells - left_count;
+    *IndexNode::num_cells(node) = left_count;
+    *IndexNode::next_leaf(new_node) = *IndexNode::next_leaf(node);
+    *IndexNode::next_leaf(node) = split_page_num;
+
+    memcpy(split_key, IndexNode::leaf_key(node, key_size, left_count - 1),
+           key_size);
+    return true;
+}
+
+bool Index::split_internal(char* node, char* split_key,
+                           uint32_t& split_page_num) {
+    /*
+    The middle key moves up. Its child becomes the right child of the
+    lower half, everything after it moves to the new node.
+    */
+    uint32_t num_keys = *IndexNode::num_cells(node);
+    uint32_t middle = num_keys / 2;
+    uint32_t cell_size = IndexNode::INDEX_NODE_CHILD_SIZE + key_size;
+
+    split_page_num = pager.get_unused_page_num();
+    char* new_node = pager.get(split_page_num);
+    IndexNode::init_internal(new_node);
+    memcpy(IndexNode::internal_cell(new_node, key_size, 0),
+           IndexNode::internal_cell(node, key_size, middle + 1),
+           (num_keys - middle - 1) * cell_size);
+    *IndexNode::num_cells(new_node) = num_keys - middle - 1;
+    *IndexNode::right_child(new_node) = *IndexNode::right_child(node);
+
+    memcpy(split_key, IndexNode::internal_key(node, key_size, middle),
+           key_size);
+    *IndexNode::right_child(node) = *IndexNode::child(node, key_size, middle);
+    *IndexNode::num_cells(node) = middle;
+    return true;
+}
+
+void Index::split_root(const char* split_key, uint32_t split_page_num) {
+    /*
+    As with the table, the root stays on its page. Its lower half moves to
+    a new left child and the root becomes an internal node with one key.
+    */
+    char* root = pager.get(root_page_num);
+    uint32_t left_page_num = pager.get_unused_page_num();
+    char* left_child = pager.get(left_page_num);
+    memcpy(left_child, root, Pager::PAGE_SIZE);
+    Node::set_node_root(left_child, false);
+
+    IndexNode::init_internal(root);
+    Node::set_node_root(root, true);
+    *IndexNode::num_cells(root) = 1;
+    *(uint32_t*)IndexNode::internal_cell(root, key_size, 0) = left_page_num;
+    memcpy(IndexNode::internal_key(root, key_size, 0), split_key, key_size);
+    *IndexNode::right_child(root) = split_page_num;
+}
+
+void Index::remove(const Row& row) {
+    /*
+    Cells are removed from their leaf without merging. Separators stay
+    valid upper bounds, and scans step over empty leaves.
+    */
+    char key[Row::EMAIL_SIZE + sizeof(uint32_t)];
+    make_key(column_value(row, column), row.id, key);
+
+    char* node = pager.get(root_page_num);
+    while (Node::get_node_type(node) == NodeType::internal) {
+        uint32_t index = IndexNode::find_child(node, key_size, key);
+        node = pager.get(*IndexNode::child(node, key_size, index));
+    }
+
+    uint32_t num_cells = *IndexNode::num_cells(node);
+    uint32_t index = IndexNode::leaf_lower_bound(node, key_size, key);
+    if (index == num_cells ||
+        memcmp(IndexNode::leaf_key(node, key_size, index), key, key_size)) {
+        return;
+    }
+    memmove(IndexNode::leaf_key(node, key_size, index),
+            IndexNode::leaf_key(node, key_size, index + 1),
+            (num_cells - index - 1) * key_size);
+    *IndexNode::num_cells(node) = num_cells - 1;
+}
+
+void Index::find(const std::string& value, bool prefix,
+                 std::vector<uint32_t>& keys) {
+    uint32_t value_size = key_size - sizeof(uint32_t);
+    char key[Row::EMAIL_SIZE + sizeof(uint32_t)];
+    make_key(value.c_str(), 0, key);
+    /* Equality also has to match the terminating zero */
+    size_t match_size = prefix ? value.size() : value.size() + 1;
+    if (match_size > value_size) {
+        return;
+    }
+
+    char* node = pager.get(root_page_num);
+    while (Node::get_node_type(node) == NodeType::internal) {
+        uint32_t index = IndexNode::find_child(node, key_size, key);
+        node = pager.get(*IndexNode::child(node, key_size, index));
+    }
+
+    uint32_t cell_num = IndexNode::leaf_lower_bound(node, key_size, key);
+    while (true) {
+        if (cell_num >= *IndexNode::num_cells(node)) {
+            uint32_t next_page_num = *IndexNode::next_leaf(node);
+            if (next_page_num == 0) {
+                return;
+            }
+            node = pager.get(next_page_num);
+            cell_num = 0;
+            continue;
+        }
+        const unsigned char* cell =
+            (unsigned char*)IndexNode::leaf_key(node, key_size, cell_num);
+        if (memcmp(cell, key, match_size) != 0) {
+            return;
+        }
+        keys.push_back(uint32_t(cell[value_size]) << 24 |
+                       uint32_t(cell[value_size + 1]) << 16 |
+                       uint32_t(cell[value_size + 2]) << 8 |
+                       uint32_t(cell[value_size + 3]));
+        cell_num++;
+    }
+}
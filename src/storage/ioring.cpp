@@ -0,0 +1,165 @@
+#include "eggshell/storage/ioring.hpp"
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+int io_uring_setup(uint32_t entries, io_uring_params* params) {
+    return syscall(__NR_io_uring_setup, entries, params);
+}
+
+int io_uring_enter(int fd, uint32_t submit, uint32_t wait, uint32_t flags) {
+    return syscall(__NR_io_uring_enter, fd, submit, wait, flags, nullptr, 0);
+}
+
+template <typename T>
+T* field(void* ring, uint32_t offset) {
+    return (T*)((char*)ring + offset);
+}
+
+}  // namespace
+
+IoRing::IoRing(uint32_t entries) : entries{entries} {
+    io_uring_params params{};
+    fd = io_uring_setup(entries, &params);
+    if (fd < 0) {
+        return;
+    }
+
+    sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    cq_ring_size =
+        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap) {
+        sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+    }
+    sq_ring = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    cq_ring = single_mmap ? sq_ring
+                          : mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE,
+                                 MAP_SHARED | MAP_POPULATE, fd,
+                                 IORING_OFF_CQ_RING);
+    sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    void* mapped_sqes = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (sq_ring == MAP_FAILED || cq_ring == MAP_FAILED ||
+        mapped_sqes == MAP_FAILED) {
+        std::cout << "Error mapping io_uring: " << strerror(errno) << "\n";
+        exit(EXIT_FAILURE);
+    }
+    sqes = (io_uring_sqe*)mapped_sqes;
+
+    sq_head = field<uint32_t>(sq_ring, params.sq_off.head);
+    sq_tail = field<uint32_t>(sq_ring, params.sq_off.tail);
+    sq_mask = field<uint32_t>(sq_ring, params.sq_off.ring_mask);
+    sq_array = field<uint32_t>(sq_ring, params.sq_off.array);
+    cq_head = field<uint32_t>(cq_ring, params.cq_off.head);
+    cq_tail = field<uint32_t>(cq_ring, params.cq_off.tail);
+    cq_mask = field<uint32_t>(cq_ring, params.cq_off.ring_mask);
+    cqes = field<io_uring_cqe>(cq_ring, params.cq_off.cqes);
+
+    /* Never more in flight than the submission ring holds */
+    this->entries = params.sq_entries;
+    reaper = std::thread{&IoRing::reap, this};
+}
+
+IoRing::~IoRing() {
+    if (fd < 0) {
+        return;
+    }
+    {
+        std::unique_lock lock(mutex);
+        slot_free.wait(lock, [this] { return in_flight == 0; });
+        /* A no-op wakes the reaper out of its wait */
+        in_flight++;
+        submit(IORING_OP_NOP, -1, nullptr, 0, 0, 0);
+    }
+    reaper.join();
+    munmap(sqes, sqes_size);
+    if (cq_ring != sq_ring) {
+        munmap(cq_ring, cq_ring_size);
+    }
+    munmap(sq_ring, sq_ring_size);
+    close(fd);
+}
+
+bool IoRing::ok() const {
+    return fd >= 0;
+}
+
+void IoRing::read(int file, char* buffer, size_t size, off_t offset,
+                  Callback callback) {
+    std::unique_lock lock(mutex);
+    slot_free.wait(lock, [this] { return in_flight < entries; });
+    in_flight++;
+    submit(IORING_OP_READ, file, buffer, size, offset,
+           (uint64_t) new Callback(std::move(callback)));
+}
+
+void IoRing::submit(uint8_t opcode, int file, char* buffer, size_t size,
+                    off_t offset, uint64_t user_data) {
+    /* Only submitters write the tail, and they hold mutex */
+    uint32_t tail = *sq_tail;
+    uint32_t index = tail & *sq_mask;
+    io_uring_sqe* sqe = &sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = opcode;
+    sqe->fd = file;
+    sqe->addr = (uint64_t)buffer;
+    sqe->len = size;
+    sqe->off = offset;
+    sqe->user_data = user_data;
+    sq_array[index] = index;
+    __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+    while (io_uring_enter(fd, 1, 0, 0) < 0) {
+        if (errno != EINTR && errno != EAGAIN) {
+            std::cout << "Error submitting read: " << strerror(errno) << "\n";
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+void IoRing::reap() {
+    bool stopped = false;
+    while (!stopped) {
+        if (io_uring_enter(fd, 0, 1, IORING_ENTER_GETEVENTS) < 0 &&
+            errno != EINTR) {
+            std::cout << "Error waiting for reads: " << strerror(errno)
+                      << "\n";
+            exit(EXIT_FAILURE);
+        }
+
+        uint32_t head = *cq_head;
+        uint32_t tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+        {
+            /*
+            Taking the lock orders the completions after their submission,
+            which went through the kernel where thread sanitizers cannot
+            see it
+            */
+            std::lock_guard lock(mutex);
+            in_flight -= tail - head;
+        }
+        for (; head != tail; head++) {
+            io_uring_cqe& cqe = cqes[head & *cq_mask];
+            auto* callback = (Callback*)cqe.user_data;
+            if (!callback) {
+                stopped = true;
+                continue;
+            }
+            (*callback)(cqe.res);
+            delete callback;
+        }
+        __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+        slot_free.notify_all();
+    }
+}
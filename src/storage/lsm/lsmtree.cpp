@@ -0,0 +1,420 @@
+#include "eggshell/storage/lsm/lsmtree.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <set>
+
+#include "eggshell/storage/row.hpp"
+
+namespace {
+
+struct MemTableSource : LsmSource {
+    std::shared_ptr<MemTable> memtable;
+    MemTable::Node* node;
+
+    MemTableSource(std::shared_ptr<MemTable> memtable, uint32_t key)
+        : memtable{memtable}, node{memtable->seek(key)} {
+    }
+
+    bool valid() override {
+        return node != nullptr;
+    }
+
+    uint32_t key() override {
+        return node->key;
+    }
+
+    char* value() override {
+        return node->value;
+    }
+
+    void next() override {
+        node = node->next[0];
+    }
+};
+
+struct RunSource : LsmSource {
+    SSTable::Iterator it;
+
+    RunSource(std::shared_ptr<SSTable> run, uint32_t key) : it{run, key} {
+    }
+
+    bool valid() override {
+        return it.valid();
+    }
+
+    uint32_t key() override {
+        return it.key();
+    }
+
+    char* value() override {
+        return it.value();
+    }
+
+    void next() override {
+        it.next();
+    }
+};
+
+}  // namespace
+
+MergeIterator::MergeIterator(std::vector<std::unique_ptr<LsmSource>> sources)
+    : sources{std::move(sources)} {
+    settle();
+}
+
+void MergeIterator::settle() {
+    /* A handful of sources, a linear scan beats keeping a heap */
+    current = -1;
+    for (uint32_t i = 0; i < sources.size(); i++) {
+        if (sources[i]->valid() &&
+            (current < 0 || sources[i]->key() < sources[current]->key())) {
+            current = i;
+        }
+    }
+}
+
+bool MergeIterator::valid() const {
+    return current >= 0;
+}
+
+uint32_t MergeIterator::key() {
+    return sources[current]->key();
+}
+
+char* MergeIterator::value() {
+    return sources[current]->value();
+}
+
+void MergeIterator::next() {
+    /* Older versions of the key are shadowed, skip them as well */
+    uint32_t key = this->key();
+    for (auto& source : sources) {
+        if (source->valid() && source->key() == key) {
+            source->next();
+        }
+    }
+    settle();
+}
+
+LsmIterator::LsmIterator(LsmTree& tree, uint32_t key, bool point_lookup)
+    : tree{tree}, seek_key{key}, found{false} {
+    if (point_lookup) {
+        point.reset(new char[Row::SIZE]);
+        found = tree.get(key, point.get());
+    } else {
+        open();
+    }
+}
+
+void LsmIterator::open() {
+    merge.emplace(tree.sources(seek_key));
+    if (found) {
+        /* The point lookup's key was already visited */
+        found = false;
+        if (merge->valid() && merge->key() == seek_key) {
+            merge->next();
+        }
+    }
+}
+
+bool LsmIterator::at(uint32_t key) {
+    if (!merge) {
+        return found && key == seek_key;
+    }
+    return merge->valid() && merge->key() == key;
+}
+
+bool LsmIterator::valid() {
+    if (!merge) {
+        if (found) {
+            return true;
+        }
+        open();
+    }
+    return merge->valid();
+}
+
+uint32_t LsmIterator::key() {
+    if (!merge && found) {
+        return seek_key;
+    }
+    if (!merge) {
+        open();
+    }
+    return merge->key();
+}
+
+char* LsmIterator::value() {
+    if (!merge && found) {
+        return point.get();
+    }
+    if (!merge) {
+        open();
+    }
+    return merge->value();
+}
+
+void LsmIterator::next() {
+    if (!merge) {
+        open();
+    } else {
+        merge->next();
+    }
+}
+
+std::string LsmTree::dirname(const std::string& table_filename) {
+    return table_filename + ".lsm";
+}
+
+LsmTree::LsmTree(std::string directory, size_t memtable_limit)
+    : directory{directory},
+      memtable_limit{memtable_limit},
+      memtable{std::make_shared<MemTable>()},
+      next_file_num{0},
+      compacting{false},
+      stopping{false} {
+    std::filesystem::create_directories(directory);
+
+    std::set<std::string> live;
+    std::ifstream manifest{directory + "/MANIFEST"};
+    uint32_t level;
+    std::string name;
+    while (manifest >> level >> name) {
+        if (levels.size() <= level) {
+            levels.resize(level + 1);
+        }
+        levels[level].push_back(
+            std::make_shared<SSTable>(directory + "/" + name, level));
+        live.insert(name);
+        next_file_num = std::max<uint32_t>(next_file_num, std::stoul(name) + 1);
+    }
+
+    /* Runs from a flush or compaction that never reached the manifest */
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        if (entry.path().extension() == ".sst" &&
+            !live.contains(entry.path().filename().string())) {
+            std::filesystem::remove(entry.path());
+        }
+    }
+
+    std::string log_filename = directory + "/memtable.log";
+    std::ifstream replay{log_filename, std::ios::binary};
+    std::unique_ptr<char[]> record{new char[SSTableFormat::ENTRY_SIZE]};
+    while (replay.read(record.get(), SSTableFormat::ENTRY_SIZE)) {
+        memtable->put(*(uint32_t*)record.get(),
+                      record.get() + SSTableFormat::ENTRY_KEY_SIZE);
+    }
+    log.open(log_filename, std::ios::binary | std::ios::app);
+
+    compactor = std::thread{&LsmTree::run_compactor, this};
+}
+
+LsmTree::~LsmTree() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    compaction_needed.notify_all();
+    compactor.join();
+
+    flush();
+    log.close();
+}
+
+std::string LsmTree::run_filename(uint32_t file_num) const {
+    return directory + "/" + std::to_string(file_num) + ".sst";
+}
+
+void LsmTree::put(uint32_t key, const char* value) {
+    log.write((const char*)&key, sizeof(key));
+    log.write(value, Row::SIZE);
+    if (sync_puts) {
+        log.flush();
+    }
+
+    memtable->put(key, value);
+    if (memtable->size_bytes() >= memtable_limit) {
+        flush();
+    }
+}
+
+bool LsmTree::get(uint32_t key, char* value) {
+    std::vector<std::shared_ptr<SSTable>> runs;
+    {
+        std::lock_guard lock(mutex);
+        if (memtable->get(key, value)) {
+            return true;
+        }
+        for (const auto& level : levels) {
+            runs.insert(runs.end(), level.begin(), level.end());
+        }
+    }
+    for (const auto& run : runs) {
+        if (run->get(key, value)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<std::unique_ptr<LsmSource>> LsmTree::sources(uint32_t key) {
+    std::vector<std::shared_ptr<SSTable>> runs;
+    std::vector<std::unique_ptr<LsmSource>> sources;
+    {
+        std::lock_guard lock(mutex);
+        sources.push_back(std::make_unique<MemTableSource>(memtable, key));
+        for (const auto& level : levels) {
+            runs.insert(runs.end(), level.begin(), level.end());
+        }
+    }
+    for (const auto& run : runs) {
+        sources.push_back(std::make_unique<RunSource>(run, key));
+    }
+    return sources;
+}
+
+std::shared_ptr<LsmIterator> LsmTree::seek(uint32_t key) {
+    return std::make_shared<LsmIterator>(*this, key, false);
+}
+
+std::shared_ptr<LsmIterator> LsmTree::find(uint32_t key) {
+    return std::make_shared<LsmIterator>(*this, key, true);
+}
+
+void LsmTree::sync() {
+    log.flush();
+}
+
+void LsmTree::flush() {
+    if (memtable->num_entries() == 0) {
+        return;
+    }
+    uint32_t file_num;
+    {
+        std::lock_guard lock(mutex);
+        file_num = next_file_num++;
+    }
+
+    SSTableWriter writer{run_filename(file_num), memtable->num_entries()};
+    for (MemTable::Node* node = memtable->seek(0); node; node = node->next[0]) {
+        writer.add(node->key, node->value);
+    }
+    writer.finish();
+    auto run = std::make_shared<SSTable>(run_filename(file_num), 0);
+
+    {
+        std::lock_guard lock(mutex);
+        if (levels.empty()) {
+            levels.resize(1);
+        }
+        levels[0].insert(levels[0].begin(), run);
+        write_manifest();
+        /* Iterators still on the old memtable keep it alive */
+        memtable = std::make_shared<MemTable>();
+        log.close();
+        log.open(directory + "/memtable.log", std::ios::binary | std::ios::trunc);
+    }
+    compaction_needed.notify_one();
+}
+
+void LsmTree::write_manifest() {
+    std::string filename = directory + "/MANIFEST";
+    {
+        std::ofstream manifest{filename + ".tmp", std::ios::trunc};
+        for (uint32_t level = 0; level < levels.size(); level++) {
+            for (const auto& run : levels[level]) {
+                manifest << level << " "
+                         << std::filesystem::path(run->path).filename().string()
+                         << "\n";
+            }
+        }
+    }
+    /* rename is atomic, a crash leaves either manifest in place */
+    std::filesystem::rename(filename + ".tmp", filename);
+}
+
+int32_t LsmTree::full_level() const {
+    for (uint32_t level = 0; level < levels.size(); level++) {
+        if (levels[level].size() >= LEVEL_MAX_RUNS) {
+            return level;
+        }
+    }
+    return -1;
+}
+
+void LsmTree::compact_level(uint32_t level,
+                            std::vector<std::shared_ptr<SSTable>> runs) {
+    uint32_t num_entries = 0;
+    std::vector<std::unique_ptr<LsmSource>> inputs;
+    for (const auto& run : runs) {
+        num_entries += run->num_entries;
+        inputs.push_back(std::make_unique<RunSource>(run, 0));
+    }
+    uint32_t file_num;
+    {
+        std::lock_guard lock(mutex);
+        file_num = next_file_num++;
+    }
+
+    SSTableWriter writer{run_filename(file_num), num_entries};
+    for (MergeIterator merge{std::move(inputs)}; merge.valid(); merge.next()) {
+        writer.add(merge.key(), merge.value());
+    }
+    writer.finish();
+    auto merged = std::make_shared<SSTable>(run_filename(file_num), level + 1);
+
+    std::lock_guard lock(mutex);
+    /* Flushes only add newer runs in front, the inputs are still at the back */
+    levels[level].resize(levels[level].size() - runs.size());
+    if (levels.size() <= level + 1) {
+        levels.resize(level + 2);
+    }
+    levels[level + 1].insert(levels[level + 1].begin(), merged);
+    write_manifest();
+    for (const auto& run : runs) {
+        run->obsolete = true;
+    }
+}
+
+void LsmTree::run_compactor() {
+    std::unique_lock lock(mutex);
+    while (true) {
+        compaction_needed.wait(lock,
+                               [&] { return stopping || full_level() >= 0; });
+        if (stopping) {
+            break;
+        }
+        uint32_t level = full_level();
+        std::vector<std::shared_ptr<SSTable>> runs = levels[level];
+        compacting = true;
+        lock.unlock();
+
+        compact_level(level, runs);
+
+        lock.lock();
+        compacting = false;
+        compaction_done.notify_all();
+    }
+    compaction_done.notify_all();
+}
+
+void LsmTree::wait_for_compaction() {
+    std::unique_lock lock(mutex);
+    compaction_done.wait(
+        lock, [&] { return stopping || (!compacting && full_level() < 0); });
+}
+
+std::vector<uint32_t> LsmTree::shape() {
+    std::lock_guard lock(mutex);
+    std::vector<uint32_t> shape;
+    for (const auto& level : levels) {
+        shape.push_back(level.size());
+    }
+    return shape;
+}
+
+uint32_t LsmTree::memtable_entries() {
+    std::lock_guard lock(mutex);
+    return memtable->num_entries();
+}
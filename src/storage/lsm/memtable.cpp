@@ -0,0 +1,78 @@
+#include "eggshell/storage/lsm/memtable.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+MemTable::MemTable() : level{1}, rng{0x5eed} {
+    head.key = 0;
+    for (uint32_t i = 0; i < MAX_LEVEL; i++) {
+        head.next[i] = nullptr;
+    }
+}
+
+MemTable::Node* MemTable::seek(uint32_t key) {
+    Node* node = &head;
+    for (int32_t i = level - 1; i >= 0; i--) {
+        while (node->next[i] && node->next[i]->key < key) {
+            node = node->next[i];
+        }
+    }
+    return node->next[0];
+}
+
+void MemTable::put(uint32_t key, const char* value) {
+    Node* update[MAX_LEVEL];
+    Node* node = &head;
+    for (int32_t i = level - 1; i >= 0; i--) {
+        while (node->next[i] && node->next[i]->key < key) {
+            node = node->next[i];
+        }
+        update[i] = node;
+    }
+
+    Node* next = node->next[0];
+    if (next && next->key == key) {
+        /* value may be the node's own, changed in place through a cursor */
+        memmove(next->value, value, Row::SIZE);
+        return;
+    }
+
+    /* Each level is kept with probability 1/4 */
+    uint32_t node_level = 1;
+    while (node_level < MAX_LEVEL && (rng() & 3) == 0) {
+        node_level++;
+    }
+    for (uint32_t i = level; i < node_level; i++) {
+        update[i] = &head;
+    }
+    level = std::max(level, node_level);
+
+    auto inserted = std::make_unique<Node>();
+    inserted->key = key;
+    memcpy(inserted->value, value, Row::SIZE);
+    for (uint32_t i = 0; i < MAX_LEVEL; i++) {
+        inserted->next[i] = nullptr;
+    }
+    for (uint32_t i = 0; i < node_level; i++) {
+        inserted->next[i] = update[i]->next[i];
+        update[i]->next[i] = inserted.get();
+    }
+    nodes.push_back(std::move(inserted));
+}
+
+bool MemTable::get(uint32_t key, char* value) {
+    Node* node = seek(key);
+    if (!node || node->key != key) {
+        return false;
+    }
+    memcpy(value, node->value, Row::SIZE);
+    return true;
+}
+
+size_t MemTable::size_bytes() const {
+    return nodes.size() * sizeof(Node);
+}
+
+uint32_t MemTable::num_entries() const {
+    return nodes.size();
+}
@@ -0,0 +1,246 @@
+#include "eggshell/storage/lsm/sstable.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#include "eggshell/storage/pager.hpp"
+#include "eggshell/storage/row.hpp"
+
+const uint32_t SSTableFormat::BLOCK_NUM_ENTRIES_SIZE = sizeof(uint32_t);
+const uint32_t SSTableFormat::ENTRY_KEY_SIZE = sizeof(uint32_t);
+const uint32_t SSTableFormat::ENTRY_SIZE = ENTRY_KEY_SIZE + Row::SIZE;
+const uint32_t SSTableFormat::BLOCK_MAX_ENTRIES =
+    (Pager::PAGE_SIZE - BLOCK_NUM_ENTRIES_SIZE) / ENTRY_SIZE;
+const uint32_t SSTableFormat::FOOTER_SIZE = 5 * sizeof(uint32_t);
+const uint32_t SSTableFormat::MAGIC = 0xe665be11;
+
+uint32_t* SSTableFormat::num_entries(char* block) {
+    return (uint32_t*)block;
+}
+
+uint32_t* SSTableFormat::key(char* block, uint32_t entry_num) {
+    return (uint32_t*)(block + BLOCK_NUM_ENTRIES_SIZE + entry_num * ENTRY_SIZE);
+}
+
+char* SSTableFormat::value(char* block, uint32_t entry_num) {
+    return (char*)key(block, entry_num) + ENTRY_KEY_SIZE;
+}
+
+BloomFilter::BloomFilter(uint32_t num_keys)
+    : bits((std::max(num_keys, 1u) * 10 + 7) / 8), num_hashes{7} {
+}
+
+static uint64_t bloom_hash(uint32_t key) {
+    uint64_t h = key * 0x9e3779b97f4a7c15ull;
+    h ^= h >> 29;
+    h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 32;
+    return h;
+}
+
+void BloomFilter::add(uint32_t key) {
+    /* Double hashing, h1 + i * h2 */
+    uint64_t h = bloom_hash(key);
+    uint32_t h1 = h, h2 = (h >> 32) | 1;
+    uint64_t num_bits = bits.size() * 8;
+    for (uint32_t i = 0; i < num_hashes; i++) {
+        uint64_t bit = (h1 + uint64_t(i) * h2) % num_bits;
+        bits[bit / 8] |= 1 << (bit % 8);
+    }
+}
+
+bool BloomFilter::may_contain(uint32_t key) const {
+    if (bits.empty()) {
+        return true;
+    }
+    uint64_t h = bloom_hash(key);
+    uint32_t h1 = h, h2 = (h >> 32) | 1;
+    uint64_t num_bits = bits.size() * 8;
+    for (uint32_t i = 0; i < num_hashes; i++) {
+        uint64_t bit = (h1 + uint64_t(i) * h2) % num_bits;
+        if (!(bits[bit / 8] & (1 << (bit % 8)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SSTableWriter::SSTableWriter(std::string path, uint32_t expected_entries)
+    : file{path, std::ios::binary | std::ios::trunc},
+      block{new char[Pager::PAGE_SIZE]()},
+      bloom{expected_entries},
+      num_entries{0} {
+    if (!file) {
+        std::cout << "Unable to create run " << path << "\n";
+        exit(EXIT_FAILURE);
+    }
+}
+
+void SSTableWriter::add(uint32_t key, const char* value) {
+    uint32_t count = *SSTableFormat::num_entries(block.get());
+    if (count == 0) {
+        index.push_back({key, key});
+    }
+    *SSTableFormat::key(block.get(), count) = key;
+    memcpy(SSTableFormat::value(block.get(), count), value, Row::SIZE);
+    *SSTableFormat::num_entries(block.get()) = count + 1;
+    index.back().second = key;
+    bloom.add(key);
+    num_entries++;
+
+    if (count + 1 == SSTableFormat::BLOCK_MAX_ENTRIES) {
+        write_block();
+    }
+}
+
+void SSTableWriter::write_block() {
+    file.write(block.get(), Pager::PAGE_SIZE);
+    memset(block.get(), 0, Pager::PAGE_SIZE);
+}
+
+void SSTableWriter::finish() {
+    if (*SSTableFormat::num_entries(block.get()) > 0) {
+        write_block();
+    }
+    file.write((const char*)index.data(),
+               index.size() * sizeof(std::pair<uint32_t, uint32_t>));
+    file.write((const char*)bloom.bits.data(), bloom.bits.size());
+
+    uint32_t footer[] = {uint32_t(index.size()), num_entries,
+                         uint32_t(bloom.bits.size()), bloom.num_hashes,
+                         SSTableFormat::MAGIC};
+    file.write((const char*)footer, sizeof(footer));
+    file.flush();
+    if (!file) {
+        std::cout << "Error writing run: " << strerror(errno) << "\n";
+        exit(EXIT_FAILURE);
+    }
+    file.close();
+}
+
+SSTable::SSTable(std::string path, uint32_t level)
+    : path{path}, level{level}, file{path, std::ios::binary} {
+    uint32_t footer[5];
+    file.seekg(-int64_t(SSTableFormat::FOOTER_SIZE), file.end);
+    file.read((char*)footer, sizeof(footer));
+    if (!file || footer[4] != SSTableFormat::MAGIC) {
+        std::cout << "Corrupt run " << path << "\n";
+        exit(EXIT_FAILURE);
+    }
+    num_entries = footer[1];
+
+    /* The index and the bloom filter stay in memory */
+    index.resize(footer[0]);
+    bloom.bits.resize(footer[2]);
+    bloom.num_hashes = footer[3];
+    file.seekg(uint64_t(footer[0]) * Pager::PAGE_SIZE);
+    file.read((char*)index.data(),
+              index.size() * sizeof(std::pair<uint32_t, uint32_t>));
+    file.read((char*)bloom.bits.data(), bloom.bits.size());
+    if (!file) {
+        std::cout << "Corrupt run " << path << "\n";
+        exit(EXIT_FAILURE);
+    }
+}
+
+SSTable::~SSTable() {
+    file.close();
+    if (obsolete) {
+        std::remove(path.c_str());
+    }
+}
+
+uint32_t SSTable::num_blocks() const {
+    return index.size();
+}
+
+uint32_t SSTable::find_block(uint32_t key) const {
+    uint32_t min_index = 0;
+    uint32_t max_index = index.size();
+    while (min_index != max_index) {
+        uint32_t i = (min_index + max_index) / 2;
+        if (index[i].second >= key) {
+            max_index = i;
+        } else {
+            min_index = i + 1;
+        }
+    }
+    return min_index;
+}
+
+void SSTable::read_block(uint32_t block_num, char* block) {
+    std::lock_guard lock(file_mutex);
+    file.clear();
+    file.seekg(uint64_t(block_num) * Pager::PAGE_SIZE);
+    file.read(block, Pager::PAGE_SIZE);
+    if (!file) {
+        std::cout << "Error reading run " << path << "\n";
+        exit(EXIT_FAILURE);
+    }
+}
+
+bool SSTable::get(uint32_t key, char* value) {
+    if (!bloom.may_contain(key)) {
+        return false;
+    }
+    uint32_t block_num = find_block(key);
+    if (block_num == index.size() || index[block_num].first > key) {
+        return false;
+    }
+
+    char block[Pager::PAGE_SIZE];
+    read_block(block_num, block);
+    uint32_t min_index = 0;
+    uint32_t max_index = *SSTableFormat::num_entries(block);
+    while (min_index != max_index) {
+        uint32_t i = (min_index + max_index) / 2;
+        uint32_t key_at_index = *SSTableFormat::key(block, i);
+        if (key_at_index == key) {
+            memcpy(value, SSTableFormat::value(block, i), Row::SIZE);
+            return true;
+        }
+        if (key_at_index < key) {
+            min_index = i + 1;
+        } else {
+            max_index = i;
+        }
+    }
+    return false;
+}
+
+SSTable::Iterator::Iterator(std::shared_ptr<SSTable> table, uint32_t key)
+    : table{table}, block{new char[Pager::PAGE_SIZE]}, entry_num{0} {
+    load(table->find_block(key));
+    while (valid() && this->key() < key) {
+        next();
+    }
+}
+
+void SSTable::Iterator::load(uint32_t num) {
+    block_num = num;
+    entry_num = 0;
+    if (block_num < table->num_blocks()) {
+        table->read_block(block_num, block.get());
+    }
+}
+
+bool SSTable::Iterator::valid() const {
+    return block_num < table->num_blocks();
+}
+
+uint32_t SSTable::Iterator::key() {
+    return *SSTableFormat::key(block.get(), entry_num);
+}
+
+char* SSTable::Iterator::value() {
+    return SSTableFormat::value(block.get(), entry_num);
+}
+
+void SSTable::Iterator::next() {
+    entry_num++;
+    if (entry_num >= *SSTableFormat::num_entries(block.get())) {
+        load(block_num + 1);
+    }
+}
@@ -0,0 +1,95 @@
+#include "eggshell/storage/pagemap.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include "eggshell/storage/compress.hpp"
+#include "eggshell/storage/pager.hpp"
+
+std::string PageMap::filename(const std::string& table_filename) {
+    return table_filename + ".pagemap";
+}
+
+bool PageMap::load(const std::string& filename) {
+    std::ifstream file{filename, std::ios::binary};
+    if (!file) {
+        return false;
+    }
+    uint32_t count = 0;
+    file.read((char*)&count, sizeof(count));
+    slots.resize(count);
+    end = 0;
+    for (PageSlot& slot : slots) {
+        file.read((char*)&slot.offset, sizeof(slot.offset));
+        file.read((char*)&slot.size, sizeof(slot.size));
+        file.read((char*)&slot.capacity, sizeof(slot.capacity));
+        end = std::max(end, slot.offset + slot.capacity);
+    }
+    if (!file) {
+        std::cout << "Page map " << filename << " is truncated. Corrupt file\n";
+        exit(EXIT_FAILURE);
+    }
+    return true;
+}
+
+void PageMap::save(const std::string& filename) const {
+    {
+        std::ofstream file{filename + ".tmp",
+                           std::ios::binary | std::ios::trunc};
+        uint32_t count = slots.size();
+        file.write((const char*)&count, sizeof(count));
+        for (const PageSlot& slot : slots) {
+            file.write((const char*)&slot.offset, sizeof(slot.offset));
+            file.write((const char*)&slot.size, sizeof(slot.size));
+            file.write((const char*)&slot.capacity, sizeof(slot.capacity));
+        }
+        if (!file) {
+            std::cout << "Error writing: " << strerror(errno) << "\n";
+            exit(EXIT_FAILURE);
+        }
+    }
+    std::filesystem::rename(filename + ".tmp", filename);
+}
+
+bool PageMap::stored(uint32_t page_num) const {
+    return page_num < slots.size() && slots[page_num].size > 0;
+}
+
+const PageSlot& PageMap::place(uint32_t page_num, uint32_t size) {
+    if (page_num >= slots.size()) {
+        slots.resize(page_num + 1);
+    }
+    PageSlot& slot = slots[page_num];
+    if (size > slot.capacity) {
+        slot.offset = end;
+        slot.capacity = (size + SLOT_ALIGNMENT - 1) / SLOT_ALIGNMENT *
+                        SLOT_ALIGNMENT;
+        end += slot.capacity;
+    }
+    slot.size = size;
+    return slot;
+}
+
+uint32_t PageMap::encode(const char* page, char* stored) {
+    uint32_t size = Compression::compress(page, Pager::PAGE_SIZE, stored,
+                                          Pager::PAGE_SIZE - 1);
+    if (size == 0) {
+        memcpy(stored, page, Pager::PAGE_SIZE);
+        return Pager::PAGE_SIZE;
+    }
+    return size;
+}
+
+void PageMap::decode(const char* stored, uint32_t size, char* page) {
+    if (size == Pager::PAGE_SIZE) {
+        memcpy(page, stored, Pager::PAGE_SIZE);
+        return;
+    }
+    if (!Compression::decompress(stored, size, page, Pager::PAGE_SIZE)) {
+        std::cout << "Page does not decompress. Corrupt file\n";
+        exit(EXIT_FAILURE);
+    }
+}
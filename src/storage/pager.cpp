@@ -1,7 +1,26 @@
 #include "eggshell/storage/pager.hpp"
 
-Pager::Pager(std::string filename)
-    : file{filename, file.in | file.out | file.binary} {
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "eggshell/executor/scheduler.hpp"
+
+namespace {
+
+/* Largest read prefetch makes, of pages stored close together */
+const uint64_t PREFETCH_READ_BYTES = 256 << 10;
+/* Pages further apart than this are read separately */
+const uint64_t PREFETCH_GAP_BYTES = 4 * Pager::PAGE_SIZE;
+
+}  // namespace
+
+Pager::Pager(std::string filename, const PagerOptions& options)
+    : file{filename, file.in | file.out | file.binary},
+      options{options},
+      frames{PAGE_SIZE, options.huge_pages},
+      map_filename{PageMap::filename(filename)} {
     if (file.fail()) {
         printf("Unable to open file\n");
         std::exit(EXIT_FAILURE);
@@ -10,43 +29,53 @@ Pager::Pager(std::string filename)
     file.seekg(0, file.end);
     file_length = file.tellg();
     num_pages = file_length / PAGE_SIZE;
+    open_map(options.compress);
 
-    if (file_length % PAGE_SIZE != 0) {
+    if (!map && file_length % PAGE_SIZE != 0) {
         std::cout << "Db file is not a whole number of pages. Corrupt file\n";
         exit(EXIT_FAILURE);
     }
 
-    for (uint32_t i = 0; i < MAX_PAGES; i++) {
-        pages[i] = nullptr;
+    read_fd = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (read_fd < 0) {
+        printf("Unable to open file\n");
+        std::exit(EXIT_FAILURE);
+    }
+    if (options.direct_io && !map) {
+        /* -1 where the filesystem refuses it, as tmpfs does */
+        direct_fd = open(filename.c_str(), O_RDWR | O_DIRECT | O_CLOEXEC);
+    }
+}
+
+Pager::~Pager() {
+    stop_prefetch();
+    close(read_fd);
+    if (direct_fd >= 0) {
+        close(direct_fd);
     }
+    /* Cached pages and their images go with the frames */
 }
 
 char* Pager::get(uint32_t page_num) {
-    if (page_num > MAX_PAGES) {
+    std::lock_guard lock(mutex);
+    fetches++;
+    if (page_num >= MAX_PAGES) {
         std::cout << "Tried to fetch page number out of bounds. " << page_num
                   << " >= " << MAX_PAGES << "\n";
         exit(EXIT_FAILURE);
     }
+    if (page_num >= pages.size()) {
+        pages.resize(page_num + 1, nullptr);
+    }
 
     if (pages[page_num] == nullptr) {
         // Cache miss. Allocate memory and load from file.
-        char* page = new char[PAGE_SIZE];
-        // uint32_t num_pages = file_length / PAGE_SIZE;
-
-        // We might save a partial page at the end of the file
-        if (file_length % PAGE_SIZE) {
-            num_pages += 1;
-        }
-        if (page_num <= num_pages) {
-            file.clear();
-            file.seekg(page_num * PAGE_SIZE, file.beg);
-            file.clear();
-            file.read(page, PAGE_SIZE);
-            file.clear();
-            if (!file) {
-                std::cout << "Error reading file: " << strerror(errno) << "\n";
-                exit(EXIT_FAILURE);
-            }
+        char* page = frames.allocate();
+        memset(page, 0, PAGE_SIZE);
+
+        // Pages past the end of the file are new and start zeroed
+        if (stored(page_num)) {
+            read(page_num, page);
         }
         pages[page_num] = page;
 
@@ -55,12 +84,127 @@ char* Pager::get(uint32_t page_num) {
         }
     }
 
-    previous_pages[page_num] = new char[PAGE_SIZE];
-    memcpy(previous_pages[page_num], pages[page_num], PAGE_SIZE);
+    if (page_num >= previous_pages.size()) {
+        previous_pages.resize(pages.size(), nullptr);
+    }
+    if (previous_pages[page_num] == nullptr) {
+        previous_pages[page_num] = frames.allocate();
+        memcpy(previous_pages[page_num], pages[page_num], PAGE_SIZE);
+    }
 
     return pages[page_num];
 }
 
+bool Pager::stored(uint32_t page_num) {
+    return map ? map->stored(page_num) : page_num < file_length / PAGE_SIZE;
+}
+
+void Pager::read(uint32_t page_num, char* page) {
+    if (direct_fd >= 0) {
+        if (pread(direct_fd, page, PAGE_SIZE, off_t(page_num) * PAGE_SIZE) !=
+            ssize_t(PAGE_SIZE)) {
+            std::cout << "Error reading file: " << strerror(errno) << "\n";
+            exit(EXIT_FAILURE);
+        }
+        bytes_read += PAGE_SIZE;
+        return;
+    }
+    PageSlot slot{uint64_t(page_num) * PAGE_SIZE, PAGE_SIZE, PAGE_SIZE};
+    if (map) {
+        slot = map->slots[page_num];
+    }
+    char stored[PAGE_SIZE];
+    file.clear();
+    file.seekg(slot.offset, file.beg);
+    file.read(map ? stored : page, slot.size);
+    if (!file) {
+        std::cout << "Error reading file: " << strerror(errno) << "\n";
+        exit(EXIT_FAILURE);
+    }
+    bytes_read += slot.size;
+    if (map) {
+        PageMap::decode(stored, slot.size, page);
+    }
+}
+
+void Pager::open_map(bool compress) {
+    auto loaded = std::make_unique<PageMap>();
+    if (loaded->load(map_filename)) {
+        map = std::move(loaded);
+    } else if (compress && file_length == 0) {
+        map = std::move(loaded);
+    } else {
+        map.reset();
+        return;
+    }
+    num_pages = map->slots.size();
+}
+
+bool Pager::cached(uint32_t page_num) {
+    std::lock_guard lock(mutex);
+    /* Pages past the end of the file need no read either */
+    return !stored(page_num) ||
+           (page_num < pages.size() && pages[page_num] != nullptr);
+}
+
+PageFetch Pager::fetch(uint32_t page_num, Scheduler& scheduler) {
+    return PageFetch{*this, scheduler, page_num};
+}
+
+bool PageFetch::await_ready() {
+    return pager.cached(page_num);
+}
+
+void PageFetch::await_suspend(std::coroutine_handle<> handle) {
+    off_t offset = off_t(page_num) * Pager::PAGE_SIZE;
+    size = Pager::PAGE_SIZE;
+    int fd;
+    {
+        std::lock_guard lock(pager.mutex);
+        generation = pager.generation;
+        if (pager.map) {
+            offset = pager.map->slots[page_num].offset;
+            size = pager.map->slots[page_num].size;
+        }
+        fd = pager.direct_fd >= 0 ? pager.direct_fd : pager.read_fd;
+    }
+    /* A frame, aligned as O_DIRECT needs */
+    page = pager.frames.allocate();
+    scheduler.read(fd, page, size, offset, &result, handle);
+}
+
+char* PageFetch::await_resume() {
+    if (page) {
+        std::lock_guard lock(pager.mutex);
+        if (page_num >= pager.pages.size()) {
+            pager.pages.resize(page_num + 1, nullptr);
+        }
+        /*
+        Another query may have read the page meanwhile, or VACUUM swapped
+        the file under a read of the old one
+        */
+        if (pager.pages[page_num] == nullptr &&
+            pager.generation == generation) {
+            if (result != ssize_t(size)) {
+                std::cout << "Error reading file: "
+                          << strerror(result < 0 ? -result : EIO) << "\n";
+                exit(EXIT_FAILURE);
+            }
+            if (size < Pager::PAGE_SIZE) {
+                char* stored = page;
+                page = pager.frames.allocate();
+                PageMap::decode(stored, size, page);
+                pager.frames.free(stored);
+            }
+            pager.bytes_read += size;
+            pager.pages[page_num] = page;
+        } else {
+            pager.frames.free(page);
+        }
+    }
+    return pager.get(page_num);
+}
+
 /*
 Until we start recycling free pages, new pages will always
 go onto the end of the database file
@@ -69,12 +213,63 @@ uint32_t Pager::get_unused_page_num() {
     return num_pages;
 }
 
+void Pager::reopen(const std::string& filename) {
+    std::lock_guard lock(mutex);
+    for (char*& page : pages) {
+        frames.free(page);
+        page = nullptr;
+    }
+    for (char* page : previous_pages) {
+        frames.free(page);
+    }
+    previous_pages.clear();
+
+    file.close();
+    file.open(filename, file.in | file.out | file.binary);
+    int fd = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file.fail() || fd < 0 || dup3(fd, read_fd, O_CLOEXEC) < 0) {
+        printf("Unable to open file\n");
+        std::exit(EXIT_FAILURE);
+    }
+    close(fd);
+    if (direct_fd >= 0) {
+        fd = open(filename.c_str(), O_RDWR | O_DIRECT | O_CLOEXEC);
+        if (fd < 0 || dup3(fd, direct_fd, O_CLOEXEC) < 0) {
+            printf("Unable to open file\n");
+            std::exit(EXIT_FAILURE);
+        }
+        close(fd);
+    }
+    file.seekg(0, file.end);
+    file_length = file.tellg();
+    num_pages = file_length / PAGE_SIZE;
+    map_filename = PageMap::filename(filename);
+    open_map(map != nullptr);
+    generation++;
+}
+
 void Pager::flush(uint32_t page_num) {
     if (pages[page_num] == nullptr) {
         std::cout << "Tried to flush null page\n";
         exit(EXIT_FAILURE);
     }
-    file.seekg(page_num * PAGE_SIZE, file.beg);
+    const char* page = pages[page_num];
+    uint64_t offset = uint64_t(page_num) * PAGE_SIZE;
+    if (direct_fd >= 0) {
+        if (pwrite(direct_fd, page, PAGE_SIZE, offset) != ssize_t(PAGE_SIZE)) {
+            std::cout << "Error writing: " << strerror(errno) << "\n";
+            exit(EXIT_FAILURE);
+        }
+        return;
+    }
+    uint32_t size = PAGE_SIZE;
+    char stored[PAGE_SIZE];
+    if (map) {
+        size = PageMap::encode(page, stored);
+        offset = map->place(page_num, size).offset;
+        page = stored;
+    }
+    file.seekg(offset, file.beg);
     file.clear();
 
     if (!file) {
@@ -82,7 +277,7 @@ void Pager::flush(uint32_t page_num) {
         exit(EXIT_FAILURE);
     }
 
-    file.write(pages[page_num], PAGE_SIZE);
+    file.write(page, size);
 
     if (!file) {
         std::cout << "Error writing: " << errno << "\n";
@@ -90,6 +285,12 @@ void Pager::flush(uint32_t page_num) {
     }
 }
 
+void Pager::save_map() {
+    if (map) {
+        map->save(map_filename);
+    }
+}
+
 void Pager::log_transaction(uint32_t page_num, std::fstream& file) {
     if (pages[page_num] == nullptr) {
         std::cout << "Tried to flush null page\n";
@@ -103,4 +304,122 @@ void Pager::log_transaction(uint32_t page_num, std::fstream& file) {
         std::cout << "Error writing: " << errno << "\n";
         exit(EXIT_FAILURE);
     }
-}
\ No newline at end of file
+}
+
+void Pager::prefetch(const WarmSet& set) {
+    stop_prefetch();
+    prefetch_stopped = false;
+    uint64_t generation;
+    {
+        std::lock_guard lock(mutex);
+        generation = this->generation;
+        /*
+        Sized up front, so that the prefetcher never moves pages under a
+        writer indexing it without the mutex
+        */
+        if (pages.size() < num_pages) {
+            pages.resize(num_pages, nullptr);
+        }
+    }
+    prefetcher = std::thread{[this, set, generation] {
+        if (prefetch_group(set.interior, generation)) {
+            prefetch_group(set.leaves, generation);
+        }
+    }};
+}
+
+void Pager::wait_for_prefetch() {
+    if (prefetcher.joinable()) {
+        prefetcher.join();
+    }
+}
+
+void Pager::stop_prefetch() {
+    prefetch_stopped = true;
+    wait_for_prefetch();
+}
+
+bool Pager::prefetch_group(const std::vector<uint32_t>& page_nums,
+                           uint64_t generation) {
+    std::vector<std::pair<uint32_t, PageSlot>> reads;
+    int fd;
+    {
+        std::lock_guard lock(mutex);
+        if (this->generation != generation) {
+            return false;
+        }
+        for (uint32_t page_num : page_nums) {
+            /* The set may be older than the file */
+            if (!stored(page_num) || page_num >= pages.size() ||
+                pages[page_num] != nullptr) {
+                continue;
+            }
+            PageSlot slot{uint64_t(page_num) * PAGE_SIZE, PAGE_SIZE,
+                          PAGE_SIZE};
+            reads.emplace_back(page_num, map ? map->slots[page_num] : slot);
+        }
+        fd = direct_fd >= 0 ? direct_fd : read_fd;
+    }
+    std::sort(reads.begin(), reads.end(), [](const auto& a, const auto& b) {
+        return a.second.offset < b.second.offset;
+    });
+
+    /* Aligned as O_DIRECT needs */
+    char* buffer = (char*)aligned_alloc(PAGE_SIZE, PREFETCH_READ_BYTES);
+    std::vector<char*> read_pages;
+    size_t first = 0;
+    while (first < reads.size() && !prefetch_stopped) {
+        uint64_t start = reads[first].second.offset;
+        uint64_t length = reads[first].second.size;
+        size_t last = first + 1;
+        for (; last < reads.size(); last++) {
+            const PageSlot& next = reads[last].second;
+            uint64_t end = next.offset + next.size;
+            if (next.offset > start + length + PREFETCH_GAP_BYTES ||
+                end - start > PREFETCH_READ_BYTES) {
+                break;
+            }
+            length = std::max(length, end - start);
+        }
+
+        ssize_t result = pread(fd, buffer, length, start);
+        read_pages.assign(last - first, nullptr);
+        for (size_t i = first; i < last; i++) {
+            const PageSlot& slot = reads[i].second;
+            /* Pages cut short by a failed read are left to get */
+            if (result < 0 || slot.offset + slot.size > start + result) {
+                continue;
+            }
+            char* page = frames.allocate();
+            if (map) {
+                PageMap::decode(buffer + (slot.offset - start), slot.size,
+                                page);
+            } else {
+                memcpy(page, buffer + (slot.offset - start), PAGE_SIZE);
+            }
+            read_pages[i - first] = page;
+        }
+
+        std::lock_guard lock(mutex);
+        bool current = this->generation == generation;
+        for (size_t i = first; i < last; i++) {
+            char* page = read_pages[i - first];
+            uint32_t page_num = reads[i].first;
+            if (!page) {
+                continue;
+            } else if (!current || pages[page_num] != nullptr) {
+                frames.free(page);
+                continue;
+            }
+            pages[page_num] = page;
+            bytes_read += reads[i].second.size;
+            prefetched++;
+        }
+        if (!current) {
+            break;
+        }
+        first = last;
+    }
+    free(buffer);
+    return first == reads.size();
+}
@@ -0,0 +1,57 @@
+#include "eggshell/storage/partition.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+PartitionedTable::PartitionedTable(const std::string& prefix,
+                                   const PartitionSpec& spec, bool create,
+                                   const PagerOptions& options)
+    : spec{spec} {
+    for (uint32_t i = 0; i < spec.partitions; i++) {
+        std::string filename = shard_filename(prefix, i);
+        if (create) {
+            std::ofstream{filename, std::ios::trunc};
+        }
+        shards.push_back(
+            std::make_unique<Table>(filename, Engine::btree, options));
+    }
+}
+
+std::string PartitionedTable::shard_filename(const std::string& prefix,
+                                             uint32_t partition) {
+    return prefix + "." + std::to_string(partition) + ".tbl";
+}
+
+uint32_t PartitionedTable::partition(uint32_t key) const {
+    if (spec.range) {
+        return std::min(key / spec.range_width, spec.partitions - 1);
+    }
+    /* Mixed first, so runs of consecutive ids spread over every shard */
+    key ^= key >> 16;
+    key *= 0x85ebca6b;
+    key ^= key >> 13;
+    key *= 0xc2b2ae35;
+    key ^= key >> 16;
+    return key % spec.partitions;
+}
+
+Table& PartitionedTable::shard(uint32_t key) {
+    return *shards[partition(key)];
+}
+
+std::vector<Table*> PartitionedTable::shards_between(uint32_t key_min,
+                                                     uint32_t key_max) {
+    uint32_t first = 0;
+    uint32_t last = spec.partitions - 1;
+    if (key_min == key_max) {
+        first = last = partition(key_min);
+    } else if (spec.range && key_min <= key_max) {
+        first = partition(key_min);
+        last = partition(key_max);
+    }
+    std::vector<Table*> tables;
+    for (uint32_t i = first; i <= last; i++) {
+        tables.push_back(shards[i].get());
+    }
+    return tables;
+}
@@ -20,4 +20,27 @@ void Row::deserialize(const char* source) {
     std::memcpy(&id, source + ID_OFFSET, ID_SIZE);
     std::memcpy(&username, source + USERNAME_OFFSET, USERNAME_SIZE);
     std::memcpy(&email, source + EMAIL_OFFSET, EMAIL_SIZE);
-}
\ No newline at end of file
+}
+uint32_t Row::offset(Column column) {
+    switch (column) {
+        case Column::id:
+            return ID_OFFSET;
+        case Column::username:
+            return USERNAME_OFFSET;
+        case Column::email:
+            return EMAIL_OFFSET;
+    }
+    return 0;
+}
+
+uint32_t Row::size(Column column) {
+    switch (column) {
+        case Column::id:
+            return ID_SIZE;
+        case Column::username:
+            return USERNAME_SIZE;
+        case Column::email:
+            return EMAIL_SIZE;
+    }
+    return 0;
+}
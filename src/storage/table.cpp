@@ -1,56 +1,183 @@
 #include "eggshell/storage/table.hpp"
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <shared_mutex>
 
+#include "eggshell/executor/scheduler.hpp"
 #include "eggshell/storage/bplus/internalnode.hpp"
 #include "eggshell/storage/bplus/leafnode.hpp"
 #include "eggshell/storage/bplus/node.hpp"
+#include "eggshell/storage/wal.hpp"
+
+namespace {
+
+/* Times VACUUM rewrites under the shared lock before it locks writers out */
+const uint32_t VACUUM_ONLINE_ATTEMPTS = 3;
+
+/* Splits items into the fewest groups of at most size, as even as can be */
+std::vector<uint32_t> spread(uint32_t items, uint32_t size) {
+    uint32_t groups = std::max(1u, (items + size - 1) / size);
+    std::vector<uint32_t> sizes(groups, items / groups);
+    for (uint32_t i = 0; i < items % groups; i++) {
+        sizes[i]++;
+    }
+    return sizes;
+}
+
+/* Writes a page at its place in a plain file, or compressed into map */
+void write_page(int fd, uint32_t page_num, const char* page, PageMap* map) {
+    off_t offset = off_t(page_num) * Pager::PAGE_SIZE;
+    uint32_t size = Pager::PAGE_SIZE;
+    char stored[Pager::PAGE_SIZE];
+    if (map) {
+        size = PageMap::encode(page, stored);
+        offset = map->place(page_num, size).offset;
+        page = stored;
+    }
+    if (pwrite(fd, page, size, offset) != ssize_t(size)) {
+        std::cout << "Error writing: " << strerror(errno) << "\n";
+        exit(EXIT_FAILURE);
+    }
+}
 
-Table::Table(std::string filename) : pager{filename}, root_page_num{0} {
+/*
+Completes the swap of a VACUUM that crashed between its renames, or drops
+one that crashed before them, and returns filename to open
+*/
+const std::string& finish_vacuum(const std::string& filename) {
+    std::string vacuum_filename = Table::vacuum_filename(filename);
+    std::string vacuum_map = PageMap::filename(vacuum_filename);
+    if (std::filesystem::exists(vacuum_filename)) {
+        std::filesystem::remove(vacuum_filename);
+        std::filesystem::remove(vacuum_map);
+    } else if (std::filesystem::exists(vacuum_map)) {
+        std::filesystem::rename(vacuum_map, PageMap::filename(filename));
+    }
+    return filename;
+}
+
+}  // namespace
+
+Table::Table(std::string filename, Engine engine,
+             const PagerOptions& options)
+    : filename{filename},
+      pager{finish_vacuum(filename), options},
+      root_page_num{0} {
     if (pager.num_pages == 0) {
         // New database file. Initialize page 0 as leaf node.
         char* root_node = pager.get(0);
         LeafNode::init(root_node);
         Node::set_node_root(root_node, true);
     }
+
+    std::string lsm_dirname = LsmTree::dirname(filename);
+    if (engine == Engine::lsm || std::filesystem::exists(lsm_dirname)) {
+        lsm = std::make_unique<LsmTree>(lsm_dirname);
+    }
+
+    for (Column column : {Column::username, Column::email}) {
+        std::string index_filename = Index::filename(filename, column);
+        if (std::filesystem::exists(index_filename)) {
+            indexes[column] = std::make_unique<Index>(index_filename, column);
+        }
+    }
+    for (Column column : {Column::id, Column::username, Column::email}) {
+        std::string index_filename = HashIndex::filename(filename, column);
+        if (lsm && column == Column::id) {
+            continue;
+        }
+        if (std::filesystem::exists(index_filename)) {
+            hash_indexes[column] =
+                std::make_unique<HashIndex>(index_filename, column);
+        }
+    }
+
+    WarmSet set;
+    if (options.warm_restart && set.load(WarmSet::filename(filename))) {
+        pager.prefetch(set);
+    }
 }
 
 bool Table::flush() {
     std::fstream logfile{"temp.log",
                          logfile.binary | logfile.trunc | logfile.out};
-    for (const auto& [key, value] : pager.previous_pages) {
-        pager.log_transaction(key, logfile);
-        pager.flush(key);
+    for (uint32_t i = 0; i < pager.previous_pages.size(); i++) {
+        if (pager.previous_pages[i] == nullptr) continue;
+        pager.log_transaction(i, logfile);
+        pager.flush(i);
+        pager.frames.free(pager.previous_pages[i]);
     }
+    pager.save_map();
     // if transaction finished, then we don't need log
     // TODO: finish
     pager.previous_pages.clear();
     return false;
 }
 
+void Table::write_back() {
+    for (uint32_t i = 0; i < pager.pages.size(); i++) {
+        if (pager.pages[i] != nullptr) {
+            pager.flush(i);
+        }
+    }
+    pager.file.flush();
+    pager.save_map();
+    if (lsm) {
+        lsm->sync();
+    }
+}
+
+void Table::save_warm_set() {
+    if (!pager.options.warm_restart) {
+        return;
+    }
+    WarmSet set;
+    {
+        std::lock_guard lock(pager.mutex);
+        for (uint32_t i = 0; i < pager.pages.size(); i++) {
+            char* page = pager.pages[i];
+            if (page == nullptr) continue;
+            if (Node::get_node_type(page) == NodeType::internal) {
+                set.interior.push_back(i);
+            } else {
+                set.leaves.push_back(i);
+            }
+        }
+    }
+    set.save(WarmSet::filename(filename));
+}
+
 Table::~Table() {
-    for (uint32_t i = 0; i < pager.num_pages; i++) {
+    pager.stop_prefetch();
+    save_warm_set();
+    for (uint32_t i = 0; i < pager.pages.size(); i++) {
         if (pager.pages[i] == nullptr) continue;
         pager.flush(i);
-        delete[] pager.pages[i];
+        pager.frames.free(pager.pages[i]);
         pager.pages[i] = nullptr;
     }
+    pager.save_map();
 
     pager.file.close();
     if (!pager.file) {
         std::cout << "Error closing db file.\n";
         exit(EXIT_FAILURE);
     }
-    for (uint32_t i = 0; i < Pager::MAX_PAGES; i++) {
-        char* page = pager.pages[i];
-        if (page) {
-            delete[] page;
-            pager.pages[i] = nullptr;
-        }
-    }
 }
 
 Cursor Table::start() {
+    if (lsm) {
+        Cursor cursor{*this, 0, 0, false};
+        cursor.lsm = lsm->seek(0);
+        cursor.end_of_table = !cursor.lsm->valid();
+        return cursor;
+    }
     Cursor cursor = find(0);
 
     char* node = pager.get(cursor.page_num);
@@ -60,7 +187,51 @@ Cursor Table::start() {
     return cursor;
 }
 
+Cursor Table::lower_bound(uint32_t key) {
+    if (lsm) {
+        Cursor cursor{*this, 0, 0, false};
+        cursor.lsm = lsm->seek(key);
+        cursor.end_of_table = !cursor.lsm->valid();
+        return cursor;
+    }
+    Cursor cursor = find(key);
+
+    char* node = pager.get(cursor.page_num);
+    if (cursor.cell_num >= *LeafNode::num_cells(node)) {
+        /* advance() treats cell_num as the last visited cell */
+        cursor.cell_num = *LeafNode::num_cells(node) - 1;
+        cursor.advance();
+    }
+    return cursor;
+}
+
 Cursor Table::find(uint32_t key) {
+    if (lsm) {
+        /* Point lookup through the bloom filters of the runs */
+        Cursor cursor{*this, 0, 0, false};
+        cursor.lsm = lsm->find(key);
+        return cursor;
+    }
+
+    if (HashIndex* hash = hash_index(Column::id)) {
+        /*
+        Take the leaf the hash index points at if it holds the key. Anything
+        else, including the position to insert a new key, needs the descent.
+        */
+        std::vector<uint32_t> page_nums;
+        hash->find((const char*)&key, page_nums);
+        if (!page_nums.empty() && page_nums[0] < pager.num_pages) {
+            char* node = pager.get(page_nums[0]);
+            if (Node::get_node_type(node) == NodeType::leaf) {
+                Cursor cursor = LeafNode::find(*this, page_nums[0], key);
+                if (cursor.cell_num < *LeafNode::num_cells(node) &&
+                    *LeafNode::key(node, cursor.cell_num) == key) {
+                    return cursor;
+                }
+            }
+        }
+    }
+
     char* root_node = pager.get(root_page_num);
 
     if (Node::get_node_type(root_node) == NodeType::leaf) {
@@ -68,4 +239,452 @@ Cursor Table::find(uint32_t key) {
     } else {
         return InternalNode::find(*this, root_page_num, key);
     }
-}
\ No newline at end of file
+}
+
+Task<bool> Table::lookup(uint32_t key, Row& row, Scheduler& scheduler) {
+    while (true) {
+        uint32_t missing;
+        {
+            std::shared_lock lock(mutex);
+            if (lsm) {
+                Cursor cursor = find(key);
+                if (!cursor.at_key(key)) {
+                    co_return false;
+                }
+                row.deserialize(cursor.value());
+                co_return true;
+            }
+
+            missing = root_page_num;
+            while (pager.cached(missing)) {
+                char* node = pager.get(missing);
+                if (Node::get_node_type(node) == NodeType::leaf) {
+                    Cursor cursor = LeafNode::find(*this, missing, key);
+                    if (!cursor.at_key(key)) {
+                        co_return false;
+                    }
+                    row.deserialize(cursor.value());
+                    co_return true;
+                }
+                missing = *InternalNode::child(
+                    node, InternalNode::find_child(node, key));
+            }
+        }
+        co_await pager.fetch(missing, scheduler);
+    }
+}
+
+uint32_t Table::count() {
+    if (lsm) {
+        /* Runs overlap, so rows can only be counted through the merge */
+        uint32_t count = 0;
+        for (Cursor cursor = start(); !cursor.end_of_table; cursor.advance()) {
+            count++;
+        }
+        return count;
+    }
+    return Node::subtree_count(pager.get(root_page_num));
+}
+
+uint32_t Table::rank(uint32_t key) {
+    if (lsm) {
+        uint32_t rank = 0;
+        for (Cursor cursor = start(); !cursor.end_of_table && cursor.key() < key;
+             cursor.advance()) {
+            rank++;
+        }
+        return rank;
+    }
+    uint32_t rank = 0;
+    uint32_t page_num = root_page_num;
+    char* node = pager.get(page_num);
+    while (Node::get_node_type(node) == NodeType::internal) {
+        uint32_t child_index = InternalNode::find_child(node, key);
+        for (uint32_t i = 0; i < child_index; i++) {
+            rank += *InternalNode::child_count(node, i);
+        }
+        page_num = *InternalNode::child(node, child_index);
+        node = pager.get(page_num);
+    }
+    return rank + LeafNode::find(*this, page_num, key).cell_num;
+}
+
+Cursor Table::at(uint32_t position) {
+    if (lsm) {
+        Cursor cursor = start();
+        for (; position > 0 && !cursor.end_of_table; position--) {
+            cursor.advance();
+        }
+        return cursor;
+    }
+    uint32_t page_num = root_page_num;
+    char* node = pager.get(page_num);
+    if (position >= Node::subtree_count(node)) {
+        return Cursor{*this, page_num, 0, true};
+    }
+
+    while (Node::get_node_type(node) == NodeType::internal) {
+        uint32_t child_index = 0;
+        while (position >= *InternalNode::child_count(node, child_index)) {
+            position -= *InternalNode::child_count(node, child_index);
+            child_index++;
+        }
+        page_num = *InternalNode::child(node, child_index);
+        node = pager.get(page_num);
+    }
+    return Cursor{*this, page_num, position, false};
+}
+
+void Table::insert(const Cursor& cursor, Row& row) {
+    if (wal) {
+        wal->put(name, row);
+    }
+    uint32_t num_pages = pager.num_pages;
+    if (lsm) {
+        char value[sizeof(MemTable::Node::value)];
+        row.serialize(value);
+        lsm->put(row.id, value);
+    } else {
+        LeafNode::insert(cursor, row.id, row);
+    }
+
+    for (auto& [column, index] : indexes) {
+        index->insert(row);
+    }
+    char key[Row::EMAIL_SIZE];
+    for (auto& [column, hash] : hash_indexes) {
+        hash->make_key(row, key);
+        if (column != Column::id) {
+            hash->insert(key, row.id);
+            continue;
+        }
+
+        /*
+        Splits only move cells into newly allocated pages, so pointing the
+        keys of new leaves at them keeps every entry exact
+        */
+        hash->insert(key, cursor.page_num);
+        for (uint32_t page_num = num_pages; page_num < pager.num_pages;
+             page_num++) {
+            char* node = pager.get(page_num);
+            if (Node::get_node_type(node) != NodeType::leaf) {
+                continue;
+            }
+            uint32_t num_cells = *LeafNode::num_cells(node);
+            for (uint32_t i = 0; i < num_cells; i++) {
+                hash->insert((const char*)LeafNode::key(node, i), page_num);
+            }
+        }
+    }
+    version++;
+}
+
+void Table::update(Cursor& cursor, const Row& old_row) {
+    Row new_row;
+    bool reindexed = !indexes.empty() || !hash_indexes.empty();
+    if (reindexed || wal) {
+        new_row.deserialize(cursor.value());
+    }
+    if (wal) {
+        wal->put(name, new_row);
+    }
+    if (lsm) {
+        /* The cursor's value is a copy, or the memtable's own bytes */
+        lsm->put(old_row.id, cursor.value());
+    }
+    version++;
+    if (reindexed) {
+        reindex(old_row, new_row);
+    }
+}
+
+void Table::reindex(const Row& old_row, const Row& new_row) {
+    bool changed[] = {false, strcmp(old_row.username, new_row.username) != 0,
+                      strcmp(old_row.email, new_row.email) != 0};
+
+    for (auto& [column, index] : indexes) {
+        if (changed[int(column)]) {
+            index->remove(old_row);
+            index->insert(new_row);
+        }
+    }
+    char key[Row::EMAIL_SIZE];
+    for (auto& [column, hash] : hash_indexes) {
+        if (changed[int(column)]) {
+            hash->make_key(old_row, key);
+            hash->remove(key, old_row.id);
+            hash->make_key(new_row, key);
+            hash->insert(key, new_row.id);
+        }
+    }
+}
+
+bool Table::min_key(uint32_t& key) {
+    Cursor cursor = start();
+    if (cursor.end_of_table) {
+        return false;
+    }
+    key = cursor.key();
+    return true;
+}
+
+bool Table::max_key(uint32_t& key) {
+    uint32_t rows = count();
+    if (rows == 0) {
+        return false;
+    }
+    if (lsm) {
+        key = at(rows - 1).key();
+        return true;
+    }
+    key = Node::get_node_max_key(pager, pager.get(root_page_num));
+    return true;
+}
+
+std::vector<uint32_t> Table::split(uint32_t parts) {
+    std::vector<uint32_t> keys;
+    if (lsm || parts < 2) {
+        return keys;
+    }
+
+    /* Descend level by level until one has enough separators */
+    std::vector<uint32_t> level{root_page_num};
+    while (keys.size() < parts - 1 &&
+           Node::get_node_type(pager.get(level[0])) == NodeType::internal) {
+        std::vector<uint32_t> next_keys;
+        std::vector<uint32_t> children;
+        for (uint32_t page_num : level) {
+            char* node = pager.get(page_num);
+            uint32_t num_keys = *InternalNode::num_keys(node);
+            for (uint32_t i = 0; i < num_keys; i++) {
+                next_keys.push_back(*InternalNode::key(node, i));
+                children.push_back(*InternalNode::child(node, i));
+            }
+            children.push_back(*InternalNode::right_child(node));
+        }
+        keys = std::move(next_keys);
+        level = std::move(children);
+    }
+    if (keys.size() <= parts - 1) {
+        return keys;
+    }
+
+    /* Every n-th separator of the level */
+    std::vector<uint32_t> chosen;
+    for (uint32_t i = 1; i < parts; i++) {
+        chosen.push_back(keys[uint64_t(i) * keys.size() / parts]);
+    }
+    chosen.erase(std::unique(chosen.begin(), chosen.end()), chosen.end());
+    return chosen;
+}
+
+void Table::create_index(Column column) {
+    if (indexes.contains(column)) {
+        return;
+    }
+    if (wal) {
+        wal->create_index(name, column, false);
+    }
+    std::string index_filename = Index::filename(filename, column);
+    std::ofstream{index_filename, std::ios::trunc};
+    auto index = std::make_unique<Index>(index_filename, column);
+
+    Row row;
+    for (Cursor cursor = start(); !cursor.end_of_table; cursor.advance()) {
+        row.deserialize(cursor.value());
+        index->insert(row);
+    }
+    indexes[column] = std::move(index);
+}
+
+Index* Table::index(Column column) {
+    auto it = indexes.find(column);
+    return it == indexes.end() ? nullptr : it->second.get();
+}
+
+void Table::create_hash_index(Column column) {
+    /* LSM runs have bloom filters, and no leaf pages to point at */
+    if (hash_indexes.contains(column) || (lsm && column == Column::id)) {
+        return;
+    }
+    if (wal) {
+        wal->create_index(name, column, true);
+    }
+    build_hash_index(column);
+}
+
+void Table::build_hash_index(Column column) {
+    std::string index_filename = HashIndex::filename(filename, column);
+    std::ofstream{index_filename, std::ios::trunc};
+    auto hash = std::make_unique<HashIndex>(index_filename, column);
+
+    Row row;
+    char key[Row::EMAIL_SIZE];
+    for (Cursor cursor = start(); !cursor.end_of_table; cursor.advance()) {
+        row.deserialize(cursor.value());
+        hash->make_key(row, key);
+        hash->insert(key, column == Column::id ? cursor.page_num : row.id);
+    }
+    hash_indexes[column] = std::move(hash);
+}
+
+HashIndex* Table::hash_index(Column column) {
+    auto it = hash_indexes.find(column);
+    return it == hash_indexes.end() ? nullptr : it->second.get();
+}
+
+void Table::vacuum(uint32_t fill_percent) {
+    if (lsm) {
+        return;
+    }
+    uint32_t leaf_cells = std::max(
+        1u, uint32_t(uint64_t(LeafNode::LEAF_NODE_MAX_CELLS) * fill_percent /
+                     100));
+    std::string vacuum_filename = Table::vacuum_filename(filename);
+
+    for (uint32_t attempt = 0;; attempt++) {
+        bool online = attempt < VACUUM_ONLINE_ATTEMPTS;
+        std::shared_lock shared(mutex, std::defer_lock);
+        std::unique_lock exclusive(mutex, std::defer_lock);
+        if (online) {
+            shared.lock();
+        } else {
+            exclusive.lock();
+        }
+        uint64_t written_version = version;
+        write_compacted(vacuum_filename, leaf_cells);
+        if (online) {
+            shared.unlock();
+            exclusive.lock();
+            if (version != written_version) {
+                continue;
+            }
+        }
+
+        /* The map last, see finish_vacuum */
+        std::filesystem::rename(vacuum_filename, filename);
+        if (pager.map) {
+            std::filesystem::rename(PageMap::filename(vacuum_filename),
+                                    pager.map_filename);
+        }
+        pager.reopen(filename);
+        if (hash_indexes.erase(Column::id)) {
+            /* It holds leaf page numbers, which all moved */
+            build_hash_index(Column::id);
+        }
+        return;
+    }
+}
+
+std::string Table::vacuum_filename(const std::string& filename) {
+    return filename + ".vacuum";
+}
+
+uint32_t Table::write_compacted(const std::string& vacuum_filename,
+                                uint32_t leaf_cells) {
+    /*
+    Node sizes level by level from the leaves up, and the page of each
+    node: the leaves in order from page 1, then each level of internal
+    nodes, the root taking page 0
+    */
+    std::vector<std::vector<uint32_t>> sizes{spread(count(), leaf_cells)};
+    while (sizes.back().size() > 1) {
+        sizes.push_back(spread(sizes.back().size(),
+                               InternalNode::INTERNAL_NODE_MAX_CELLS + 1));
+    }
+    std::vector<std::vector<uint32_t>> pages(sizes.size());
+    uint32_t next_page = 1;
+    for (uint32_t level = 0; level < sizes.size(); level++) {
+        for (uint32_t i = 0; i < sizes[level].size(); i++) {
+            bool root = level + 1 == sizes.size();
+            pages[level].push_back(root ? 0 : next_page++);
+        }
+    }
+    /* Parent page of every node below the root */
+    auto parents = [&](uint32_t level) {
+        std::vector<uint32_t> parent;
+        if (level + 1 < sizes.size()) {
+            for (uint32_t i = 0; i < sizes[level + 1].size(); i++) {
+                parent.insert(parent.end(), sizes[level + 1][i],
+                              pages[level + 1][i]);
+            }
+        }
+        return parent;
+    };
+
+    int fd = open(vacuum_filename.c_str(),
+                  O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        std::cout << "Unable to open file " << vacuum_filename << "\n";
+        exit(EXIT_FAILURE);
+    }
+    char page[Pager::PAGE_SIZE];
+    /* A compressed table is rewritten compressed, into a map of its own */
+    std::unique_ptr<PageMap> map;
+    if (pager.map) {
+        map = std::make_unique<PageMap>();
+    }
+
+    /* Largest key and row count under each node of the level just written */
+    std::vector<uint32_t> max_keys, counts;
+    std::vector<uint32_t> parent = parents(0);
+    Cursor cursor = start();
+    for (uint32_t i = 0; i < sizes[0].size(); i++) {
+        memset(page, 0, sizeof(page));
+        LeafNode::init(page);
+        Node::set_node_root(page, sizes.size() == 1);
+        *Node::node_parent(page) = parent.empty() ? 0 : parent[i];
+        *LeafNode::next_leaf(page) =
+            i + 1 < sizes[0].size() ? pages[0][i + 1] : 0;
+        *LeafNode::num_cells(page) = sizes[0][i];
+        for (uint32_t cell = 0; cell < sizes[0][i]; cell++) {
+            *LeafNode::key(page, cell) = cursor.key();
+            memcpy(LeafNode::value(page, cell), cursor.value(),
+                   LeafNode::LEAF_NODE_VALUE_SIZE);
+            cursor.advance();
+        }
+        write_page(fd, pages[0][i], page, map.get());
+        max_keys.push_back(sizes[0][i] ? *LeafNode::key(page, sizes[0][i] - 1)
+                                       : 0);
+        counts.push_back(sizes[0][i]);
+    }
+
+    for (uint32_t level = 1; level < sizes.size(); level++) {
+        parent = parents(level);
+        std::vector<uint32_t> level_max_keys, level_counts;
+        uint32_t child = 0;
+        for (uint32_t i = 0; i < sizes[level].size(); i++) {
+            memset(page, 0, sizeof(page));
+            InternalNode::init(page);
+            Node::set_node_root(page, level + 1 == sizes.size());
+            *Node::node_parent(page) = parent.empty() ? 0 : parent[i];
+            uint32_t num_keys = sizes[level][i] - 1;
+            *InternalNode::num_keys(page) = num_keys;
+            uint32_t total = 0;
+            for (uint32_t k = 0; k <= num_keys; k++, child++) {
+                if (k < num_keys) {
+                    *InternalNode::cell(page, k) = pages[level - 1][child];
+                    *InternalNode::key(page, k) = max_keys[child];
+                } else {
+                    *InternalNode::right_child(page) = pages[level - 1][child];
+                }
+                *InternalNode::child_count(page, k) = counts[child];
+                total += counts[child];
+            }
+            write_page(fd, pages[level][i], page, map.get());
+            level_max_keys.push_back(max_keys[child - 1]);
+            level_counts.push_back(total);
+        }
+        max_keys.swap(level_max_keys);
+        counts.swap(level_counts);
+    }
+
+    if (fsync(fd) < 0 || close(fd) < 0) {
+        std::cout << "Error writing: " << strerror(errno) << "\n";
+        exit(EXIT_FAILURE);
+    }
+    if (map) {
+        map->save(PageMap::filename(vacuum_filename));
+    }
+    return next_page;
+}
@@ -0,0 +1,226 @@
+#include "eggshell/storage/wal.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+template <typename T>
+void write_field(std::string& out, T value) {
+    out.append((const char*)&value, sizeof(value));
+}
+
+template <typename T>
+bool read_field(std::string_view& in, T& value) {
+    if (in.size() < sizeof(value)) {
+        return false;
+    }
+    memcpy(&value, in.data(), sizeof(value));
+    in.remove_prefix(sizeof(value));
+    return true;
+}
+
+/* Largest payload a record can have, a put under the longest name */
+uint32_t max_payload() {
+    return sizeof(WalRecordType) + sizeof(uint64_t) + sizeof(int64_t) +
+           sizeof(uint8_t) + UINT8_MAX + Row::SIZE;
+}
+
+}  // namespace
+
+void WalRecord::serialize(std::string& out) const {
+    size_t start = out.size();
+    write_field(out, uint32_t(0));
+    write_field(out, type);
+    write_field(out, lsn);
+    write_field(out, time);
+    write_field(out, uint8_t(table.size()));
+    out.append(table);
+    if (type == WalRecordType::put) {
+        size_t at = out.size();
+        out.resize(at + Row::SIZE);
+        row.serialize(out.data() + at);
+    } else if (type == WalRecordType::create_table) {
+        write_field(out, spec.partitions);
+        write_field(out, uint8_t(spec.range));
+        write_field(out, spec.range_width);
+    } else {
+        write_field(out, uint8_t(column));
+        write_field(out, uint8_t(hash));
+    }
+    uint32_t length = out.size() - start - sizeof(length);
+    memcpy(out.data() + start, &length, sizeof(length));
+}
+
+bool WalRecord::deserialize(std::string_view payload) {
+    uint8_t name_size, flag, value;
+    if (!read_field(payload, type) || !read_field(payload, lsn) ||
+        !read_field(payload, time) || !read_field(payload, name_size) ||
+        payload.size() < name_size) {
+        return false;
+    }
+    table = payload.substr(0, name_size);
+    payload.remove_prefix(name_size);
+
+    switch (type) {
+        case WalRecordType::put:
+            if (payload.size() != Row::SIZE) {
+                return false;
+            }
+            row.deserialize(payload.data());
+            return true;
+        case WalRecordType::create_table:
+            if (!read_field(payload, spec.partitions) ||
+                !read_field(payload, flag) ||
+                !read_field(payload, spec.range_width)) {
+                return false;
+            }
+            spec.range = flag;
+            return true;
+        case WalRecordType::create_index:
+            if (!read_field(payload, value) || !read_field(payload, flag) ||
+                value > uint8_t(Column::email)) {
+                return false;
+            }
+            column = Column(value);
+            hash = flag;
+            return true;
+    }
+    return false;
+}
+
+std::string Wal::filename(const std::string& database) {
+    return database + ".wal";
+}
+
+Wal::Wal(std::string filename) {
+    WalReader reader{filename};
+    WalRecord record;
+    while (reader.next(record)) {
+        last_lsn = record.lsn;
+    }
+
+    fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC,
+                0644);
+    if (fd < 0) {
+        std::cout << "Unable to open write-ahead log " << filename << "\n";
+        exit(EXIT_FAILURE);
+    }
+    if (reader.offset() < uint64_t(lseek(fd, 0, SEEK_END))) {
+        /* A record cut short by a crash, which nothing was applied from */
+        if (ftruncate(fd, reader.offset()) < 0) {
+            std::cout << "Error truncating write-ahead log: "
+                      << strerror(errno) << "\n";
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+Wal::~Wal() {
+    close(fd);
+}
+
+void Wal::put(std::string_view table, const Row& row) {
+    WalRecord record;
+    record.type = WalRecordType::put;
+    record.table = table;
+    record.row = row;
+    append(record);
+}
+
+void Wal::create_table(std::string_view table, const PartitionSpec& spec) {
+    WalRecord record;
+    record.type = WalRecordType::create_table;
+    record.table = table;
+    record.spec = spec;
+    append(record);
+}
+
+void Wal::create_index(std::string_view table, Column column, bool hash) {
+    WalRecord record;
+    record.type = WalRecordType::create_index;
+    record.table = table;
+    record.column = column;
+    record.hash = hash;
+    append(record);
+}
+
+uint64_t Wal::lsn() {
+    std::lock_guard lock(mutex);
+    return last_lsn;
+}
+
+void Wal::append(WalRecord& record) {
+    std::lock_guard lock(mutex);
+    record.lsn = ++last_lsn;
+    record.time = std::chrono::duration_cast<std::chrono::microseconds>(
+                      std::chrono::system_clock::now().time_since_epoch())
+                      .count();
+    frame.clear();
+    record.serialize(frame);
+
+    size_t written = 0;
+    while (written < frame.size()) {
+        ssize_t n = write(fd, frame.data() + written, frame.size() - written);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0) {
+            std::cout << "Error writing write-ahead log: " << strerror(errno)
+                      << "\n";
+            exit(EXIT_FAILURE);
+        }
+        written += n;
+    }
+}
+
+WalReader::WalReader(std::string filename) : filename{filename} {
+}
+
+WalReader::~WalReader() {
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+bool WalReader::open() {
+    if (fd < 0) {
+        fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    }
+    return fd >= 0;
+}
+
+bool WalReader::next(WalRecord& record) {
+    uint32_t length;
+    if (!open() ||
+        pread(fd, &length, sizeof(length), position) != sizeof(length)) {
+        return false;
+    }
+    /* Checked before reading, a corrupt length must not size the buffer */
+    bool corrupt = length > max_payload();
+    if (!corrupt) {
+        payload.resize(length);
+        if (pread(fd, payload.data(), length, position + sizeof(length)) !=
+            ssize_t(length)) {
+            return false;
+        }
+    }
+    if (corrupt || !record.deserialize(payload)) {
+        std::cout << "Corrupt write-ahead log " << filename << " at "
+                  << position << "\n";
+        exit(EXIT_FAILURE);
+    }
+    position += sizeof(length) + length;
+    return true;
+}
+
+uint64_t WalReader::offset() const {
+    return position;
+}
+
+void WalReader::seek(uint64_t offset) {
+    position = offset;
+}
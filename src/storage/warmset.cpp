@@ -0,0 +1,56 @@
+#include "eggshell/storage/warmset.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+std::string WarmSet::filename(const std::string& table_filename) {
+    return table_filename + ".warm";
+}
+
+bool WarmSet::load(const std::string& filename) {
+    std::ifstream file{filename, std::ios::binary};
+    if (!file) {
+        return false;
+    }
+    file.seekg(0, file.end);
+    uint64_t size = file.tellg();
+    file.seekg(0);
+    uint32_t counts[2] = {0, 0};
+    file.read((char*)counts, sizeof(counts));
+    /* Only a hint, so a bad set is dropped rather than fatal */
+    if (!file || size != sizeof(counts) + (uint64_t(counts[0]) + counts[1]) *
+                                              sizeof(uint32_t)) {
+        return false;
+    }
+    interior.resize(counts[0]);
+    leaves.resize(counts[1]);
+    file.read((char*)interior.data(), counts[0] * sizeof(uint32_t));
+    file.read((char*)leaves.data(), counts[1] * sizeof(uint32_t));
+    if (!file) {
+        interior.clear();
+        leaves.clear();
+        return false;
+    }
+    return true;
+}
+
+void WarmSet::save(const std::string& filename) const {
+    {
+        std::ofstream file{filename + ".tmp",
+                           std::ios::binary | std::ios::trunc};
+        uint32_t counts[2] = {uint32_t(interior.size()),
+                              uint32_t(leaves.size())};
+        file.write((const char*)counts, sizeof(counts));
+        file.write((const char*)interior.data(),
+                   interior.size() * sizeof(uint32_t));
+        file.write((const char*)leaves.data(), leaves.size() * sizeof(uint32_t));
+        if (!file) {
+            std::cout << "Error writing: " << strerror(errno) << "\n";
+            exit(EXIT_FAILURE);
+        }
+    }
+    std::filesystem::rename(filename + ".tmp", filename);
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <eggshell/executor/scheduler.hpp>
+#include <eggshell/storage/table.hpp>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "tempfile.hpp"
+
+namespace {
+
+/* Even keys 2..6000, enough leaves for a few levels */
+void fill(const std::string& path) {
+    Table table{path};
+    Row row{};
+    for (uint32_t key = 2; key <= 6000; key += 2) {
+        row.id = key;
+        snprintf(row.username, sizeof(row.username), "u%u", key);
+        snprintf(row.email, sizeof(row.email), "e%u@x", key);
+        table.insert(table.find(key), row);
+    }
+}
+
+void lookups_match(bool use_io_uring) {
+    TempFile file{use_io_uring ? "async_test_ring" : "async_test_pread"};
+    fill(file.path);
+
+    /* Reopened, so every page starts out on disk */
+    Table table{file.path};
+    Scheduler scheduler{2, use_io_uring};
+    const uint32_t keys = 6002;
+    std::vector<Row> rows(keys);
+    std::vector<Task<bool>> tasks;
+    for (uint32_t key = 0; key < keys; key++) {
+        tasks.push_back(table.lookup(key, rows[key], scheduler));
+    }
+    scheduler.run(tasks, 128);
+
+    for (uint32_t key = 0; key < keys; key++) {
+        bool present = key >= 2 && key <= 6000 && key % 2 == 0;
+        ASSERT_EQ(tasks[key].result(), present) << key;
+        if (present) {
+            EXPECT_EQ(rows[key].id, key);
+            EXPECT_EQ(std::string(rows[key].username),
+                      "u" + std::to_string(key));
+        }
+    }
+    for (uint32_t page_num = 0; page_num < table.pager.num_pages; page_num++) {
+        EXPECT_TRUE(table.pager.cached(page_num));
+    }
+}
+
+}  // namespace
+
+TEST(AsyncTest, LookupsThroughIoRing) {
+    Scheduler probe{1};
+    if (!probe.io_uring()) {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+    lookups_match(true);
+}
+
+TEST(AsyncTest, LookupsThroughReaderThreads) {
+    lookups_match(false);
+}
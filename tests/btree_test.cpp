@@ -1,3 +1,213 @@
 #include <gtest/gtest.h>
 
-#include <eggshell/storage/table.hpp>
\ No newline at end of file
+#include <algorithm>
+#include <cstdio>
+#include <eggshell/storage/bplus/internalnode.hpp>
+#include <eggshell/storage/bplus/leafnode.hpp>
+#include <eggshell/storage/bplus/node.hpp>
+#include <eggshell/storage/table.hpp>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include "tempfile.hpp"
+
+namespace {
+
+void insert_key(Table& table, uint32_t key) {
+    Row row{};
+    row.id = key;
+    snprintf(row.username, sizeof(row.username), "user%u", key);
+    snprintf(row.email, sizeof(row.email), "user%u@example.com", key);
+    Cursor cursor = table.find(key);
+    LeafNode::insert(cursor, key, row);
+}
+
+/*
+Checks key bounds, parent pointers and subtree counts, returns the number of
+cells
+*/
+uint32_t validate(Table& table, uint32_t page_num, uint32_t parent,
+                  int64_t low, int64_t high) {
+    char* node = table.pager.get(page_num);
+    if (page_num != table.root_page_num) {
+        EXPECT_EQ(*Node::node_parent(node), parent) << "page " << page_num;
+    }
+    if (Node::get_node_type(node) == NodeType::leaf) {
+        uint32_t num_cells = *LeafNode::num_cells(node);
+        for (uint32_t i = 0; i < num_cells; i++) {
+            uint32_t key = *LeafNode::key(node, i);
+            EXPECT_GT(key, low) << "page " << page_num;
+            EXPECT_LE(key, high) << "page " << page_num;
+        }
+        return num_cells;
+    }
+    uint32_t num_keys = *InternalNode::num_keys(node);
+    uint32_t count = 0;
+    int64_t child_low = low;
+    for (uint32_t i = 0; i < num_keys; i++) {
+        uint32_t key = *InternalNode::key(node, i);
+        uint32_t child_count = validate(table, *InternalNode::child(node, i),
+                                        page_num, child_low, key);
+        EXPECT_EQ(*InternalNode::child_count(node, i), child_count)
+            << "page " << page_num;
+        count += child_count;
+        child_low = key;
+    }
+    uint32_t right_count = validate(table, *InternalNode::right_child(node),
+                                    page_num, child_low, high);
+    EXPECT_EQ(*InternalNode::child_count(node, num_keys), right_count)
+        << "page " << page_num;
+    return count + right_count;
+}
+
+}  // namespace
+
+TEST(BTreeTest, SequentialInsertKeepsOrder) {
+    TempFile file{"btree_test_sequential"};
+    Table table{file.path};
+    for (uint32_t key = 1; key <= 300; key++) {
+        insert_key(table, key);
+    }
+    EXPECT_EQ(validate(table, table.root_page_num, 0, 0, UINT32_MAX), 300);
+
+    Cursor cursor = table.start();
+    for (uint32_t key = 1; key <= 300; key++) {
+        ASSERT_FALSE(cursor.end_of_table);
+        EXPECT_EQ(cursor.key(), key);
+        cursor.advance();
+    }
+    EXPECT_TRUE(cursor.end_of_table);
+}
+
+TEST(BTreeTest, RandomInsertKeepsInvariants) {
+    std::vector<uint32_t> keys(400);
+    for (uint32_t i = 0; i < keys.size(); i++) {
+        keys[i] = i + 1;
+    }
+    for (uint32_t seed = 1; seed <= 5; seed++) {
+        TempFile file{"btree_test_random"};
+        Table table{file.path};
+        std::shuffle(keys.begin(), keys.end(), std::mt19937{seed});
+
+        for (uint32_t i = 0; i < keys.size(); i++) {
+            insert_key(table, keys[i]);
+            ASSERT_EQ(validate(table, table.root_page_num, 0, 0, UINT32_MAX),
+                      i + 1)
+                << "seed " << seed << ", after inserting " << keys[i];
+        }
+    }
+}
+
+TEST(BTreeTest, LowerBoundSkipsToNextLeaf) {
+    TempFile file{"btree_test_lower_bound"};
+    Table table{file.path};
+    for (uint32_t key = 2; key <= 200; key += 2) {
+        insert_key(table, key);
+    }
+    for (uint32_t key = 1; key < 200; key += 2) {
+        Cursor cursor = table.lower_bound(key);
+        ASSERT_FALSE(cursor.end_of_table);
+        EXPECT_EQ(cursor.key(), key + 1);
+    }
+    EXPECT_TRUE(table.lower_bound(201).end_of_table);
+}
+
+TEST(BTreeTest, RankAndPositionUseSubtreeCounts) {
+    TempFile file{"btree_test_rank"};
+    Table table{file.path};
+    std::vector<uint32_t> keys;
+    for (uint32_t key = 3; key <= 900; key += 3) {
+        keys.push_back(key);
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937{7});
+    for (uint32_t key : keys) {
+        insert_key(table, key);
+    }
+
+    EXPECT_EQ(table.count(), 300);
+    EXPECT_EQ(table.rank(0), 0);
+    EXPECT_EQ(table.rank(3), 0);
+    EXPECT_EQ(table.rank(4), 1);
+    EXPECT_EQ(table.rank(450), 149);
+    EXPECT_EQ(table.rank(UINT32_MAX), 300);
+    for (uint32_t position = 0; position < 300; position++) {
+        Cursor cursor = table.at(position);
+        ASSERT_FALSE(cursor.end_of_table);
+        EXPECT_EQ(cursor.key(), (position + 1) * 3);
+    }
+    EXPECT_TRUE(table.at(300).end_of_table);
+}
+
+TEST(BTreeTest, VacuumWritesLeavesInKeyOrder) {
+    std::vector<uint32_t> keys(1500);
+    for (uint32_t i = 0; i < keys.size(); i++) {
+        keys[i] = 2 * (i + 1);
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937{7});
+
+    for (uint32_t fill : {100u, 50u}) {
+        TempFile file{"btree_test_vacuum"};
+        {
+            Table table{file.path};
+            for (uint32_t key : keys) {
+                insert_key(table, key);
+            }
+            table.create_hash_index(Column::id);
+            uint32_t pages_before = table.pager.num_pages;
+            table.vacuum(fill);
+            ASSERT_EQ(validate(table, table.root_page_num, 0, 0, UINT32_MAX),
+                      keys.size());
+            if (fill == 100) {
+                EXPECT_LT(table.pager.num_pages, pages_before);
+            }
+
+            /* Leaves are pages 1, 2, ... in key order, as full as asked */
+            uint32_t leaf_cells = LeafNode::LEAF_NODE_MAX_CELLS * fill / 100;
+            Cursor cursor = table.start();
+            uint32_t expected_page = 1;
+            uint32_t key = 2;
+            while (!cursor.end_of_table) {
+                ASSERT_EQ(cursor.page_num, expected_page);
+                char* node = table.pager.get(cursor.page_num);
+                EXPECT_LE(*LeafNode::num_cells(node), leaf_cells);
+                EXPECT_GE(*LeafNode::num_cells(node), leaf_cells - 1);
+                for (uint32_t i = 0; i < *LeafNode::num_cells(node); i++) {
+                    ASSERT_EQ(cursor.key(), key);
+                    key += 2;
+                    cursor.advance();
+                }
+                expected_page++;
+            }
+            EXPECT_EQ(key, 2 * keys.size() + 2);
+            EXPECT_TRUE(table.find(1000).at_key(1000));
+
+            /* Still a tree that takes inserts */
+            for (uint32_t odd = 1; odd < 600; odd += 2) {
+                insert_key(table, odd);
+            }
+            ASSERT_EQ(validate(table, table.root_page_num, 0, 0, UINT32_MAX),
+                      keys.size() + 300);
+        }
+
+        Table reopened{file.path};
+        EXPECT_EQ(validate(reopened, reopened.root_page_num, 0, 0, UINT32_MAX),
+                  keys.size() + 300);
+    }
+}
+
+TEST(BTreeTest, VacuumOfSmallTables) {
+    for (uint32_t rows : {0u, 1u, LeafNode::LEAF_NODE_MAX_CELLS + 1}) {
+        TempFile file{"btree_test_small"};
+        Table table{file.path};
+        for (uint32_t key = 1; key <= rows; key++) {
+            insert_key(table, key);
+        }
+        table.vacuum(100);
+        EXPECT_EQ(validate(table, table.root_page_num, 0, 0, UINT32_MAX),
+                  rows);
+        EXPECT_EQ(table.pager.num_pages, rows > 1 ? 3u : 1u);
+        insert_key(table, rows + 1);
+        EXPECT_EQ(table.count(), rows + 1);
+    }
+}
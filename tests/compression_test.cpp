@@ -0,0 +1,235 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <eggshell/executor/scheduler.hpp>
+#include <eggshell/storage/catalog.hpp>
+#include <eggshell/storage/compress.hpp>
+#include <eggshell/storage/table.hpp>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "tempfile.hpp"
+
+namespace {
+
+const uint32_t PAGE_SIZE = Pager::PAGE_SIZE;
+
+void insert_rows(Table& table, uint32_t from, uint32_t to) {
+    Row row{};
+    for (uint32_t key = from; key <= to; key++) {
+        row.id = key;
+        snprintf(row.username, sizeof(row.username), "user%u", key);
+        snprintf(row.email, sizeof(row.email), "user%u@example.com", key);
+        table.insert(table.find(key), row);
+    }
+}
+
+/* Scans the table, checking it holds exactly keys from..to */
+void expect_rows(Table& table, uint32_t from, uint32_t to) {
+    Row row;
+    uint32_t key = from;
+    for (Cursor cursor = table.start(); !cursor.end_of_table;
+         cursor.advance()) {
+        row.deserialize(cursor.value());
+        ASSERT_EQ(row.id, key);
+        ASSERT_EQ(std::string(row.email),
+                  "user" + std::to_string(key) + "@example.com");
+        key++;
+    }
+    EXPECT_EQ(key, to + 1);
+}
+
+}  // namespace
+
+TEST(CompressionTest, RoundTrip) {
+    std::mt19937 random{3};
+    std::vector<std::vector<char>> inputs;
+    inputs.emplace_back(PAGE_SIZE, 0);
+    inputs.emplace_back(0);
+    inputs.emplace_back(5, 'a');
+    std::vector<char> text(PAGE_SIZE, 0);
+    for (uint32_t i = 0; i < text.size(); i += 300) {
+        snprintf(&text[i], 40, "user%u@example.com", i);
+    }
+    inputs.push_back(text);
+    std::vector<char> noise(PAGE_SIZE);
+    for (char& c : noise) {
+        c = char(random());
+    }
+    inputs.push_back(noise);
+
+    for (const std::vector<char>& input : inputs) {
+        uint32_t size = input.size();
+        std::vector<char> compressed(size + size / 255 + 16);
+        uint32_t compressed_size = Compression::compress(
+            input.data(), size, compressed.data(), compressed.size());
+        ASSERT_GT(compressed_size, 0u);
+        std::vector<char> output(size);
+        ASSERT_TRUE(Compression::decompress(compressed.data(), compressed_size,
+                                            output.data(), size));
+        EXPECT_EQ(output, input);
+        if (size > 0) {
+            /* A block must expand to exactly the size asked for */
+            EXPECT_FALSE(Compression::decompress(
+                compressed.data(), compressed_size, output.data(), size - 1));
+        }
+    }
+
+    std::vector<char> out(PAGE_SIZE);
+    EXPECT_LT(Compression::compress(text.data(), text.size(), out.data(),
+                                    out.size()),
+              PAGE_SIZE / 8);
+    /* Noise does not shrink, so it does not fit in less than a page */
+    EXPECT_EQ(Compression::compress(noise.data(), noise.size(), out.data(),
+                                    PAGE_SIZE - 1),
+              0u);
+}
+
+TEST(CompressionTest, CompressedTableIsSmaller) {
+    TempFile plain{"compression_test_plain"};
+    TempFile compressed{"compression_test_compressed"};
+    for (const TempFile* file : {&plain, &compressed}) {
+        Table table{file->path, Engine::btree,
+                    {.compress = file == &compressed}};
+        insert_rows(table, 1, 3000);
+    }
+    EXPECT_FALSE(std::filesystem::exists(PageMap::filename(plain.path)));
+    ASSERT_TRUE(std::filesystem::exists(PageMap::filename(compressed.path)));
+    uint64_t plain_size = std::filesystem::file_size(plain.path);
+    uint64_t compressed_size = std::filesystem::file_size(compressed.path);
+    EXPECT_LT(compressed_size * 4, plain_size);
+
+    /* Reopened without asking, the map says the pages are compressed */
+    Table table{compressed.path};
+    ASSERT_NE(table.pager.map, nullptr);
+    expect_rows(table, 1, 3000);
+    EXPECT_LE(table.pager.bytes_read, compressed_size);
+    EXPECT_LT(table.pager.bytes_read * 4,
+              uint64_t(table.pager.num_pages) * PAGE_SIZE);
+}
+
+TEST(CompressionTest, PagesGrowAcrossReopens) {
+    TempFile file{"compression_test_grow"};
+    {
+        Table table{file.path, Engine::btree, {.compress = true}};
+        insert_rows(table, 1, 100);
+    }
+    /* Leaves written nearly empty fill up and outgrow their slots */
+    for (uint32_t from : {101u, 1001u}) {
+        Table table{file.path};
+        expect_rows(table, 1, from - 1);
+        insert_rows(table, from, from == 101 ? 1000 : 2000);
+    }
+    Table table{file.path};
+    expect_rows(table, 1, 2000);
+    EXPECT_EQ(table.count(), 2000u);
+}
+
+TEST(CompressionTest, VacuumKeepsPagesCompressed) {
+    TempFile file{"compression_test_vacuum"};
+    {
+        Table table{file.path, Engine::btree, {.compress = true}};
+        std::vector<uint32_t> keys(2000);
+        for (uint32_t i = 0; i < keys.size(); i++) {
+            keys[i] = i + 1;
+        }
+        std::shuffle(keys.begin(), keys.end(), std::mt19937{5});
+        for (uint32_t key : keys) {
+            insert_rows(table, key, key);
+        }
+    }
+    uint64_t before = std::filesystem::file_size(file.path);
+    {
+        Table table{file.path};
+        table.vacuum(100);
+        ASSERT_NE(table.pager.map, nullptr);
+        expect_rows(table, 1, 2000);
+    }
+    EXPECT_LT(std::filesystem::file_size(file.path), before);
+    Table table{file.path};
+    expect_rows(table, 1, 2000);
+}
+
+/* Restarts from the states a crash during VACUUM's swap can leave */
+TEST(CompressionTest, VacuumCrashBetweenRenames) {
+    TempFile file{"compression_test_vacuum_crash"};
+    TempFile vacuumed{"compression_test_vacuum_crash_new"};
+    {
+        Table table{file.path, Engine::btree, {.compress = true}};
+        insert_rows(table, 1, 1000);
+    }
+    {
+        Table table{vacuumed.path, Engine::btree, {.compress = true}};
+        insert_rows(table, 1, 2000);
+        table.vacuum(100);
+    }
+
+    /* Before the data file was renamed: the old table stays */
+    std::string vacuum = Table::vacuum_filename(file.path);
+    std::filesystem::copy_file(vacuumed.path, vacuum);
+    std::filesystem::copy_file(PageMap::filename(vacuumed.path),
+                               PageMap::filename(vacuum));
+    {
+        Table table{file.path};
+        expect_rows(table, 1, 1000);
+    }
+    EXPECT_FALSE(std::filesystem::exists(vacuum));
+    EXPECT_FALSE(std::filesystem::exists(PageMap::filename(vacuum)));
+
+    /* After it, with the new map not yet renamed: the new table */
+    std::filesystem::copy_file(
+        vacuumed.path, file.path,
+        std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::copy_file(PageMap::filename(vacuumed.path),
+                               PageMap::filename(vacuum));
+    {
+        Table table{file.path};
+        expect_rows(table, 1, 2000);
+    }
+    EXPECT_FALSE(std::filesystem::exists(PageMap::filename(vacuum)));
+    Table table{file.path};
+    expect_rows(table, 1, 2000);
+}
+
+TEST(CompressionTest, CoroutineLookups) {
+    TempFile file{"compression_test_lookup"};
+    {
+        Table table{file.path, Engine::btree, {.compress = true}};
+        insert_rows(table, 1, 3000);
+    }
+    Table table{file.path};
+    Scheduler scheduler{2, false};
+    std::vector<Row> rows(3000);
+    std::vector<Task<bool>> tasks;
+    for (uint32_t key = 1; key <= rows.size(); key++) {
+        tasks.push_back(table.lookup(key, rows[key - 1], scheduler));
+    }
+    scheduler.run(tasks, 64);
+    for (uint32_t key = 1; key <= rows.size(); key++) {
+        ASSERT_TRUE(tasks[key - 1].result());
+        EXPECT_EQ(std::string(rows[key - 1].username),
+                  "user" + std::to_string(key));
+    }
+}
+
+TEST(CompressionTest, CatalogTablesInheritCompression) {
+    TempFile file{"compression_test_catalog"};
+    std::string named = Catalog::table_filename(file.path, "t");
+    {
+        Catalog catalog{file.path, Engine::btree, false, {.compress = true}};
+        ASSERT_TRUE(catalog.create("t"));
+        insert_rows(catalog.table("t"), 1, 50);
+        EXPECT_NE(catalog.table("t").pager.map, nullptr);
+    }
+    {
+        Catalog catalog{file.path};
+        EXPECT_NE(catalog.table("t").pager.map, nullptr);
+        expect_rows(catalog.table("t"), 1, 50);
+    }
+    std::remove(named.c_str());
+    std::remove(PageMap::filename(named).c_str());
+    std::remove((file.path + ".catalog").c_str());
+}
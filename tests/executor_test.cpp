@@ -0,0 +1,404 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <eggshell/compiler/statement.hpp>
+#include <eggshell/executor/aggregate.hpp>
+#include <eggshell/executor/filter.hpp>
+#include <eggshell/executor/limit.hpp>
+#include <eggshell/executor/parallelscan.hpp>
+#include <eggshell/executor/project.hpp>
+#include <eggshell/executor/resultsink.hpp>
+#include <eggshell/executor/rowfilter.hpp>
+#include <eggshell/executor/scan.hpp>
+#include <eggshell/executor/sort.hpp>
+#include <eggshell/executor/threadpool.hpp>
+#include <eggshell/storage/table.hpp>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "tempfile.hpp"
+
+namespace {
+
+/* 3000 rows, a few batches' worth, username u<key % 7> */
+void fill(Table& table) {
+    Statement insert;
+    insert.prepare("insert ? ? ?");
+    for (uint32_t key = 1; key <= 3000; key++) {
+        insert.bind(0, key);
+        insert.bind(1, "u" + std::to_string(key % 7));
+        insert.bind(2, "e" + std::to_string(key) + "@x");
+        insert.execute(table);
+    }
+}
+
+std::vector<uint32_t> ids(Operator& plan) {
+    std::vector<uint32_t> ids;
+    auto batch = std::make_unique<Batch>();
+    while (plan.next(*batch)) {
+        EXPECT_GT(batch->size, 0);
+        EXPECT_LE(batch->size, Batch::CAPACITY);
+        for (uint32_t i = 0; i < batch->size; i++) {
+            ids.push_back(batch->id[batch->selection[i]]);
+        }
+    }
+    return ids;
+}
+
+}  // namespace
+
+TEST(ExecutorTest, ScanStopsAtKeyMax) {
+    TempFile file{"executor_test_scan"};
+    Table table{file.path};
+    fill(table);
+
+    ScanOperator full{table, table.start(), UINT32_MAX, ALL_COLUMNS};
+    std::vector<uint32_t> all = ids(full);
+    ASSERT_EQ(all.size(), 3000);
+    for (uint32_t i = 0; i < all.size(); i++) {
+        EXPECT_EQ(all[i], i + 1);
+    }
+
+    ScanOperator range{table, table.lower_bound(1000), 2500,
+                       column_set(Column::id)};
+    std::vector<uint32_t> in_range = ids(range);
+    ASSERT_EQ(in_range.size(), 1501);
+    EXPECT_EQ(in_range.front(), 1000);
+    EXPECT_EQ(in_range.back(), 2500);
+}
+
+TEST(ExecutorTest, FilterLimitAndCount) {
+    TempFile file{"executor_test_pipeline"};
+    Table table{file.path};
+    fill(table);
+
+    auto scan = [&] {
+        return std::make_unique<ScanOperator>(table, table.start(), UINT32_MAX,
+                                              ALL_COLUMNS);
+    };
+
+    /* Every 7th key, skipping the first 100 matches and keeping 200 */
+    std::unique_ptr<Operator> plan = std::make_unique<FilterOperator>(
+        scan(), Column::username, "u3", false);
+    plan = std::make_unique<LimitOperator>(std::move(plan), 100, 200);
+    plan = std::make_unique<ProjectOperator>(std::move(plan),
+                                             column_set(Column::id));
+    std::vector<uint32_t> matched = ids(*plan);
+    ASSERT_EQ(matched.size(), 200);
+    for (uint32_t i = 0; i < matched.size(); i++) {
+        EXPECT_EQ(matched[i], 3 + 7 * (100 + i));
+    }
+
+    auto count = [&](std::unique_ptr<Operator> child) {
+        CountOperator count{std::move(child)};
+        auto batch = std::make_unique<Batch>();
+        EXPECT_TRUE(count.next(*batch));
+        EXPECT_EQ(batch->columns, AGGREGATE_COLUMN);
+        uint64_t result = batch->aggregate[0][batch->selection[0]].integer;
+        EXPECT_FALSE(count.next(*batch));
+        return result;
+    };
+    EXPECT_EQ(count(std::make_unique<FilterOperator>(scan(), Column::email,
+                                                     "e1", true)),
+              1 + 10 + 100 + 1000);
+    EXPECT_EQ(count(std::make_unique<FilterOperator>(scan(), 10, 1033)),
+              1024);
+    EXPECT_EQ(count(std::make_unique<FilterOperator>(scan(), Column::username,
+                                                     "nobody", false)),
+              0);
+}
+
+TEST(ExecutorTest, RowFilterMatchesLikeStrncmp) {
+    /* Lengths on both sides of every 16 byte block boundary */
+    std::vector<uint32_t> lengths = {0, 1, 15, 16, 17, 31, 32};
+    for (uint32_t length = 33; length <= Row::COLUMN_EMAIL_SIZE;
+         length += 37) {
+        lengths.push_back(length);
+    }
+    lengths.push_back(Row::COLUMN_EMAIL_SIZE);
+
+    auto value = std::make_unique<char[]>(Row::SIZE);
+    for (uint32_t length : lengths) {
+        Row row{};
+        row.id = 1;
+        for (uint32_t i = 0; i < length; i++) {
+            row.email[i] = 'a' + i % 26;
+        }
+        strncpy(row.username, row.email, Row::COLUMN_USERNAME_SIZE);
+        row.serialize(value.get());
+
+        for (Column column : {Column::username, Column::email}) {
+            const char* stored = value.get() + Row::offset(column);
+            uint32_t stored_length = strlen(stored);
+            for (uint32_t cut : {0u, 1u, 16u}) {
+                if (cut > stored_length) {
+                    continue;
+                }
+                std::string pattern{stored, stored_length - cut};
+                EXPECT_TRUE(RowFilter::column(column, pattern, true)
+                                .matches(1, value.get()));
+                EXPECT_EQ(RowFilter::column(column, pattern, false)
+                              .matches(1, value.get()),
+                          cut == 0)
+                    << length << " " << cut;
+                if (!pattern.empty()) {
+                    pattern.back() ^= 1;
+                    EXPECT_FALSE(RowFilter::column(column, pattern, true)
+                                     .matches(1, value.get()));
+                }
+            }
+        }
+    }
+}
+
+TEST(ExecutorTest, PushedDownFilterMatchesFilterOperator) {
+    TempFile file{"executor_test_pushdown"};
+    Table table{file.path};
+    fill(table);
+
+    ScanOperator pushed{table, table.start(), UINT32_MAX,
+                        column_set(Column::id),
+                        RowFilter::column(Column::email, "e2", true)};
+    FilterOperator filtered{
+        std::make_unique<ScanOperator>(table, table.start(), UINT32_MAX,
+                                       ALL_COLUMNS),
+        Column::email, "e2", true};
+    std::vector<uint32_t> expected = ids(filtered);
+    EXPECT_EQ(expected.size(), 1 + 10 + 100 + 1000);
+    EXPECT_EQ(ids(pushed), expected);
+
+    ScanOperator range{table, table.start(), 2000, column_set(Column::id),
+                       RowFilter::key_range(1990, 2100)};
+    EXPECT_EQ(ids(range).size(), 11);
+}
+
+TEST(ExecutorTest, ParallelScanMatchesScan) {
+    TempFile file{"executor_test_parallel"};
+    Table table{file.path};
+    fill(table);
+
+    std::vector<uint32_t> keys = table.split(8);
+    EXPECT_GE(keys.size(), 4);
+    EXPECT_LE(keys.size(), 7);
+    EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+
+    RowFilter filter = RowFilter::column(Column::username, "u3", false);
+    ScanOperator sequential{table, table.start(), UINT32_MAX, ALL_COLUMNS,
+                            filter};
+    std::vector<uint32_t> expected = ids(sequential);
+
+    for (uint32_t parallelism : {1, 2, 4}) {
+        ParallelScanOperator ordered{table, ALL_COLUMNS, filter, parallelism,
+                                     true};
+        EXPECT_EQ(ids(ordered), expected);
+
+        ParallelScanOperator unordered{table, ALL_COLUMNS, filter,
+                                       parallelism, false};
+        std::vector<uint32_t> any = ids(unordered);
+        std::sort(any.begin(), any.end());
+        EXPECT_EQ(any, expected);
+    }
+
+    /* Stops once the rows a LIMIT needs are handed out */
+    ParallelScanOperator limited{table, ALL_COLUMNS, filter, 4, true, 10};
+    std::vector<uint32_t> first = ids(limited);
+    ASSERT_GE(first.size(), 10);
+    EXPECT_LT(first.size(), 20);
+    EXPECT_TRUE(std::equal(first.begin(), first.end(), expected.begin()));
+
+    /* And so does a select with a LIMIT, printing the same rows */
+    for (std::string input : {"select * where username = 'u3' limit 10",
+                              "select * where username = 'u3' limit 5 "
+                              "offset 400"}) {
+        std::string serial, parallel;
+        for (uint32_t parallelism : {1, 4}) {
+            table.parallelism = parallelism;
+            ResultSink sink{parallelism == 1 ? serial : parallel};
+            Statement select;
+            ASSERT_EQ(select.prepare(input), CmdPrepareResult::success);
+            select.execute(table, sink);
+        }
+        table.parallelism = 1;
+        EXPECT_FALSE(serial.empty());
+        EXPECT_EQ(parallel, serial) << input;
+    }
+
+    /* Dropped before the workers finish */
+    auto early = std::make_unique<ParallelScanOperator>(
+        table, ALL_COLUMNS, RowFilter(), 4, false);
+    auto batch = std::make_unique<Batch>();
+    EXPECT_TRUE(early->next(*batch));
+    early.reset();
+}
+
+TEST(ExecutorTest, OrderedParallelScanOfManyBatches) {
+    TempFile file{"executor_test_parallel_batches"};
+    Table table{file.path};
+    const uint32_t rows = 60 * Batch::CAPACITY;
+    Row row{};
+    for (uint32_t key = 1; key <= rows; key++) {
+        row.id = key;
+        table.insert(table.find(key), row);
+    }
+
+    /* More batches than workers may hold back for the consumer */
+    ParallelScanOperator ordered{table, column_set(Column::id), RowFilter(),
+                                 4, true};
+    std::vector<uint32_t> all = ids(ordered);
+    ASSERT_EQ(all.size(), rows);
+    for (uint32_t i = 0; i < rows; i++) {
+        ASSERT_EQ(all[i], i + 1);
+    }
+}
+
+TEST(ExecutorTest, OrderedParallelScanOnABusyPool) {
+    TempFile file{"executor_test_parallel_busy"};
+    Table table{file.path};
+    const uint32_t rows = 60 * Batch::CAPACITY;
+    Row row{};
+    for (uint32_t key = 1; key <= rows; key++) {
+        row.id = key;
+        table.insert(table.find(key), row);
+    }
+
+    /* All pool threads but one held, as other queries would */
+    ThreadPool& pool = ThreadPool::shared();
+    std::mutex mutex;
+    std::condition_variable released;
+    bool release = false;
+    for (uint32_t i = 1; i < pool.size(); i++) {
+        pool.submit([&] {
+            std::unique_lock lock(mutex);
+            released.wait(lock, [&] { return release; });
+        });
+    }
+
+    /* More workers than threads, so some have not started */
+    std::vector<uint32_t> all;
+    {
+        ParallelScanOperator ordered{table, column_set(Column::id),
+                                     RowFilter(), pool.size() + 1, true};
+        all = ids(ordered);
+    }
+    {
+        std::lock_guard lock(mutex);
+        release = true;
+    }
+    released.notify_all();
+    ASSERT_EQ(all.size(), rows);
+    for (uint32_t i = 0; i < rows; i++) {
+        ASSERT_EQ(all[i], i + 1);
+    }
+}
+
+TEST(ExecutorTest, HashAggregateGroups) {
+    TempFile file{"executor_test_aggregate"};
+    Table table{file.path};
+    fill(table);
+
+    std::vector<AggregateSpec> aggregates = {
+        {AggregateFunction::count, Column::id},
+        {AggregateFunction::sum, Column::id},
+        {AggregateFunction::min, Column::id},
+        {AggregateFunction::avg, Column::id}};
+    HashAggregateOperator grouped{
+        std::make_unique<ScanOperator>(
+            table, table.start(), UINT32_MAX,
+            column_set(Column::id) | column_set(Column::username)),
+        true, Column::username, aggregates};
+
+    /* Groups in first-seen order u1, u2, ..., u6, u0 */
+    auto batch = std::make_unique<Batch>();
+    ASSERT_TRUE(grouped.next(*batch));
+    ASSERT_EQ(batch->size, 7);
+    for (uint32_t row = 0; row < 7; row++) {
+        uint32_t first = row + 1;
+        uint64_t count = 0, sum = 0;
+        for (uint32_t key = first; key <= 3000; key += 7) {
+            count++;
+            sum += key;
+        }
+        EXPECT_EQ(batch->username[row], "u" + std::to_string(first % 7));
+        EXPECT_EQ(batch->aggregate[0][row].integer, count);
+        EXPECT_EQ(batch->aggregate[1][row].integer, sum);
+        EXPECT_EQ(batch->aggregate[2][row].integer, first);
+        EXPECT_DOUBLE_EQ(batch->aggregate[3][row].real, double(sum) / count);
+    }
+    EXPECT_FALSE(grouped.next(*batch));
+
+    /* One group even over no rows, with only the count defined */
+    HashAggregateOperator empty{
+        std::make_unique<ScanOperator>(table, table.lower_bound(5000),
+                                       UINT32_MAX, column_set(Column::id)),
+        false, Column::id, aggregates};
+    ASSERT_TRUE(empty.next(*batch));
+    ASSERT_EQ(batch->size, 1);
+    EXPECT_FALSE(batch->aggregate[0][0].null);
+    EXPECT_EQ(batch->aggregate[0][0].integer, 0);
+    EXPECT_TRUE(batch->aggregate[2][0].null);
+
+    uint32_t min, max;
+    ASSERT_TRUE(table.min_key(min));
+    ASSERT_TRUE(table.max_key(max));
+    EXPECT_EQ(min, 1);
+    EXPECT_EQ(max, 3000);
+}
+
+TEST(ExecutorTest, SortTopKAndSpilledRunsAgree) {
+    TempFile file{"executor_test_sort"};
+    Table table{file.path};
+    fill(table);
+
+    auto scan = [&table] {
+        return std::make_unique<ScanOperator>(
+            table, table.start(), UINT32_MAX,
+            column_set(Column::id) | column_set(Column::email));
+    };
+    /* Emails e<key>@x, so string order differs from key order */
+    std::vector<uint32_t> expected(3000);
+    for (uint32_t i = 0; i < expected.size(); i++) {
+        expected[i] = i + 1;
+    }
+    std::sort(expected.begin(), expected.end(), [](uint32_t a, uint32_t b) {
+        return std::to_string(a) + "@x" > std::to_string(b) + "@x";
+    });
+
+    SortOperator in_memory{scan(), Column::email, true, UINT32_MAX, 1 << 20};
+    EXPECT_EQ(ids(in_memory), expected);
+    EXPECT_EQ(in_memory.runs(), 0);
+
+    /* About 100 rows per run */
+    SortOperator spilled{scan(), Column::email, true, UINT32_MAX, 26000};
+    EXPECT_EQ(ids(spilled), expected);
+    EXPECT_GT(spilled.runs(), 20);
+
+    SortOperator top{scan(), Column::email, true, 10, 26000};
+    std::vector<uint32_t> top_ids = ids(top);
+    EXPECT_EQ(top.runs(), 0);
+    EXPECT_EQ(top_ids,
+              std::vector<uint32_t>(expected.begin(), expected.begin() + 10));
+}
+
+TEST(ExecutorTest, LimitStopsTheScan) {
+    TempFile file{"executor_test_limit"};
+    Table table{file.path};
+    fill(table);
+
+    uint64_t fetches = table.pager.fetches;
+    ScanOperator limited{table, table.start(), UINT32_MAX, ALL_COLUMNS,
+                         RowFilter(), 5};
+    EXPECT_EQ(ids(limited), (std::vector<uint32_t>{1, 2, 3, 4, 5}));
+    uint64_t limited_fetches = table.pager.fetches - fetches;
+
+    /* A batch's worth of leaves otherwise, ~80 of them */
+    fetches = table.pager.fetches;
+    auto batch = std::make_unique<Batch>();
+    ScanOperator{table, table.start(), UINT32_MAX, ALL_COLUMNS}.next(*batch);
+    EXPECT_LT(limited_fetches * 2, table.pager.fetches - fetches);
+}
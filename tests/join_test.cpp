@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <eggshell/compiler/statement.hpp>
+#include <eggshell/executor/hashjoin.hpp>
+#include <eggshell/executor/mergejoin.hpp>
+#include <eggshell/storage/catalog.hpp>
+#include <eggshell/storage/table.hpp>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "tempfile.hpp"
+
+namespace {
+
+void insert(Table& table, uint32_t key, std::string username) {
+    Statement statement;
+    statement.prepare("insert ? ? ?");
+    statement.bind(0, key);
+    statement.bind(1, username);
+    statement.bind(2, "e" + std::to_string(key));
+    statement.execute(table);
+}
+
+using Pair = std::tuple<uint32_t, uint32_t>;
+
+/* (left id, right id) of every pair, sorted */
+std::vector<Pair> pairs(JoinOperator& join) {
+    std::vector<Pair> pairs;
+    auto left = std::make_unique<Batch>();
+    auto right = std::make_unique<Batch>();
+    while (join.next(*left, *right)) {
+        EXPECT_EQ(left->size, right->size);
+        for (uint32_t i = 0; i < left->size; i++) {
+            pairs.emplace_back(left->id[left->selection[i]],
+                               right->id[right->selection[i]]);
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+}  // namespace
+
+TEST(JoinTest, MergeAndHashJoinOnIdAgree) {
+    TempCatalog file{"join_test_id"};
+    Catalog catalog{file.path};
+    ASSERT_TRUE(catalog.create("orders"));
+    Table& users = catalog.table("users");
+    Table& orders = catalog.table("orders");
+    ASSERT_NE(&users, &orders);
+
+    std::vector<Pair> expected;
+    for (uint32_t key = 1; key <= 2000; key++) {
+        insert(users, key, "u" + std::to_string(key % 10));
+    }
+    for (uint32_t key = 3; key <= 6000; key += 3) {
+        insert(orders, key, "o");
+        if (key <= 2000) {
+            expected.emplace_back(key, key);
+        }
+    }
+
+    MergeJoinOperator merge{users, orders};
+    EXPECT_EQ(pairs(merge), expected);
+    HashJoinOperator hash{users, Column::id, orders, Column::id, 1 << 30};
+    EXPECT_EQ(hash.partitions(), 1);
+    EXPECT_EQ(pairs(hash), expected);
+}
+
+TEST(JoinTest, PartitionedHashJoinMatchesInMemory) {
+    TempCatalog file{"join_test_partitioned"};
+    Catalog catalog{file.path};
+    ASSERT_TRUE(catalog.create("orders"));
+    Table& users = catalog.table("");
+    Table& orders = catalog.table("orders");
+
+    /* Many orders per user name, and names no user has */
+    for (uint32_t key = 1; key <= 500; key++) {
+        insert(users, key, "u" + std::to_string(key));
+    }
+    std::vector<Pair> expected;
+    for (uint32_t key = 1; key <= 3000; key++) {
+        uint32_t user = key % 700 + 1;
+        insert(orders, key, "u" + std::to_string(user));
+        if (user <= 500) {
+            expected.emplace_back(user, key);
+        }
+    }
+    std::sort(expected.begin(), expected.end());
+
+    HashJoinOperator in_memory{users, Column::username, orders,
+                               Column::username, 1 << 30};
+    EXPECT_EQ(in_memory.partitions(), 1);
+    EXPECT_EQ(pairs(in_memory), expected);
+
+    HashJoinOperator partitioned{users, Column::username, orders,
+                                 Column::username, 20000};
+    EXPECT_GT(partitioned.partitions(), 4);
+    EXPECT_EQ(pairs(partitioned), expected);
+}
+
+TEST(JoinTest, CatalogResolvesAndPersistsTables) {
+    TempCatalog file{"join_test_catalog"};
+    {
+        Catalog catalog{file.path};
+        Statement create;
+        ASSERT_EQ(create.prepare("create table orders"),
+                  CmdPrepareResult::success);
+        EXPECT_EQ(create.execute(catalog), ExecuteResult::success);
+        EXPECT_EQ(create.execute(catalog), ExecuteResult::table_exists);
+
+        Statement insert;
+        ASSERT_EQ(insert.prepare("insert into orders values (4, a, b)"),
+                  CmdPrepareResult::success);
+        EXPECT_EQ(insert.execute(catalog), ExecuteResult::success);
+        EXPECT_EQ(catalog.table("users").count(), 0);
+    }
+
+    Catalog reopened{file.path};
+    EXPECT_EQ(reopened.names(), std::vector<std::string>{"orders"});
+    EXPECT_EQ(reopened.table("orders").count(), 1);
+
+    Statement bad;
+    EXPECT_EQ(bad.prepare("create table ../x"), CmdPrepareResult::syntax_error);
+    Statement join;
+    ASSERT_EQ(join.prepare("select count(*) from users join orders on "
+                           "orders.id = users.email"),
+              CmdPrepareResult::success);
+    EXPECT_EQ(join.join_left, Column::email);
+    EXPECT_EQ(join.join_right, Column::id);
+}
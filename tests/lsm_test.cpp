@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <eggshell/compiler/statement.hpp>
+#include <eggshell/executor/resultsink.hpp>
+#include <eggshell/executor/scan.hpp>
+#include <eggshell/storage/lsm/lsmtree.hpp>
+#include <eggshell/storage/table.hpp>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "run.hpp"
+#include "tempfile.hpp"
+
+namespace {
+
+std::vector<char> make_value(uint32_t key, uint32_t version) {
+    Row row{};
+    row.id = key;
+    snprintf(row.username, sizeof(row.username), "user%u", key);
+    snprintf(row.email, sizeof(row.email), "v%u@example.com", version);
+    std::vector<char> value(Row::SIZE);
+    row.serialize(value.data());
+    return value;
+}
+
+uint32_t version(const char* value) {
+    Row row;
+    row.deserialize(value);
+    uint32_t version;
+    sscanf(row.email, "v%u@", &version);
+    return version;
+}
+
+}  // namespace
+
+TEST(LsmTest, MemTableKeepsKeysSorted) {
+    MemTable memtable;
+    std::vector<uint32_t> keys(500);
+    for (uint32_t i = 0; i < keys.size(); i++) {
+        keys[i] = i * 3;
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937{1});
+    for (uint32_t key : keys) {
+        memtable.put(key, make_value(key, 0).data());
+    }
+    memtable.put(30, make_value(30, 1).data());
+
+    EXPECT_EQ(memtable.num_entries(), 500);
+    uint32_t expected = 0;
+    for (MemTable::Node* node = memtable.seek(0); node; node = node->next[0]) {
+        EXPECT_EQ(node->key, expected);
+        expected += 3;
+    }
+    EXPECT_EQ(memtable.seek(31)->key, 33);
+    EXPECT_EQ(version(memtable.seek(30)->value), 1);
+}
+
+TEST(LsmTest, NewestVersionWinsAcrossFlushesAndCompaction) {
+    TempFile file{"lsm_test_versions"};
+    /* About 30 rows per memtable, so every round flushes several runs */
+    const uint32_t num_keys = 300;
+    {
+        LsmTree lsm{LsmTree::dirname(file.path), 30 * sizeof(MemTable::Node)};
+        for (uint32_t round = 0; round < 4; round++) {
+            std::vector<uint32_t> keys(num_keys);
+            for (uint32_t i = 0; i < num_keys; i++) {
+                keys[i] = i;
+            }
+            std::shuffle(keys.begin(), keys.end(), std::mt19937{round});
+            for (uint32_t key : keys) {
+                lsm.put(key, make_value(key, round).data());
+            }
+        }
+        lsm.wait_for_compaction();
+        std::vector<uint32_t> shape = lsm.shape();
+        ASSERT_GT(shape.size(), 1);
+        for (uint32_t runs : shape) {
+            EXPECT_LT(runs, LsmTree::LEVEL_MAX_RUNS);
+        }
+
+        char value[sizeof(MemTable::Node::value)];
+        ASSERT_TRUE(lsm.get(123, value));
+        EXPECT_EQ(version(value), 3);
+        EXPECT_FALSE(lsm.get(num_keys, value));
+    }
+
+    /* Reopened from the manifest and the log */
+    LsmTree lsm{LsmTree::dirname(file.path), 30 * sizeof(MemTable::Node)};
+    uint32_t expected = 0;
+    for (auto it = lsm.seek(0); it->valid(); it->next()) {
+        EXPECT_EQ(it->key(), expected);
+        EXPECT_EQ(version(it->value()), 3);
+        expected++;
+    }
+    EXPECT_EQ(expected, num_keys);
+}
+
+TEST(LsmTest, StatementsRunOnLsmTable) {
+    TempFile file{"lsm_test_statements"};
+    {
+        Table table{file.path, Engine::lsm};
+        for (uint32_t key = 100; key > 0; key--) {
+            run(table, "insert " + std::to_string(key) + " user old@x");
+        }
+        EXPECT_EQ(run(table, "insert 7 user dup@x"),
+                  ExecuteResult::duplicate_key);
+        table.lsm->flush();
+        EXPECT_EQ(run(table, "insert 7 user dup@x"),
+                  ExecuteResult::duplicate_key);
+        run(table, "update set email = new@x where id between 20 and 60");
+        run(table, "insert 5 bob b@x on conflict do update");
+        EXPECT_EQ(table.count(), 100);
+        EXPECT_EQ(table.rank(50), 49);
+
+        /* Row limits stop LSM cursors as they do leaves */
+        ScanOperator scan{table, table.at(10), UINT32_MAX,
+                          column_set(Column::id), RowFilter(), 3};
+        auto batch = std::make_unique<Batch>();
+        ASSERT_TRUE(scan.next(*batch));
+        EXPECT_EQ(batch->size, 3);
+        EXPECT_EQ(batch->id[batch->selection[0]], 11);
+    }
+
+    /* The directory alone makes the table open with the LSM engine */
+    Table table{file.path};
+    ASSERT_TRUE(table.lsm);
+    Row row;
+    uint32_t key = 1;
+    for (Cursor cursor = table.start(); !cursor.end_of_table;
+         cursor.advance(), key++) {
+        row.deserialize(cursor.value());
+        ASSERT_EQ(row.id, key);
+        const char* email = key >= 20 && key <= 60 ? "new@x"
+                            : key == 5             ? "b@x"
+                                                   : "old@x";
+        EXPECT_STREQ(row.email, email) << key;
+    }
+    EXPECT_EQ(key, 101);
+}
+
+TEST(LsmTest, SelectsMatchTheTree) {
+    TempFile lsm_file{"lsm_test_selects"};
+    TempFile tree_file{"lsm_test_selects_tree"};
+    Table lsm{lsm_file.path, Engine::lsm};
+    Table tree{tree_file.path};
+    std::vector<uint32_t> keys(300);
+    for (uint32_t i = 0; i < keys.size(); i++) {
+        keys[i] = i + 1;
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937{7});
+    for (uint32_t key : keys) {
+        std::string insert =
+            "insert " + std::to_string(key) + " u" + std::to_string(key % 9) +
+            " e@x";
+        run(lsm, insert);
+        run(tree, insert);
+        if (key % 50 == 0) {
+            lsm.lsm->flush();
+        }
+    }
+
+    /* Ranges are scanned from their first key rather than by position */
+    for (std::string input :
+         {"select", "select * limit 5 offset 290",
+          "select * where id between 40 and 60",
+          "select * where id between 40 and 60 limit 4 offset 3",
+          "select * where id between 295 and 400",
+          "select * where id between 10 and 30 order by id desc limit 3",
+          "select * where id between 10 and 30 order by username limit 4",
+          "select count(*) where id between 100 and 199",
+          "select count(*)"}) {
+        EXPECT_EQ(output(lsm, input), output(tree, input)) << input;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <eggshell/executor/scheduler.hpp>
+#include <eggshell/storage/frameslab.hpp>
+#include <eggshell/storage/table.hpp>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "tempfile.hpp"
+
+namespace {
+
+const uint32_t PAGE_SIZE = Pager::PAGE_SIZE;
+
+void insert_rows(Table& table, uint32_t rows) {
+    Row row{};
+    for (uint32_t key = 1; key <= rows; key++) {
+        row.id = key;
+        snprintf(row.username, sizeof(row.username), "user%u", key);
+        snprintf(row.email, sizeof(row.email), "user%u@example.com", key);
+        table.insert(table.find(key), row);
+    }
+}
+
+void expect_rows(Table& table, uint32_t rows) {
+    Row row;
+    uint32_t key = 1;
+    for (Cursor cursor = table.start(); !cursor.end_of_table;
+         cursor.advance()) {
+        row.deserialize(cursor.value());
+        ASSERT_EQ(row.id, key);
+        ASSERT_EQ(std::string(row.username), "user" + std::to_string(key));
+        key++;
+    }
+    EXPECT_EQ(key, rows + 1);
+}
+
+}  // namespace
+
+TEST(PagerTest, FramesAreAlignedAndReused) {
+    for (bool huge_pages : {false, true}) {
+        FrameSlab slab{PAGE_SIZE, huge_pages};
+        std::set<char*> frames;
+        uint32_t per_region = FrameSlab::REGION_SIZE / PAGE_SIZE;
+        for (uint32_t i = 0; i < per_region + 1; i++) {
+            char* frame = slab.allocate();
+            EXPECT_EQ(uintptr_t(frame) % PAGE_SIZE, 0u);
+            /* Writable end to end */
+            frame[0] = frame[PAGE_SIZE - 1] = 1;
+            EXPECT_TRUE(frames.insert(frame).second);
+        }
+        EXPECT_EQ(slab.mapped(), 2 * FrameSlab::REGION_SIZE);
+
+        char* freed = *frames.begin();
+        slab.free(freed);
+        EXPECT_EQ(slab.allocate(), freed);
+        EXPECT_EQ(slab.mapped(), 2 * FrameSlab::REGION_SIZE);
+    }
+}
+
+TEST(PagerTest, DirectIo) {
+    TempFile file{"pager_test_direct"};
+    PagerOptions options{.direct_io = true, .huge_pages = true};
+    {
+        Table table{file.path, Engine::btree, options};
+        if (table.pager.direct_fd < 0) {
+            GTEST_SKIP() << "O_DIRECT is not supported here";
+        }
+        insert_rows(table, 3000);
+    }
+    {
+        Table table{file.path, Engine::btree, options};
+        expect_rows(table, 3000);
+        /* Whole pages only, at aligned offsets */
+        EXPECT_GT(table.pager.bytes_read, 0u);
+        EXPECT_EQ(table.pager.bytes_read % PAGE_SIZE, 0u);
+        table.vacuum(100);
+        expect_rows(table, 3000);
+    }
+
+    /* The same file, read through the scheduler */
+    Table table{file.path, Engine::btree, options};
+    Scheduler scheduler{2, false};
+    std::vector<Row> rows(3000);
+    std::vector<Task<bool>> tasks;
+    for (uint32_t key = 1; key <= rows.size(); key++) {
+        tasks.push_back(table.lookup(key, rows[key - 1], scheduler));
+    }
+    scheduler.run(tasks, 64);
+    for (uint32_t key = 1; key <= rows.size(); key++) {
+        ASSERT_TRUE(tasks[key - 1].result());
+        EXPECT_EQ(rows[key - 1].id, key);
+    }
+}
+
+TEST(PagerTest, DirectIoSkipsCompressedFiles) {
+    TempFile file{"pager_test_direct_compressed"};
+    Table table{file.path, Engine::btree,
+                {.compress = true, .direct_io = true}};
+    EXPECT_NE(table.pager.map, nullptr);
+    EXPECT_EQ(table.pager.direct_fd, -1);
+}
+
+TEST(PagerTest, WarmRestartReadsCachedPagesBack) {
+    for (bool compress : {false, true}) {
+        TempFile file{compress ? "pager_test_warm_compressed" : "pager_test_warm"};
+        PagerOptions options{.compress = compress, .warm_restart = true};
+        {
+            Table table{file.path, Engine::btree, options};
+            insert_rows(table, 5000);
+        }
+        WarmSet set;
+        ASSERT_TRUE(set.load(WarmSet::filename(file.path)));
+        EXPECT_FALSE(set.interior.empty());
+        EXPECT_FALSE(set.leaves.empty());
+        EXPECT_TRUE(std::is_sorted(set.interior.begin(), set.interior.end()));
+
+        /* Reads race the prefetcher */
+        {
+            Table table{file.path, Engine::btree, options};
+            expect_rows(table, 5000);
+        }
+
+        /* Pages no longer in the file are skipped */
+        set.leaves.push_back(Pager::MAX_PAGES - 1);
+        set.save(WarmSet::filename(file.path));
+
+        Table table{file.path, Engine::btree, options};
+        table.pager.wait_for_prefetch();
+        for (std::vector<uint32_t>* pages : {&set.interior, &set.leaves}) {
+            for (uint32_t page_num : *pages) {
+                EXPECT_TRUE(table.pager.cached(page_num)) << page_num;
+            }
+        }
+        EXPECT_EQ(table.pager.prefetched,
+                  set.interior.size() + set.leaves.size() - 1);
+        EXPECT_EQ(table.pager.fetches, 0u);
+        expect_rows(table, 5000);
+    }
+}
+
+TEST(PagerTest, WarmSetWithBadCountsIsDropped) {
+    TempFile file{"pager_test_warm_bad"};
+    PagerOptions options{.warm_restart = true};
+    {
+        Table table{file.path, Engine::btree, options};
+        insert_rows(table, 100);
+    }
+
+    /* Counts that do not match the file, not even sizing the vectors */
+    std::string warm = WarmSet::filename(file.path);
+    for (std::vector<uint32_t> contents :
+         {std::vector<uint32_t>{UINT32_MAX, UINT32_MAX, 1},
+          std::vector<uint32_t>{1, 1, 1}, std::vector<uint32_t>{0, 0, 1}}) {
+        {
+            std::ofstream out{warm, std::ios::binary | std::ios::trunc};
+            out.write((const char*)contents.data(),
+                      contents.size() * sizeof(uint32_t));
+        }
+        WarmSet set;
+        EXPECT_FALSE(set.load(warm));
+        EXPECT_TRUE(set.interior.empty());
+        EXPECT_TRUE(set.leaves.empty());
+
+        Table table{file.path, Engine::btree, options};
+        table.pager.wait_for_prefetch();
+        EXPECT_EQ(table.pager.prefetched, 0u);
+        expect_rows(table, 100);
+    }
+}
+
+TEST(PagerTest, WarmRestartIsOptIn) {
+    TempFile file{"pager_test_cold"};
+    {
+        Table table{file.path};
+        insert_rows(table, 100);
+    }
+    Table table{file.path};
+    EXPECT_FALSE(std::filesystem::exists(WarmSet::filename(file.path)));
+    EXPECT_EQ(table.pager.prefetched, 0u);
+}
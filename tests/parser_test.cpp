@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <eggshell/compiler/lexer.hpp>
+#include <eggshell/compiler/parser.hpp>
+#include <eggshell/compiler/statement.hpp>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> texts(std::string_view input) {
+    std::vector<std::string> texts;
+    Lexer lexer{input};
+    for (Token token = lexer.next(); token.type != TokenType::end;
+         token = lexer.next()) {
+        texts.emplace_back(token.text);
+    }
+    return texts;
+}
+
+}  // namespace
+
+TEST(ParserTest, LexerSplitsWordsSymbolsAndStrings) {
+    EXPECT_EQ(texts("select count(*) where email like 'a b%';"),
+              (std::vector<std::string>{"select", "count", "(", "*", ")",
+                                        "where", "email", "like", "a b%",
+                                        ";"}));
+    EXPECT_EQ(texts("insert 1 a@x b.c"),
+              (std::vector<std::string>{"insert", "1", "a@x", "b.c"}));
+
+    std::string_view input = "insert 'unterminated";
+    Lexer lexer{input};
+    lexer.next();
+    EXPECT_EQ(lexer.next().type, TokenType::invalid);
+}
+
+TEST(ParserTest, TokensPointIntoInput) {
+    std::string input = "UPDATE users SET email = 'x@y' WHERE id = 3";
+    Arena arena;
+    ASTNode* node;
+    ASSERT_EQ(Parser(input, arena).parse(node), CmdPrepareResult::success);
+    ASSERT_EQ(node->type, ASTNodeType::update);
+
+    auto* update = static_cast<UpdateNode*>(node);
+    EXPECT_EQ(update->table, "users");
+    EXPECT_EQ(update->assignments->value.text, "x@y");
+    EXPECT_EQ(update->assignments->value.text.data(), input.data() + 26);
+    EXPECT_EQ(update->where->op, PredicateOp::eq);
+    EXPECT_EQ(update->where->value.text, "3");
+}
+
+TEST(ParserTest, BothInsertFormsBindTheSameRow) {
+    Statement bare, values;
+    ASSERT_EQ(bare.prepare("insert 7 alice a@x on conflict do update"),
+              CmdPrepareResult::success);
+    ASSERT_EQ(values.prepare("INSERT INTO users VALUES (7, 'alice', "
+                             "'a@x') ON CONFLICT DO UPDATE;"),
+              CmdPrepareResult::success);
+    for (Statement* statement : {&bare, &values}) {
+        EXPECT_EQ(statement->type, StatementType::insert);
+        EXPECT_EQ(statement->row_to_insert.id, 7);
+        EXPECT_STREQ(statement->row_to_insert.username, "alice");
+        EXPECT_STREQ(statement->row_to_insert.email, "a@x");
+        EXPECT_TRUE(statement->on_conflict_update);
+    }
+}
+
+TEST(ParserTest, SelectClauses) {
+    Statement statement;
+    ASSERT_EQ(statement.prepare("select id from users where id between 3 "
+                                "and 9 limit 2 offset 1"),
+              CmdPrepareResult::success);
+    EXPECT_TRUE(statement.select_id_only);
+    EXPECT_EQ(statement.key_min, 3);
+    EXPECT_EQ(statement.key_max, 9);
+    EXPECT_EQ(statement.limit, 2);
+    EXPECT_EQ(statement.offset, 1);
+
+    Statement prefix;
+    ASSERT_EQ(prefix.prepare("select * where username like 'al%'"),
+              CmdPrepareResult::success);
+    EXPECT_TRUE(prefix.where_prefix);
+    EXPECT_EQ(prefix.where_value, "al");
+}
+
+TEST(ParserTest, AggregatesAndGroupBy) {
+    Statement count;
+    ASSERT_EQ(count.prepare("SELECT COUNT(*) FROM users"),
+              CmdPrepareResult::success);
+    EXPECT_TRUE(count.count_only);
+
+    Statement grouped;
+    ASSERT_EQ(grouped.prepare("select min(id), username, avg(id) from users "
+                              "group by username"),
+              CmdPrepareResult::success);
+    EXPECT_FALSE(grouped.count_only);
+    EXPECT_TRUE(grouped.has_group);
+    EXPECT_EQ(grouped.group_column, Column::username);
+    EXPECT_EQ(grouped.group_position, 1);
+    ASSERT_EQ(grouped.aggregates.size(), 2);
+    EXPECT_EQ(grouped.aggregates[0].function, AggregateFunction::min);
+    EXPECT_EQ(grouped.aggregates[1].function, AggregateFunction::avg);
+
+    Statement ordered;
+    ASSERT_EQ(ordered.prepare("select * order by email desc limit 3"),
+              CmdPrepareResult::success);
+    EXPECT_TRUE(ordered.has_order);
+    EXPECT_EQ(ordered.order_column, Column::email);
+    EXPECT_TRUE(ordered.order_descending);
+    EXPECT_FALSE(ordered.key_ordered());
+}
+
+TEST(ParserTest, ErrorsAreResults) {
+    std::string long_name(Row::COLUMN_USERNAME_SIZE + 1, 'a');
+    std::vector<std::pair<std::string, CmdPrepareResult>> cases = {
+        {"drop table users", CmdPrepareResult::unrecognized},
+        {"select * where", CmdPrepareResult::syntax_error},
+        {"select * limit", CmdPrepareResult::syntax_error},
+        {"select username", CmdPrepareResult::syntax_error},
+        {"select * where id like 3%", CmdPrepareResult::syntax_error},
+        {"select sum(username)", CmdPrepareResult::syntax_error},
+        {"select avg(*)", CmdPrepareResult::syntax_error},
+        {"select id, count(*)", CmdPrepareResult::syntax_error},
+        {"select email, count(*) group by username",
+         CmdPrepareResult::syntax_error},
+        {"select * group by username", CmdPrepareResult::syntax_error},
+        {"select median(id)", CmdPrepareResult::syntax_error},
+        {"select * order by", CmdPrepareResult::syntax_error},
+        {"select count(*) order by id", CmdPrepareResult::syntax_error},
+        {"insert 1 a", CmdPrepareResult::syntax_error},
+        {"insert 1 a b c", CmdPrepareResult::syntax_error},
+        {"insert x a b", CmdPrepareResult::syntax_error},
+        {"insert -1 a b", CmdPrepareResult::id_out_of_range},
+        {"insert 4294967296 a b", CmdPrepareResult::id_out_of_range},
+        {"insert 1 " + long_name + " b", CmdPrepareResult::string_too_long},
+        {"insert 1 'a b", CmdPrepareResult::syntax_error},
+        {"create index on id", CmdPrepareResult::syntax_error},
+        {"create index on email using bitmap",
+         CmdPrepareResult::syntax_error},
+    };
+    for (const auto& [input, expected] : cases) {
+        Statement statement;
+        EXPECT_EQ(statement.prepare(input), expected) << input;
+    }
+}
@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <eggshell/compiler/statement.hpp>
+#include <eggshell/executor/resultsink.hpp>
+#include <eggshell/storage/catalog.hpp>
+#include <eggshell/storage/partition.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "run.hpp"
+#include "tempfile.hpp"
+
+namespace {
+
+const uint32_t PARTITIONS = 4;
+
+/* Same rows in an unpartitioned table and a partitioned one */
+void fill(Catalog& catalog) {
+    for (uint32_t key = 1; key <= 500; key++) {
+        for (std::string table : {"plain", "parts"}) {
+            std::string values = "(" + std::to_string(key) + ", u" +
+                                 std::to_string(key % 7) + ", e" +
+                                 std::to_string(1000 - key) + ")";
+            ASSERT_EQ(run(catalog, "insert into " + table + " values " +
+                                       values),
+                      "");
+        }
+    }
+}
+
+/* Every select gives the same rows from both tables */
+void same_results(Catalog& catalog) {
+    std::vector<std::string> selects{
+        "select * from %",
+        "select * from % limit 5 offset 3",
+        "select id from % where id between 10 and 350 limit 7 offset 2",
+        "select * from % where id = 17",
+        "select * from % where id = 9000",
+        "select count(*) from %",
+        "select count(*) from % where id between 90 and 260",
+        "select * from % where username = 'u3' limit 20",
+        "select count(*) from % where email like 'e9%'",
+        "select * from % order by email limit 10 offset 5",
+        "select * from % order by id desc limit 4",
+        "select min(id), max(id), count(*) from %",
+        "select username, count(*), sum(id) from % group by username "
+        "order by username"};
+    for (std::string select : selects) {
+        size_t at = select.find('%');
+        std::string plain = select, parts = select;
+        plain.replace(at, 1, "plain");
+        parts.replace(at, 1, "parts");
+        std::string expected = run(catalog, plain);
+        EXPECT_NE(expected, "prepare error") << select;
+        EXPECT_EQ(run(catalog, parts), expected) << select;
+    }
+}
+
+}  // namespace
+
+TEST(PartitionTest, HashRoutingSpreadsKeys) {
+    PartitionSpec spec{PARTITIONS, false, 0};
+    TempCatalog file{"partition_test_routing"};
+    PartitionedTable table{file.path + ".parts", spec, true};
+    std::vector<uint32_t> keys(PARTITIONS);
+    for (uint32_t key = 0; key < 4000; key++) {
+        keys[table.partition(key)]++;
+    }
+    for (uint32_t count : keys) {
+        EXPECT_GT(count, 800u);
+    }
+    EXPECT_EQ(table.shards_between(7, 7).size(), 1u);
+    EXPECT_EQ(table.shards_between(7, 8).size(), PARTITIONS);
+}
+
+TEST(PartitionTest, RangeRoutingSkipsShards) {
+    PartitionSpec spec{PARTITIONS, true, 100};
+    TempCatalog file{"partition_test_range"};
+    PartitionedTable table{file.path + ".parts", spec, true};
+    EXPECT_EQ(table.partition(99), 0u);
+    EXPECT_EQ(table.partition(100), 1u);
+    EXPECT_EQ(table.partition(UINT32_MAX), PARTITIONS - 1);
+    std::vector<Table*> shards = table.shards_between(150, 250);
+    ASSERT_EQ(shards.size(), 2u);
+    EXPECT_EQ(shards[0], table.shards[1].get());
+}
+
+TEST(PartitionTest, HashPartitionsMatchOneTable) {
+    TempCatalog file{"partition_test_hash"};
+    {
+        Catalog catalog{file.path};
+        ASSERT_EQ(run(catalog, "create table plain"), "");
+        ASSERT_EQ(run(catalog, "create table parts partitions 4"), "");
+        fill(catalog);
+        for (std::string table : {"plain", "parts"}) {
+            ASSERT_EQ(run(catalog, "update " + table +
+                                       " set username = 'z' where id "
+                                       "between 40 and 60"),
+                      "");
+        }
+        same_results(catalog);
+        EXPECT_EQ(run(catalog, "select * from plain join parts on id = id"),
+                  "Error: Joins on partitioned tables are not supported.\n");
+    }
+
+    /* Reopened from the catalog, keys route to the shards they are in */
+    Catalog catalog{file.path};
+    PartitionedTable* parts = catalog.partitioned("parts");
+    ASSERT_NE(parts, nullptr);
+    EXPECT_FALSE(parts->spec.range);
+    for (const auto& shard : parts->shards) {
+        EXPECT_GT(shard->count(), 0u);
+    }
+    same_results(catalog);
+    EXPECT_EQ(run(catalog, "insert into parts values (17, a, b)"),
+              "Error: Duplicate key.\n");
+}
+
+TEST(PartitionTest, RangePartitionsMatchOneTable) {
+    TempCatalog file{"partition_test_ranges"};
+    Catalog catalog{file.path};
+    ASSERT_EQ(run(catalog, "create table plain"), "");
+    ASSERT_EQ(run(catalog, "create table parts partitions 4 by range 150"),
+              "");
+    fill(catalog);
+    same_results(catalog);
+    EXPECT_EQ(catalog.partitioned("parts")->shards[3]->count(), 51u);
+
+    for (std::string input : {"create table t partitions 0",
+                              "create table t partitions 65",
+                              "create table t partitions 2 by range 0",
+                              "create table t partitions 2 by list"}) {
+        EXPECT_EQ(run(catalog, input), "prepare error") << input;
+    }
+}
+
+TEST(PartitionTest, CountsHonourLimitAndOffset) {
+    TempCatalog file{"partition_test_count_limit"};
+    Catalog catalog{file.path};
+    ASSERT_EQ(run(catalog, "create table plain"), "");
+    ASSERT_EQ(run(catalog, "create table parts partitions 4"), "");
+    fill(catalog);
+    ASSERT_EQ(run(catalog, "create index on plain (username)"), "");
+
+    /* The count is one row, as min and max are */
+    for (std::string count :
+         {"select count(*) from %", "select min(id), max(id) from %",
+          "select count(*) from % where id between 90 and 260",
+          "select count(*) from % where username = 'u3'",
+          "select count(*) from % where email like 'e9%'",
+          "select count(*) from plain join plain on username = username"}) {
+        for (std::string table : {"plain", "parts"}) {
+            std::string select = count;
+            if (size_t at = select.find('%'); at != std::string::npos) {
+                select.replace(at, 1, table);
+            }
+            EXPECT_NE(run(catalog, select + " limit 1"), "") << select;
+            EXPECT_EQ(run(catalog, select + " limit 0"), "") << select;
+            EXPECT_EQ(run(catalog, select + " offset 1"), "") << select;
+        }
+    }
+}
+
+TEST(PartitionTest, ConcurrentInserts) {
+    TempCatalog file{"partition_test_concurrent"};
+    Catalog catalog{file.path};
+    ASSERT_EQ(run(catalog, "create table parts partitions 4"), "");
+    const uint32_t threads = 4;
+    const uint32_t rows = 2000;
+    std::vector<std::thread> writers;
+    for (uint32_t t = 0; t < threads; t++) {
+        writers.emplace_back([&, t] {
+            for (uint32_t key = t; key < rows; key += threads) {
+                run(catalog, "insert into parts values (" +
+                                 std::to_string(key) + ", u, e)");
+            }
+        });
+    }
+    for (std::thread& writer : writers) {
+        writer.join();
+    }
+    EXPECT_EQ(run(catalog, "select count(*) from parts"),
+              std::to_string(rows) + "\n");
+}
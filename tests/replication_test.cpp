@@ -0,0 +1,232 @@
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <eggshell/compiler/session.hpp>
+#include <eggshell/compiler/statement.hpp>
+#include <eggshell/executor/resultsink.hpp>
+#include <eggshell/server/client.hpp>
+#include <eggshell/server/replica.hpp>
+#include <eggshell/server/server.hpp>
+#include <eggshell/storage/catalog.hpp>
+#include <eggshell/storage/wal.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "run.hpp"
+#include "tempfile.hpp"
+
+namespace {
+
+void write(Catalog& primary, uint32_t first, uint32_t last) {
+    for (uint32_t key = first; key <= last; key++) {
+        std::string values = "(" + std::to_string(key) + ", u" +
+                             std::to_string(key % 5) + ", e" +
+                             std::to_string(key) + ")";
+        ASSERT_EQ(run(primary, "insert into " +
+                                   std::string(key % 2 ? "users" : "events") +
+                                   " values " + values),
+                  "");
+    }
+}
+
+const std::vector<std::string> SELECTS{
+    "select * from users", "select * from events",
+    "select * from users where username = 'z'",
+    "select count(*) from events where id between 10 and 90",
+    "select * from main"};
+
+void same_results(Catalog& primary, Catalog& replica) {
+    for (const std::string& select : SELECTS) {
+        EXPECT_EQ(run(replica, select), run(primary, select)) << select;
+    }
+}
+
+}  // namespace
+
+TEST(ReplicationTest, ReplicaAppliesTheLog) {
+    TempCatalog primary_file{"replication_test_primary"};
+    TempCatalog replica_file{"replication_test_replica"};
+    Catalog primary{primary_file.path, Engine::btree, true};
+    ASSERT_EQ(run(primary, "create table users"), "");
+    ASSERT_EQ(run(primary, "create table events partitions 3"), "");
+    ASSERT_EQ(run(primary, "create index on users (username)"), "");
+    write(primary, 1, 200);
+    ASSERT_EQ(run(primary, "update users set username = z where id "
+                           "between 20 and 40"),
+              "");
+    ASSERT_EQ(run(primary, "insert into events values (4, a, b) on conflict "
+                           "do update"),
+              "");
+    run(primary, "insert into main values (1, m, m)");
+
+    {
+        Catalog replica{replica_file.path};
+        Replica follower{replica, Wal::filename(primary_file.path)};
+        EXPECT_GT(follower.poll(), 200u);
+        same_results(primary, replica);
+        EXPECT_NE(replica.table("users").index(Column::username), nullptr);
+        EXPECT_NE(replica.partitioned("events"), nullptr);
+
+        ReplicationStatus status = follower.status();
+        EXPECT_EQ(status.lsn, primary.wal()->lsn());
+        EXPECT_EQ(status.bytes_behind, 0u);
+        EXPECT_EQ(status.lag_ms, 0);
+        EXPECT_EQ(run(replica, "insert into users values (1000, a, b)"),
+                  "Error: Read-only replica.\n");
+
+        /* Trailing until the next poll */
+        write(primary, 201, 220);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        status = follower.status();
+        EXPECT_GT(status.bytes_behind, 0u);
+        EXPECT_GT(status.lag_ms, 0);
+        EXPECT_EQ(follower.poll(), 20u);
+        same_results(primary, replica);
+    }
+
+    /* Reopened, it resumes after the records it applied */
+    write(primary, 221, 230);
+    {
+        Catalog replica{replica_file.path};
+        Replica follower{replica, Wal::filename(primary_file.path)};
+        EXPECT_EQ(follower.status().lsn, primary.wal()->lsn() - 10);
+        EXPECT_EQ(follower.poll(), 10u);
+        same_results(primary, replica);
+    }
+
+    /* A log that was replaced is applied from its start */
+    std::filesystem::remove(Wal::filename(primary_file.path));
+    {
+        Wal log{Wal::filename(primary_file.path)};
+        Row row{};
+        row.id = 7;
+        strcpy(row.username, "new");
+        log.put("users", row);
+    }
+    Catalog replica{replica_file.path};
+    Replica follower{replica, Wal::filename(primary_file.path)};
+    EXPECT_EQ(follower.poll(), 1u);
+    EXPECT_EQ(run(replica, "select * from users where id = 7"),
+              "7,new,\n");
+}
+
+TEST(ReplicationTest, PrimaryReopensItsLog) {
+    TempCatalog file{"replication_test_reopen"};
+    uint64_t lsn;
+    {
+        Catalog primary{file.path, Engine::btree, true};
+        ASSERT_EQ(run(primary, "insert 1 a b"), "");
+        ASSERT_EQ(run(primary, "insert 2 a b"), "");
+        lsn = primary.wal()->lsn();
+        EXPECT_EQ(lsn, 2u);
+    }
+    /* The log is kept without asking again, numbered on from the end */
+    Catalog primary{file.path};
+    ASSERT_NE(primary.wal(), nullptr);
+    ASSERT_EQ(run(primary, "insert 3 a b"), "");
+    EXPECT_EQ(primary.wal()->lsn(), lsn + 1);
+}
+
+TEST(ReplicationTest, CorruptFrameLengthIsAnError) {
+    TempCatalog file{"replication_test_corrupt"};
+    std::string log = Wal::filename(file.path);
+    {
+        Wal wal{log};
+        wal.put("", Row{});
+    }
+    {
+        /* A frame claiming 4 GB, far past the end of the log */
+        std::ofstream out{log, std::ios::binary | std::ios::app};
+        uint32_t length = UINT32_MAX;
+        out.write((const char*)&length, sizeof(length));
+    }
+    WalReader reader{log};
+    WalRecord record;
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EXIT(reader.next(record), testing::ExitedWithCode(EXIT_FAILURE),
+                "");
+}
+
+TEST(ReplicationTest, ReplicaFollowsAnotherProcess) {
+    TempCatalog primary_file{"replication_test_process"};
+    TempCatalog replica_file{"replication_test_follower"};
+    /* Created up front, so the replica has a log to tail from the start */
+    { Catalog primary{primary_file.path, Engine::btree, true}; }
+
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        {
+            Catalog primary{primary_file.path};
+            run(primary, "create table users");
+            run(primary, "create table events partitions 2");
+            for (uint32_t key = 1; key <= 300; key++) {
+                run(primary, "insert into users values (" +
+                                 std::to_string(key) + ", a, b)");
+            }
+        }
+        _exit(0);
+    }
+
+    Catalog replica{replica_file.path};
+    Replica follower{replica, Wal::filename(primary_file.path)};
+    follower.start(std::chrono::milliseconds(1));
+    int status;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (follower.status().lsn < 302 &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    follower.stop();
+    EXPECT_EQ(follower.status().lsn, 302u);
+    EXPECT_EQ(run(replica, "select count(*) from users"), "300\n");
+}
+
+TEST(ReplicationTest, ServersReportReplication) {
+    TempCatalog primary_file{"replication_test_served"};
+    TempCatalog replica_file{"replication_test_served_replica"};
+    Catalog primary{primary_file.path, Engine::btree, true};
+    Catalog plain{replica_file.path};
+    write(primary, 1, 2);
+
+    for (bool replicating : {false, true}) {
+        std::unique_ptr<Replica> follower;
+        if (replicating) {
+            follower = std::make_unique<Replica>(
+                plain, Wal::filename(primary_file.path));
+            follower->poll();
+        }
+        Server server{replicating ? plain : primary, 1, follower.get()};
+        Address address;
+        parse_address("unix:" + replica_file.path + ".sock", address);
+        ASSERT_TRUE(server.listen(address));
+        std::thread loop{[&] { server.run(); }};
+
+        Client client;
+        ASSERT_TRUE(client.connect(address));
+        std::string payload;
+        Response response{};
+        ASSERT_TRUE(client.send(".replication"));
+        ASSERT_TRUE(client.receive(payload));
+        ASSERT_TRUE(parse_response(payload, response));
+        EXPECT_EQ(response.status, ResponseStatus::ok);
+        EXPECT_EQ(response.rows, 1u);
+        ASSERT_TRUE(client.send("insert into users values (9, a, b)"));
+        ASSERT_TRUE(client.receive(payload));
+        ASSERT_TRUE(parse_response(payload, response));
+        EXPECT_EQ(response.status, replicating ? ResponseStatus::error
+                                               : ResponseStatus::ok);
+
+        server.stop();
+        loop.join();
+    }
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <eggshell/compiler/statement.hpp>
+#include <eggshell/executor/resultsink.hpp>
+#include <eggshell/storage/table.hpp>
+#include <fstream>
+#include <string>
+
+#include "tempfile.hpp"
+
+namespace {
+
+/* Everything written to a tmpfile so far */
+std::string contents(FILE* file) {
+    std::string bytes;
+    rewind(file);
+    char chunk[4096];
+    size_t read;
+    while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        bytes.append(chunk, read);
+    }
+    return bytes;
+}
+
+/* One row of an integer, a string needing escapes, a null and a real */
+std::string write_row(OutputFormat format) {
+    FILE* file = tmpfile();
+    {
+        ResultSink sink{file, format};
+        sink.begin_row();
+        sink.value(uint64_t(7));
+        sink.value(std::string_view("a,\"b\"\tc\n"));
+        sink.null();
+        sink.value(2.5);
+        sink.end_row();
+    }
+    std::string bytes = contents(file);
+    fclose(file);
+    return bytes;
+}
+
+template <typename T>
+T read(const std::string& bytes, size_t& at) {
+    T value;
+    memcpy(&value, bytes.data() + at, sizeof(value));
+    at += sizeof(value);
+    return value;
+}
+
+}  // namespace
+
+TEST(ResultSinkTest, TextFormat) {
+    EXPECT_EQ(write_row(OutputFormat::text), "(7, a,\"b\"\tc\n, NULL, 2.5)\n");
+}
+
+TEST(ResultSinkTest, CsvQuotesSpecialValues) {
+    EXPECT_EQ(write_row(OutputFormat::csv), "7,\"a,\"\"b\"\"\tc\n\",,2.5\n");
+}
+
+TEST(ResultSinkTest, TsvEscapesSpecialValues) {
+    EXPECT_EQ(write_row(OutputFormat::tsv), "7\ta,\"b\"\\tc\\n\t\\N\t2.5\n");
+}
+
+TEST(ResultSinkTest, BinaryFrames) {
+    std::string bytes = write_row(OutputFormat::binary);
+    size_t at = 0;
+    ASSERT_EQ(bytes[at++], 'R');
+    uint32_t length = read<uint32_t>(bytes, at);
+    ASSERT_EQ(at + length, bytes.size());
+    EXPECT_EQ(read<uint16_t>(bytes, at), 4);
+
+    EXPECT_EQ(bytes[at++], 1);
+    EXPECT_EQ(read<int64_t>(bytes, at), 7);
+    EXPECT_EQ(bytes[at++], 3);
+    uint32_t size = read<uint32_t>(bytes, at);
+    EXPECT_EQ(bytes.substr(at, size), "a,\"b\"\tc\n");
+    at += size;
+    EXPECT_EQ(bytes[at++], 0);
+    EXPECT_EQ(bytes[at++], 2);
+    EXPECT_EQ(read<double>(bytes, at), 2.5);
+    EXPECT_EQ(at, bytes.size());
+}
+
+TEST(ResultSinkTest, RowsOutgrowingTheBuffer) {
+    /* Partial binary rows must not reach the file between flushes */
+    FILE* file = tmpfile();
+    std::string wide(ResultSink::BUFFER_SIZE / 3, 'x');
+    {
+        ResultSink sink{file, OutputFormat::binary};
+        for (uint32_t i = 0; i < 10; i++) {
+            sink.begin_row();
+            sink.value(std::string_view(wide));
+            sink.value(std::string_view(wide));
+            sink.end_row();
+        }
+    }
+    std::string bytes = contents(file);
+    fclose(file);
+
+    size_t at = 0;
+    uint32_t rows = 0;
+    while (at < bytes.size()) {
+        ASSERT_EQ(bytes[at++], 'R');
+        uint32_t length = read<uint32_t>(bytes, at);
+        size_t end = at + length;
+        EXPECT_EQ(read<uint16_t>(bytes, at), 2);
+        at = end;
+        rows++;
+    }
+    EXPECT_EQ(at, bytes.size());
+    EXPECT_EQ(rows, 10);
+}
+
+TEST(ResultSinkTest, StatementWritesThroughSink) {
+    TempFile path{"resultsink_test_statement"};
+    Table table{path.path};
+    Statement insert;
+    insert.prepare("insert ? ? ?");
+    for (uint32_t key = 1; key <= 3; key++) {
+        insert.bind(0, key);
+        insert.bind(1, "user" + std::to_string(key));
+        insert.bind(2, "u" + std::to_string(key) + "@x");
+        ASSERT_EQ(insert.execute(table), ExecuteResult::success);
+    }
+
+    FILE* file = tmpfile();
+    {
+        ResultSink sink{file, OutputFormat::csv};
+        Statement select;
+        ASSERT_EQ(select.prepare("select * where id between 2 and 3"),
+                  CmdPrepareResult::success);
+        ASSERT_EQ(select.execute(table, sink), ExecuteResult::success);
+        Statement count;
+        ASSERT_EQ(count.prepare("select count(*)"), CmdPrepareResult::success);
+        ASSERT_EQ(count.execute(table, sink), ExecuteResult::success);
+    }
+    EXPECT_EQ(contents(file), "2,user2,u2@x\n3,user3,u3@x\n3\n");
+    fclose(file);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <eggshell/compiler/session.hpp>
+#include <eggshell/compiler/statement.hpp>
+#include <eggshell/executor/resultsink.hpp>
+#include <eggshell/storage/catalog.hpp>
+#include <eggshell/storage/table.hpp>
+#include <string>
+
+/* Runs a statement on table, failing the test if it does not parse */
+inline ExecuteResult run(Table& table, const std::string& input) {
+    Statement statement;
+    EXPECT_EQ(statement.prepare(input), CmdPrepareResult::success) << input;
+    return statement.execute(table);
+}
+
+/* Rows the statement on table writes as text */
+inline std::string output(Table& table, const std::string& input) {
+    std::string text;
+    {
+        ResultSink sink{text};
+        Statement statement;
+        EXPECT_EQ(statement.prepare(input), CmdPrepareResult::success) << input;
+        statement.execute(table, sink);
+    }
+    return text;
+}
+
+/* Rows the statement writes as CSV, or its error */
+inline std::string run(Catalog& catalog, const std::string& input) {
+    Statement statement;
+    if (statement.prepare(input) != CmdPrepareResult::success) {
+        return "prepare error";
+    }
+    std::string output;
+    ExecuteResult result;
+    {
+        ResultSink sink{output, OutputFormat::csv};
+        result = statement.execute(catalog, sink);
+    }
+    return result == ExecuteResult::success ? output
+                                            : execute_message(result);
+}
+
+/* Row stored under key, which the table holds */
+inline Row get(Table& table, uint32_t key) {
+    Row row;
+    Cursor cursor = table.find(key);
+    row.deserialize(cursor.value());
+    return row;
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <eggshell/compiler/script.hpp>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> statements(const std::string& script) {
+    FILE* file = tmpfile();
+    fwrite(script.data(), 1, script.size(), file);
+    rewind(file);
+    ScriptReader reader{file};
+    std::vector<std::string> statements;
+    std::string statement;
+    while (reader.next(statement)) {
+        statements.push_back(statement);
+    }
+    fclose(file);
+    return statements;
+}
+
+}  // namespace
+
+TEST(ScriptTest, SplitsOnSemicolons) {
+    EXPECT_EQ(statements("insert 1 a a@x; insert 2\n  b b@x;\n\n;select"),
+              (std::vector<std::string>{"insert 1 a a@x", "insert 2\n  b b@x",
+                                        "select"}));
+}
+
+TEST(ScriptTest, QuotedSemicolonsAndMetaCommands) {
+    EXPECT_EQ(statements(".format csv\ninsert 1 'a;b' x;\n.tables\nselect;"),
+              (std::vector<std::string>{".format csv", "insert 1 'a;b' x",
+                                        ".tables", "select"}));
+}
+
+TEST(ScriptTest, StatementsAcrossChunks) {
+    /* Several chunks, with one statement longer than a chunk */
+    std::string script;
+    uint32_t count = 0;
+    while (script.size() < 3 * ScriptReader::CHUNK_SIZE) {
+        script += "insert " + std::to_string(++count) + " user u@x;\n";
+    }
+    std::string wide = "select '" +
+                       std::string(ScriptReader::CHUNK_SIZE + 7, ';') + "'";
+    script += wide + ";insert 0 a b";
+
+    std::vector<std::string> read = statements(script);
+    ASSERT_EQ(read.size(), count + 2);
+    for (uint32_t i = 0; i < count; i++) {
+        ASSERT_EQ(read[i], "insert " + std::to_string(i + 1) + " user u@x");
+    }
+    EXPECT_EQ(read[count], wide);
+    EXPECT_EQ(read[count + 1], "insert 0 a b");
+}
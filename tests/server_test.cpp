@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <eggshell/server/client.hpp>
+#include <eggshell/server/server.hpp>
+#include <eggshell/storage/catalog.hpp>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tempfile.hpp"
+
+namespace {
+
+struct TempServer {
+    TempCatalog files;
+    std::string socket;
+    Address address;
+    std::unique_ptr<Catalog> catalog;
+    std::unique_ptr<Server> server;
+    std::thread loop;
+
+    TempServer(std::string name)
+        : files{"server_test_" + name},
+          socket{"server_test_" + name + ".sock"} {
+        catalog = std::make_unique<Catalog>(files.path);
+        server = std::make_unique<Server>(*catalog, 4);
+        parse_address("unix:" + socket, address);
+        EXPECT_TRUE(server->listen(address));
+        loop = std::thread{[this] { server->run(); }};
+    }
+
+    ~TempServer() {
+        server->stop();
+        loop.join();
+        server.reset();
+        catalog.reset();
+        std::remove(socket.c_str());
+    }
+};
+
+Response request(Client& client, const std::string& statement) {
+    std::string payload;
+    Response response{};
+    EXPECT_TRUE(client.send(statement));
+    EXPECT_TRUE(client.receive(payload));
+    EXPECT_TRUE(parse_response(payload, response));
+    return response;
+}
+
+}  // namespace
+
+TEST(ServerTest, PipelinedResponsesKeepRequestOrder) {
+    TempServer server{"pipeline"};
+    Client client;
+    ASSERT_TRUE(client.connect(server.address));
+
+    /* All requests go out before any response is read */
+    for (uint32_t key = 1; key <= 500; key++) {
+        ASSERT_TRUE(client.send("insert " + std::to_string(key) + " u e"));
+        ASSERT_TRUE(client.send("select id where id between 1 and " +
+                                std::to_string(key)));
+    }
+    ASSERT_TRUE(client.send("insert 1 u e"));
+    std::string payload;
+    Response response;
+    for (uint32_t key = 1; key <= 500; key++) {
+        ASSERT_TRUE(client.receive(payload));
+        ASSERT_TRUE(parse_response(payload, response));
+        EXPECT_EQ(response.status, ResponseStatus::ok);
+        EXPECT_EQ(response.message, "Executed.\n");
+        ASSERT_TRUE(client.receive(payload));
+        ASSERT_TRUE(parse_response(payload, response));
+        EXPECT_EQ(response.rows, key);
+    }
+    ASSERT_TRUE(client.receive(payload));
+    ASSERT_TRUE(parse_response(payload, response));
+    EXPECT_EQ(response.status, ResponseStatus::error);
+    EXPECT_EQ(response.message, "Error: Duplicate key.\n");
+}
+
+TEST(ServerTest, ClientsShareTables) {
+    TempServer server{"clients"};
+    const uint32_t clients = 8;
+    const uint32_t keys = 200;
+    std::vector<std::thread> threads;
+    for (uint32_t c = 0; c < clients; c++) {
+        threads.emplace_back([&server, c] {
+            Client client;
+            ASSERT_TRUE(client.connect(server.address));
+            for (uint32_t i = 0; i < keys; i++) {
+                std::string key = std::to_string(c * keys + i + 1);
+                EXPECT_EQ(request(client, "insert " + key + " u e").status,
+                          ResponseStatus::ok);
+                EXPECT_EQ(request(client, "select * where id = " + key).rows,
+                          1);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    Client client;
+    ASSERT_TRUE(client.connect(server.address));
+    EXPECT_EQ(request(client, "select id").rows, clients * keys);
+    EXPECT_EQ(request(client, "bogus").status, ResponseStatus::error);
+    EXPECT_EQ(request(client, ".exit").status, ResponseStatus::error);
+    EXPECT_EQ(server.server->connections_accepted(), clients + 1);
+}
@@ -0,0 +1,253 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdio>
+#include <eggshell/compiler/session.hpp>
+#include <eggshell/executor/resultsink.hpp>
+#include <eggshell/storage/table.hpp>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "run.hpp"
+#include "tempfile.hpp"
+
+TEST(SessionTest, PreparedHandleIsBoundAndRunRepeatedly) {
+    TempFile file{"session_test_handle"};
+    Table table{file.path};
+
+    Statement insert;
+    ASSERT_EQ(insert.prepare("insert into users values (?, ?, ?)"),
+              CmdPrepareResult::success);
+    ASSERT_EQ(insert.num_parameters(), 3);
+    EXPECT_EQ(insert.execute(table), ExecuteResult::unbound_parameter);
+
+    for (uint32_t key = 1; key <= 100; key++) {
+        std::string name = "user" + std::to_string(key);
+        ASSERT_EQ(insert.bind(0, key), CmdPrepareResult::success);
+        ASSERT_EQ(insert.bind(1, name), CmdPrepareResult::success);
+        ASSERT_EQ(insert.bind(2, "same@x"), CmdPrepareResult::success);
+        ASSERT_EQ(insert.execute(table), ExecuteResult::success);
+    }
+    EXPECT_EQ(insert.execute(table), ExecuteResult::duplicate_key);
+    EXPECT_EQ(insert.bind(1, std::string(Row::COLUMN_USERNAME_SIZE + 1, 'a')),
+              CmdPrepareResult::string_too_long);
+    EXPECT_EQ(insert.execute(table), ExecuteResult::unbound_parameter);
+    EXPECT_EQ(insert.bind(3, "x"), CmdPrepareResult::syntax_error);
+
+    Statement update;
+    ASSERT_EQ(update.prepare("update set email = ? where id between ? and ?"),
+              CmdPrepareResult::success);
+    update.bind(0, "moved@x");
+    update.bind(1, 10);
+    update.bind(2, "20");
+    ASSERT_EQ(update.execute(table), ExecuteResult::success);
+
+    EXPECT_STREQ(get(table, 57).username, "user57");
+    EXPECT_STREQ(get(table, 15).email, "moved@x");
+    EXPECT_STREQ(get(table, 21).email, "same@x");
+}
+
+TEST(SessionTest, PrepareExecuteAndDeallocate) {
+    TempFile file{"session_test_named"};
+    Table table{file.path};
+    Session session;
+    Statement statement;
+
+    ASSERT_EQ(session.prepare("PREPARE add AS insert ? ? ?", statement),
+              CmdPrepareResult::success);
+    EXPECT_EQ(statement.type, StatementType::noop);
+    ASSERT_EQ(session.prepare("execute add (3, 'c d', c@x)", statement),
+              CmdPrepareResult::success);
+    ASSERT_EQ(statement.execute(table), ExecuteResult::success);
+    EXPECT_STREQ(get(table, 3).username, "c d");
+
+    EXPECT_EQ(session.prepare("execute add (4, d)", statement),
+              CmdPrepareResult::syntax_error);
+    EXPECT_EQ(session.prepare("execute add (4, d, d, d)", statement),
+              CmdPrepareResult::syntax_error);
+    EXPECT_EQ(session.prepare("execute add (-4, d, d)", statement),
+              CmdPrepareResult::id_out_of_range);
+    EXPECT_EQ(session.prepare("execute missing", statement),
+              CmdPrepareResult::unknown_prepared);
+
+    ASSERT_EQ(session.prepare("deallocate add", statement),
+              CmdPrepareResult::success);
+    EXPECT_EQ(session.prepare("execute add (5, e, e)", statement),
+              CmdPrepareResult::unknown_prepared);
+}
+
+TEST(SessionTest, PlanCacheIgnoresSpacingAndEvictsOldest) {
+    Session session;
+    Statement statement;
+    ASSERT_EQ(session.prepare("select * where id = 1", statement),
+              CmdPrepareResult::success);
+    ASSERT_EQ(session.prepare("select  *\twhere id=1;", statement),
+              CmdPrepareResult::success);
+    ASSERT_EQ(session.prepare("SELECT * WHERE ID = 2", statement),
+              CmdPrepareResult::success);
+    EXPECT_EQ(session.cache.hits, 2);
+    EXPECT_EQ(session.cache.misses, 1);
+    EXPECT_EQ(statement.key_min, 2);
+    EXPECT_EQ(statement.num_parameters(), 0);
+
+    /* Quoting is part of the key, 'a b' is not the two words a b */
+    std::string key;
+    std::vector<std::string_view> literals;
+    PlanCache::normalize("INSERT 1 'a b' c", key, literals);
+    EXPECT_EQ(key, "insert ? ? c");
+    EXPECT_EQ(literals, (std::vector<std::string_view>{"1", "a b"}));
+    PlanCache::normalize("insert 1 a b c", key, literals);
+    EXPECT_EQ(key, "insert ? a b c");
+
+    /* Input with placeholders of its own keeps its literals */
+    PlanCache::normalize("Select where id between ? and 'x'", key, literals);
+    EXPECT_EQ(key, "select where id between ? and 'x'");
+    EXPECT_TRUE(literals.empty());
+    PlanCache::normalize("select where id = 5 LIMIT ?", key, literals);
+    EXPECT_EQ(key, "select where id = 5 limit ?");
+    EXPECT_TRUE(literals.empty());
+
+    PlanCache cache{2};
+    cache.insert("a", statement);
+    cache.insert("b", statement);
+    cache.find("a");
+    cache.insert("c", statement);
+    EXPECT_NE(cache.find("a"), nullptr);
+    EXPECT_EQ(cache.find("b"), nullptr);
+    EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(SessionTest, PlanCacheKeepsTheCaseOfNamesAndValues) {
+    TempFile file{"session_test_cache_case"};
+    Table table{file.path};
+    Session session;
+    auto run = [&](const std::string& input) {
+        Statement statement;
+        EXPECT_EQ(session.prepare(input, statement),
+                  CmdPrepareResult::success)
+            << input;
+        return statement.execute(table);
+    };
+
+    /* Bare values spelled like keywords are not keyed in lowercase */
+    ASSERT_EQ(run("insert 1 select a@x"), ExecuteResult::success);
+    ASSERT_EQ(run("insert 2 Select a@x"), ExecuteResult::success);
+    EXPECT_STREQ(get(table, 1).username, "select");
+    EXPECT_STREQ(get(table, 2).username, "Select");
+    ASSERT_EQ(run("insert 3 Bob a@x"), ExecuteResult::success);
+    ASSERT_EQ(run("insert 4 bob a@x"), ExecuteResult::success);
+    EXPECT_STREQ(get(table, 3).username, "Bob");
+    EXPECT_STREQ(get(table, 4).username, "bob");
+
+    /* Values bound into a shared plan are checked like written ones */
+    Statement statement;
+    EXPECT_EQ(session.prepare("select where id = 4", statement),
+              CmdPrepareResult::success);
+    EXPECT_EQ(session.prepare("select where id = 99999999999", statement),
+              CmdPrepareResult::id_out_of_range);
+    EXPECT_EQ(session.prepare(
+                  "insert 5 '" +
+                      std::string(Row::COLUMN_USERNAME_SIZE + 1, 'a') +
+                      "' a@x",
+                  statement),
+              CmdPrepareResult::string_too_long);
+
+    /* A prepared body with literals takes no arguments, cached or not */
+    for (uint32_t round = 0; round < 2; round++) {
+        ASSERT_EQ(session.prepare("prepare one as select where id = 1",
+                                  statement),
+                  CmdPrepareResult::success);
+        ASSERT_EQ(session.prepare("execute one", statement),
+                  CmdPrepareResult::success);
+        EXPECT_EQ(statement.key_min, 1);
+    }
+}
+
+TEST(SessionTest, ArenaKeepsBlocksAcrossResets) {
+    Arena arena;
+    for (uint32_t round = 0; round < 3; round++) {
+        arena.allocate(100, 8);
+        arena.allocate(Arena::BLOCK_SIZE * 4, 16);
+        arena.allocate(Arena::BLOCK_SIZE, 8);
+        /* Only the first round goes to the heap */
+        EXPECT_EQ(arena.heap_blocks(), 2u);
+        EXPECT_GE(arena.used(), Arena::BLOCK_SIZE * 5 + 100);
+        arena.reset();
+        EXPECT_EQ(arena.used(), 0u);
+    }
+}
+
+TEST(SessionTest, RepeatedStatementsDoNotAllocate) {
+    TempFile file{"session_test_stats"};
+    Table table{file.path};
+    FILE* null = fopen("/dev/null", "w");
+    ResultSink sink{null};
+    Session session;
+    auto run = [&](const std::string& input) {
+        StatementScope scope{session.arena, session.stats};
+        Statement statement;
+        ASSERT_EQ(session.prepare(input, statement),
+                  CmdPrepareResult::success);
+        ASSERT_EQ(statement.execute(table, sink), ExecuteResult::success);
+    };
+    for (uint32_t key = 1; key <= 500; key++) {
+        run("insert " + std::to_string(key) + " u" + std::to_string(key) +
+            " e@x");
+    }
+
+    for (std::string input :
+         {"select", "select where id = 7", "select where id between 400 and 450",
+          "select * where username = 'u42'"}) {
+        run(input);
+        run(input);
+        EXPECT_EQ(session.stats.heap_objects, 0u) << input;
+        EXPECT_EQ(session.stats.arena_blocks, 0u) << input;
+    }
+    /* Scans take their plan and batches from the arena */
+    run("select");
+    EXPECT_GT(session.stats.arena_bytes, sizeof(Batch));
+    EXPECT_EQ(Arena::current(), nullptr);
+
+    /* Sorts keep their records there too, once the arena has grown */
+    run("select * order by username");
+    run("select * order by username");
+    EXPECT_EQ(session.stats.heap_objects, 0u);
+    EXPECT_EQ(session.stats.arena_blocks, 0u);
+    EXPECT_GT(session.stats.arena_bytes, 500 * Batch::stride(Column::username));
+
+    /* Workers of a parallel scan have no arena, their batches miss it */
+    table.parallelism = 4;
+    run("select * where username = 'u42'");
+    EXPECT_GT(session.stats.heap_objects, 0u);
+
+    /* Counts are per statement, another session's workers do not add up */
+    TempFile other_file{"session_test_stats_other"};
+    Table other_table{other_file.path};
+    for (uint32_t key = 1; key <= 500; key++) {
+        ::run(other_table, "insert " + std::to_string(key) + " u e@x");
+    }
+    other_table.parallelism = 4;
+    std::atomic<bool> done = false;
+    Session other;
+    std::thread parallel{[&] {
+        ResultSink other_sink{null};
+        do {
+            StatementScope scope{other.arena, other.stats};
+            Statement statement;
+            other.prepare("select * where username = 'v'", statement);
+            statement.execute(other_table, other_sink);
+        } while (!done);
+    }};
+    table.parallelism = 1;
+    for (uint32_t i = 0; i < 20; i++) {
+        run("select * where username = 'u42'");
+        EXPECT_EQ(session.stats.heap_objects, 0u);
+    }
+    done = true;
+    parallel.join();
+    EXPECT_GT(other.stats.heap_objects, 0u);
+    sink.flush();
+    fclose(null);
+}
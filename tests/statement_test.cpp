@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <eggshell/compiler/statement.hpp>
+#include <eggshell/storage/bplus/leafnode.hpp>
+#include <eggshell/storage/table.hpp>
+#include <fstream>
+
+#include "run.hpp"
+#include "tempfile.hpp"
+
+TEST(StatementTest, UpsertOverwritesExistingRow) {
+    TempFile file{"statement_test_upsert"};
+    Table table{file.path};
+    EXPECT_EQ(run(table, "insert 1 alice a@x"), ExecuteResult::success);
+    EXPECT_EQ(run(table, "insert 1 bob b@x"), ExecuteResult::duplicate_key);
+    EXPECT_EQ(run(table, "insert 1 bob b@x on conflict do update"),
+              ExecuteResult::success);
+    EXPECT_EQ(run(table, "insert 2 carol c@x on conflict do update"),
+              ExecuteResult::success);
+
+    EXPECT_STREQ(get(table, 1).username, "bob");
+    EXPECT_STREQ(get(table, 2).email, "c@x");
+}
+
+TEST(StatementTest, UpdateKeyRangeInPlace) {
+    TempFile file{"statement_test_update"};
+    Table table{file.path};
+    for (uint32_t key = 1; key <= 100; key++) {
+        run(table, "insert " + std::to_string(key) + " user old@x");
+    }
+    EXPECT_EQ(run(table, "update set email = new@x where id between 20 and 60"),
+              ExecuteResult::success);
+    EXPECT_EQ(run(table, "update set username = root where id = 1"),
+              ExecuteResult::success);
+
+    for (uint32_t key = 1; key <= 100; key++) {
+        Row row = get(table, key);
+        EXPECT_EQ(row.id, key);
+        bool in_range = key >= 20 && key <= 60;
+        EXPECT_STREQ(row.email, in_range ? "new@x" : "old@x") << key;
+    }
+    EXPECT_STREQ(get(table, 1).username, "root");
+}
+
+TEST(StatementTest, UpdateRejectsUnknownColumn) {
+    Statement statement;
+    EXPECT_EQ(statement.prepare("update set id = 3 where id = 1"),
+              CmdPrepareResult::syntax_error);
+    EXPECT_EQ(statement.prepare("update set email = x"),
+              CmdPrepareResult::syntax_error);
+}
+
+TEST(StatementTest, IndexTracksInsertsAndUpdates) {
+    TempFile file{"statement_test_index"};
+    {
+        Table table{file.path};
+        run(table, "create index on email");
+        for (uint32_t key = 250; key >= 1; key--) {
+            std::string n = std::to_string(key % 13);
+            run(table, "insert " + std::to_string(key) + " u" + n + " m" +
+                           n + "@x");
+        }
+        run(table, "update set email = moved@x where id between 100 and 120");
+        run(table, "insert 5 u5 moved@x on conflict do update");
+    }
+
+    Table table{file.path};
+    Index* index = table.index(Column::email);
+    ASSERT_NE(index, nullptr);
+    for (uint32_t n = 0; n < 13; n++) {
+        std::vector<uint32_t> keys;
+        index->find("m" + std::to_string(n) + "@x", false, keys);
+        std::vector<uint32_t> expected;
+        for (uint32_t key = 1; key <= 250; key++) {
+            if (key % 13 == n && (key < 100 || key > 120) && key != 5) {
+                expected.push_back(key);
+            }
+        }
+        EXPECT_EQ(keys, expected) << n;
+    }
+
+    std::vector<uint32_t> moved;
+    index->find("mov", true, moved);
+    EXPECT_EQ(moved.size(), 22);
+}
+
+TEST(StatementTest, HashIndexPointsAtLeafOfEveryKey) {
+    TempFile file{"statement_test_hash"};
+    {
+        Table table{file.path};
+        for (uint32_t key = 1; key <= 500; key += 2) {
+            run(table, "insert " + std::to_string(key) + " u" +
+                           std::to_string(key % 10) + " e");
+        }
+        run(table, "create index on id using hash");
+        run(table, "create index on username using hash");
+        for (uint32_t key = 2; key <= 500; key += 2) {
+            run(table, "insert " + std::to_string(key) + " u" +
+                           std::to_string(key % 10) + " e");
+        }
+        run(table, "update set username = moved where id between 1 and 50");
+    }
+
+    Table table{file.path};
+    HashIndex* hash = table.hash_index(Column::id);
+    ASSERT_NE(hash, nullptr);
+    for (uint32_t key = 1; key <= 500; key++) {
+        std::vector<uint32_t> page_nums;
+        hash->find((const char*)&key, page_nums);
+        ASSERT_EQ(page_nums.size(), 1) << key;
+        Cursor cursor = LeafNode::find(table, page_nums[0], key);
+        EXPECT_EQ(cursor.key(), key);
+    }
+
+    char key[Row::EMAIL_SIZE];
+    std::vector<uint32_t> moved, u7;
+    HashIndex* username = table.hash_index(Column::username);
+    username->make_key("moved", key);
+    username->find(key, moved);
+    username->make_key("u7", key);
+    username->find(key, u7);
+    EXPECT_EQ(moved.size(), 50);
+    EXPECT_EQ(u7.size(), 45);
+}
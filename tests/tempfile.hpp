@@ -0,0 +1,75 @@
+#pragma once
+
+#include <eggshell/storage/hash/hashindex.hpp>
+#include <eggshell/storage/index.hpp>
+#include <eggshell/storage/lsm/lsmtree.hpp>
+#include <eggshell/storage/pagemap.hpp>
+#include <eggshell/storage/table.hpp>
+#include <eggshell/storage/warmset.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/*
+ * An empty table file, <name>.db, for one test. It is removed with the files
+ * a table keeps next to it: indexes, hash indexes, the LSM directory, the
+ * page map, the warm set and a vacuum's new file.
+ */
+struct TempFile {
+    std::string path;
+
+    TempFile(std::string name) : path{name + ".db"} {
+        remove();
+        std::ofstream{path};
+    }
+
+    ~TempFile() {
+        remove();
+    }
+
+    void remove() {
+        std::string vacuum = Table::vacuum_filename(path);
+        std::vector<std::string> files{path, PageMap::filename(path),
+                                       WarmSet::filename(path), vacuum,
+                                       PageMap::filename(vacuum)};
+        for (Column column : {Column::id, Column::username, Column::email}) {
+            files.push_back(Index::filename(path, column));
+            files.push_back(HashIndex::filename(path, column));
+        }
+        for (const std::string& file : files) {
+            std::filesystem::remove(file);
+        }
+        std::filesystem::remove_all(LsmTree::dirname(path));
+    }
+};
+
+/*
+ * A database of several tables, <name>.db, for one test. It is removed with
+ * every file named after it: the catalog, the other tables and their shards
+ * and indexes, the write-ahead log and a replica's checkpoint.
+ */
+struct TempCatalog {
+    std::string path;
+
+    TempCatalog(std::string name) : path{name + ".db"} {
+        remove();
+        std::ofstream{path};
+    }
+
+    ~TempCatalog() {
+        remove();
+    }
+
+    void remove() {
+        std::vector<std::filesystem::path> files;
+        for (const auto& entry : std::filesystem::directory_iterator{"."}) {
+            if (entry.path().filename().string().starts_with(path)) {
+                files.push_back(entry.path());
+            }
+        }
+        for (const std::filesystem::path& file : files) {
+            std::filesystem::remove_all(file);
+        }
+    }
+};